@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_BENCHMARK_H_
+#define _SINRICPRO_BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// credentials used by traffic/generate.py to sign the recorded requests
+#define BENCHMARK_APP_KEY    "de0baaaa-1a3a-4a3a-aaaa-5dabaaaaaaaa"
+#define BENCHMARK_APP_SECRET "5f36aaaa-b3b7-4c3c-aeae-e86724a9aaaa-4c4abbbb-3b3b-b5be-b9b3-333d65bbbbbb"
+
+#ifndef BENCHMARK_TRAFFIC_DIR
+#define BENCHMARK_TRAFFIC_DIR "traffic"
+#endif
+
+/**
+ * @brief Minimal timing harness shared by all host benchmarks
+ *
+ * Every result is printed as one line: `<name> <iterations> <ns/op> <ops/s>` followed by
+ * optional extra columns, so runs of two library versions can be diffed.
+ **/
+class Benchmark {
+  public:
+    typedef std::chrono::steady_clock clock;
+
+    explicit Benchmark(const char* name) : _name(name) {}
+
+    template <typename Fn>
+    double run(uint64_t iterations, Fn fn) {
+      for (uint64_t i = 0; i < iterations / 10 + 1; i++) fn();  // warm up
+      clock::time_point start = clock::now();
+      for (uint64_t i = 0; i < iterations; i++) fn();
+      clock::time_point stop = clock::now();
+      _iterations = iterations;
+      _nsPerOp = std::chrono::duration<double, std::nano>(stop - start).count() / (double) iterations;
+      return _nsPerOp;
+    }
+
+    // result of a measurement taken outside of run(), e.g. one call processing `iterations` items
+    void record(uint64_t iterations, clock::duration elapsed) {
+      _iterations = iterations;
+      _nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / (double) iterations;
+    }
+
+    void report(const char* extra = "") const {
+      printf("%-40s %10llu %12.1f ns/op %12.0f ops/s %s\n", _name, (unsigned long long) _iterations, _nsPerOp, 1e9 / _nsPerOp, extra);
+    }
+
+  private:
+    const char* _name;
+    uint64_t _iterations = 0;
+    double _nsPerOp = 0;
+};
+
+/**
+ * @brief Load a traffic capture, one raw frame per line
+ **/
+inline std::vector<std::string> loadTraffic(const std::string& fileName) {
+  std::vector<std::string> frames;
+  std::ifstream file(std::string(BENCHMARK_TRAFFIC_DIR) + "/" + fileName);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty()) frames.push_back(line);
+  }
+  if (frames.empty()) fprintf(stderr, "Unable to load traffic from \"%s/%s\"\n", BENCHMARK_TRAFFIC_DIR, fileName.c_str());
+  return frames;
+}
+
+#endif
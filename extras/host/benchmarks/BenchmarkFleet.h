@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_BENCHMARK_FLEET_H_
+#define _SINRICPRO_BENCHMARK_FLEET_H_
+
+#include <SinricPro.h>
+#include <SinricProSwitch.h>
+#include <SinricProDimSwitch.h>
+#include <SinricProLight.h>
+#include <SinricProThermostat.h>
+#include <SinricProTV.h>
+#include <SinricProSpeaker.h>
+#include <SinricProBlinds.h>
+
+#include "Benchmark.h"
+
+// device ids used by traffic/requests.txt
+#define FLEET_SWITCH_ID     "5dc1564130aaaaaaaaaaaa01"
+#define FLEET_DIMSWITCH_ID  "5dc1564130aaaaaaaaaaaa02"
+#define FLEET_LIGHT_ID      "5dc1564130aaaaaaaaaaaa03"
+#define FLEET_THERMOSTAT_ID "5dc1564130aaaaaaaaaaaa04"
+#define FLEET_TV_ID         "5dc1564130aaaaaaaaaaaa05"
+#define FLEET_SPEAKER_ID    "5dc1564130aaaaaaaaaaaa06"
+#define FLEET_BLINDS_ID     "5dc1564130aaaaaaaaaaaa07"
+
+/**
+ * @brief Devices matching the recorded traffic, every callback accepts the request
+ **/
+struct BenchmarkFleet {
+  SinricProSwitch*     mySwitch;
+  SinricProDimSwitch*  myDimSwitch;
+  SinricProLight*      myLight;
+  SinricProThermostat* myThermostat;
+  SinricProTV*         myTV;
+  SinricProSpeaker*    mySpeaker;
+  SinricProBlinds*     myBlinds;
+
+  void setup() {
+    mySwitch = &(SinricProSwitch&) SinricPro[FLEET_SWITCH_ID];
+    mySwitch->onPowerState([](const String&, bool&) { return true; });
+
+    myDimSwitch = &(SinricProDimSwitch&) SinricPro[FLEET_DIMSWITCH_ID];
+    myDimSwitch->onPowerState([](const String&, bool&) { return true; });
+    myDimSwitch->onPowerLevel([](const String&, int&) { return true; });
+    myDimSwitch->onAdjustPowerLevel([](const String&, int&) { return true; });
+
+    myLight = &(SinricProLight&) SinricPro[FLEET_LIGHT_ID];
+    myLight->onPowerState([](const String&, bool&) { return true; });
+    myLight->onBrightness([](const String&, int&) { return true; });
+    myLight->onColor([](const String&, byte&, byte&, byte&) { return true; });
+    myLight->onColorTemperature([](const String&, int&) { return true; });
+
+    myThermostat = &(SinricProThermostat&) SinricPro[FLEET_THERMOSTAT_ID];
+    myThermostat->onPowerState([](const String&, bool&) { return true; });
+    myThermostat->onTargetTemperature([](const String&, float&) { return true; });
+    myThermostat->onThermostatMode([](const String&, String&) { return true; });
+
+    myTV = &(SinricProTV&) SinricPro[FLEET_TV_ID];
+    myTV->onPowerState([](const String&, bool&) { return true; });
+    myTV->onSetVolume([](const String&, int&) { return true; });
+    myTV->onSelectInput([](const String&, String&) { return true; });
+    myTV->onChangeChannel([](const String&, String&) { return true; });
+    myTV->onMediaControl([](const String&, String&) { return true; });
+
+    mySpeaker = &(SinricProSpeaker&) SinricPro[FLEET_SPEAKER_ID];
+    mySpeaker->onMute([](const String&, bool&) { return true; });
+    mySpeaker->onSetBands([](const String&, const String&, int&) { return true; });
+    mySpeaker->onSetMode([](const String&, String&) { return true; });
+
+    myBlinds = &(SinricProBlinds&) SinricPro[FLEET_BLINDS_ID];
+    myBlinds->onPowerState([](const String&, bool&) { return true; });
+    myBlinds->onRangeValue([](const String&, int&) { return true; });
+    myBlinds->onAdjustRangeValue([](const String&, int&) { return true; });
+  }
+
+  /**
+   * @brief Start SinricPro, connect the host websocket and feed the timestamp message
+   * @return the host websocket client used to inject frames, `nullptr` on failure
+   **/
+  WebSocketsClient* connect(const std::vector<std::string>& traffic) {
+    SinricPro.begin(BENCHMARK_APP_KEY, BENCHMARK_APP_SECRET);
+    SinricPro.handle();
+    WebSocketsClient* webSocket = WebSocketsClient::hostInstance();
+    if (!webSocket || !SinricPro.isConnected()) return nullptr;
+    for (auto& frame : traffic) {
+      if (frame.compare(0, 13, "{\"timestamp\":") == 0) webSocket->hostReceive(frame.c_str(), frame.length());
+    }
+    SinricPro.handle();
+    return webSocket;
+  }
+};
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Bursts of sensor events with and without event coalescing: checks on the virtual clock
+// that only the latest value is sent once the rate limiter allows it, then measures the
+// cost of an event which is kept as pending versus one which is dropped. A pending event must
+// keep a cause passed in a temporary buffer.
+
+#include <SinricProTemperaturesensor.h>
+
+#include "BenchmarkFleet.h"
+#include "HostHeap.h"
+
+#define COALESCING_SENSOR_ID "5dc1564130aaaaaaaaaaaa08"
+#define PLAIN_SENSOR_ID      "5dc1564130aaaaaaaaaaaa09"
+
+static void reportHeap(Benchmark& benchmark, uint64_t calls) {
+  HostHeap::Stats stats = HostHeap::stats();
+  char extra[96];
+  snprintf(extra, sizeof(extra), "%6.1f allocs/op %8.1f bytes/op", (double) stats.allocations / calls, (double) stats.bytes / calls);
+  benchmark.report(extra);
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  if (traffic.empty()) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  SinricProTemperaturesensor& coalescingSensor = SinricPro[COALESCING_SENSOR_ID];
+  SinricProTemperaturesensor& plainSensor = SinricPro[PLAIN_SENSOR_ID];
+  coalescingSensor.setEventCoalescing("currentTemperature");
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+
+  std::vector<float> sent;
+  webSocket->hostOnSend([&](const char* payload, size_t) {
+    DynamicJsonDocument event(1024);
+    deserializeJson(event, payload);
+    if (strcmp(event["payload"]["action"] | "", "currentTemperature") == 0) sent.push_back(event["payload"]["value"]["temperature"] | 0.0f);
+  });
+
+  // a burst: the first value is sent, the last one follows when the rate limiter allows it, the others are replaced
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  for (int i = 0; i < 50; i++) {
+    if (!coalescingSensor.sendTemperatureEvent(20.0f + i / 10.0f)) {
+      fprintf(stderr, "Coalesced event %d was rejected\n", i);
+      return 1;
+    }
+  }
+  SinricPro.handle();
+  if (sent.size() != 1 || sent[0] != 20.0f) {
+    fprintf(stderr, "Expected only the first value to be sent right away, got %zu events\n", sent.size());
+    return 1;
+  }
+  HostClock::advanceMillis(DROP_IN_TIME + BUCKET_SIZE);
+  SinricPro.handle();
+  SinricPro.handle();
+  if (sent.size() != 2 || sent[1] != 24.9f) {
+    fprintf(stderr, "Expected the latest value 24.9 to be sent once, got %zu events (last %.1f)\n", sent.size(), sent.back());
+    return 1;
+  }
+
+  // without coalescing the burst is dropped after the first event
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  sent.clear();
+  int accepted = 0;
+  for (int i = 0; i < 50; i++) accepted += plainSensor.sendTemperatureEvent(20.0f + i / 10.0f);
+  HostClock::advanceMillis(DROP_IN_TIME + BUCKET_SIZE);
+  SinricPro.handle();
+  if (accepted != 1 || sent.size() != 1 || sent[0] != 20.0f) {
+    fprintf(stderr, "Expected the burst to be dropped after the first event, %d accepted, %zu sent\n", accepted, sent.size());
+    return 1;
+  }
+
+  // a pending event keeps its cause after the caller's buffer is gone
+  std::string cause;
+  webSocket->hostOnSend([&](const char* payload, size_t) {
+    DynamicJsonDocument event(1024);
+    deserializeJson(event, payload);
+    if ((event["payload"]["value"]["temperature"] | 0.0f) == 21.0f) cause = event["payload"]["cause"]["type"] | "";
+  });
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  coalescingSensor.sendTemperatureEvent(20.0f);
+  {
+    char buffer[32];
+    strcpy(buffer, "ALERT_CAUSE");
+    coalescingSensor.sendTemperatureEvent(21.0f, -1, buffer);
+    strcpy(buffer, "OVERWRITTEN");
+  }
+  HostClock::advanceMillis(DROP_IN_TIME);
+  SinricPro.handle();
+  if (cause != "ALERT_CAUSE") {
+    fprintf(stderr, "Pending event was sent with cause \"%s\"\n", cause.c_str());
+    return 1;
+  }
+
+  webSocket->hostOnSend([](const char*, size_t) {});
+  const uint64_t iterations = 100000;
+  float temperature = 20.0f;
+
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  coalescingSensor.sendTemperatureEvent(temperature);
+  Benchmark pending("sendTemperatureEvent: coalesced");
+  HostHeap::reset();
+  pending.run(iterations, [&]() { coalescingSensor.sendTemperatureEvent(temperature += 0.1f); });
+  reportHeap(pending, iterations + iterations / 10 + 1);
+
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  plainSensor.sendTemperatureEvent(temperature);
+  Benchmark dropped("sendTemperatureEvent: dropped");
+  HostHeap::reset();
+  dropped.run(iterations, [&]() { plainSensor.sendTemperatureEvent(temperature += 0.1f); });
+  reportHeap(dropped, iterations + iterations / 10 + 1);
+  return 0;
+}
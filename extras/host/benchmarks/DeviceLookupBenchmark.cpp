@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// request -> response time while the number of devices grows. Requests address the
+// device added first and the device added last, the two ends of a linear search.
+
+#include <SinricPro.h>
+#include <SinricProSwitch.h>
+
+#include "Benchmark.h"
+
+static String deviceIdFor(size_t index) {
+  char deviceId[DEVICEID_STRLEN+1];
+  snprintf(deviceId, sizeof(deviceId), "5dc1564130aaaaaaaa%06x", (unsigned) index + 1);
+  return String(deviceId);
+}
+
+static std::string signedRequest(const String& deviceId) {
+  DynamicJsonDocument request(1024);
+  JsonObject header = request.createNestedObject("header");
+  header["payloadVersion"] = 2;
+  header["signatureVersion"] = 1;
+  JsonObject payload = request.createNestedObject("payload");
+  payload["action"] = "setPowerState";
+  payload["clientId"] = "alexa-skill";
+  payload["createdAt"] = 1600000000;
+  payload["deviceId"] = deviceId;
+  payload["message"] = "OK";
+  payload["replyToken"] = "6f4c8d2a-1111-4222-8333-944455556666";
+  payload["type"] = "request";
+  payload.createNestedObject("value")["state"] = "On";
+  return signMessage(BENCHMARK_APP_SECRET, request).c_str();
+}
+
+int main() {
+  size_t added = 0;
+  auto addSwitches = [&](size_t count) {
+    for (; added < count; added++) {
+      SinricProSwitch& device = SinricPro[deviceIdFor(added)];
+      device.onPowerState([](const String&, bool&) { return true; });
+    }
+  };
+
+  addSwitches(1);
+  SinricPro.begin(BENCHMARK_APP_KEY, BENCHMARK_APP_SECRET);
+  SinricPro.handle();
+  WebSocketsClient* webSocket = WebSocketsClient::hostInstance();
+  if (!webSocket) return 1;
+  webSocket->hostReceive("{\"timestamp\":1600000000}");
+  SinricPro.handle();
+
+  size_t responses = 0;
+  size_t failures = 0;
+  webSocket->hostOnSend([&](const char* payload, size_t) {
+    responses++;
+    if (strstr(payload, "\"success\":true") == nullptr) failures++;
+  });
+
+  for (size_t count : { 1, 8, 64, 256 }) {
+    addSwitches(count);
+    SinricPro.handle(); // reconnect with the new device list
+
+    std::string first = signedRequest(deviceIdFor(0));
+    std::string last = signedRequest(deviceIdFor(count - 1));
+    responses = failures = 0;
+    webSocket->hostReceive(first.c_str(), first.length());
+    webSocket->hostReceive(last.c_str(), last.length());
+    SinricPro.handle();
+    if (responses != 2 || failures) {
+      fprintf(stderr, "%zu devices: expected 2 successful responses, got %zu (%zu failed)\n", count, responses, failures);
+      return 1;
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zu devices: first device", count);
+    Benchmark firstDevice(name);
+    firstDevice.run(5000, [&]() {
+      webSocket->hostReceive(first.c_str(), first.length());
+      SinricPro.handle();
+    });
+    firstDevice.report();
+
+    snprintf(name, sizeof(name), "%zu devices: last device", count);
+    Benchmark lastDevice(name);
+    lastDevice.run(5000, [&]() {
+      webSocket->hostReceive(last.c_str(), last.length());
+      SinricPro.handle();
+    });
+    lastDevice.report();
+  }
+  return 0;
+}
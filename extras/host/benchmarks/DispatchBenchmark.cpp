@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Time SinricProDevice::handleRequest() needs to find and run the capability handling a
+// request, on the device types with the most capabilities. Callbacks do nothing, an
+// unknown action measures the search for a handler alone. First checks that a custom request
+// handler can use the String API on request.action and request.instance, and that events
+// still take a String cause.
+
+#include <SinricPro.h>
+#include <SinricProTV.h>
+#include <SinricProSpeaker.h>
+#include <SinricProThermostat.h>
+#include <SinricProLight.h>
+#include <SinricProSwitch.h>
+
+#include "Benchmark.h"
+
+// makes the protected request handling of a device type callable
+template <typename DeviceType>
+struct Dispatcher : public DeviceType {
+  Dispatcher() : DeviceType("5dc1564130aaaaaaaaaaaa01") {}
+  using SinricProDevice::handleRequest;
+};
+
+// a custom device handling actions with the String API, like sketches written against String members
+struct CustomDevice : public Dispatcher<SinricProSwitch> {
+  String seen;
+  CustomDevice() {
+    requestHandlers.push_back([this](SinricProRequest& request) {
+      if (!request.action.startsWith("custom") || request.action.isEmpty()) return false;
+      String name = request.action.substring(request.action.indexOf('_') + 1);
+      seen = "action " + request.action + " " + name + " " + request.instance.toInt();
+      return request.action.endsWith(String("_") + name) && request.action.equalsIgnoreCase("CUSTOM_blink") && request.action[0] == 'c';
+    });
+  }
+};
+
+// sendModeEvent(String, String) can't tell (mode, cause) from (instance, mode), it must not compile
+template <typename DeviceType, typename = void>
+struct ModeEventWithTwoStrings : std::false_type {};
+template <typename DeviceType>
+struct ModeEventWithTwoStrings<DeviceType, decltype((void) std::declval<DeviceType&>().sendModeEvent(std::declval<String&>(), std::declval<String&>()))> : std::true_type {};
+static_assert(!ModeEventWithTwoStrings<SinricProSpeaker>::value, "sendModeEvent(String, String) compiles");
+
+static bool checkStringCompatibility() {
+  CustomDevice device;
+  DynamicJsonDocument doc(64);
+  JsonObject request_value = doc.createNestedObject("request");
+  JsonObject response_value = doc.createNestedObject("response");
+  SinricProRequest request { "custom_blink", "42", request_value, response_value };
+  if (!device.handleRequest(request) || device.seen != "action custom_blink blink 42") {
+    fprintf(stderr, "custom handler: String API of request.action gave \"%s\"\n", device.seen.c_str());
+    return false;
+  }
+  String cause = "PERIODIC_POLL";
+  device.sendPowerStateEvent(true, cause);  // not connected, only has to compile
+  String mode = "Movie";
+  Dispatcher<SinricProSpeaker> speaker;
+  speaker.sendModeEvent(mode, cause.c_str());
+  speaker.sendModeEvent(String("Sound"), mode, cause);
+  return true;
+}
+
+template <typename DeviceType>
+static bool dispatch(const char* name, Dispatcher<DeviceType>& device, std::vector<const char*> actions) {
+  DynamicJsonDocument requestDoc(256);
+  DynamicJsonDocument responseDoc(256);
+  JsonObject request_value = requestDoc.to<JsonObject>();
+  request_value["channel"]["name"] = "HBO";
+  JsonObject band = request_value.createNestedArray("bands").createNestedObject();
+  band["name"] = "BASS";
+  band["level"] = 1;
+  JsonObject response_value = responseDoc.to<JsonObject>();
+  const char* instance = "";
+  std::vector<const char*>& actionNames = actions;
+
+  // sanity check: every action reaches its callback
+  for (auto& action : actionNames) {
+    SinricProRequest request { action, instance, request_value, response_value };
+    if (!device.handleRequest(request)) {
+      fprintf(stderr, "%s: \"%s\" was not handled\n", name, action);
+      return false;
+    }
+  }
+
+  size_t index = 0;
+  char label[64];
+  snprintf(label, sizeof(label), "%s: all actions", name);
+  Benchmark all(label);
+  all.run(200000, [&]() {
+    response_value = responseDoc.to<JsonObject>(); // handlers write into the response
+    SinricProRequest request { actionNames[index++ % actionNames.size()], instance, request_value, response_value };
+    device.handleRequest(request);
+  });
+  char extra[64];
+  snprintf(extra, sizeof(extra), "(%zu actions)", actionNames.size());
+  all.report(extra);
+
+  snprintf(label, sizeof(label), "%s: %s", name, actions.back());
+  Benchmark last(label);
+  last.run(200000, [&]() {
+    response_value = responseDoc.to<JsonObject>();
+    SinricProRequest request { actionNames.back(), instance, request_value, response_value };
+    device.handleRequest(request);
+  });
+  last.report();
+
+  // nothing handles this action, so only the search for a handler is measured
+  const char* unknown = "unknownAction";
+  snprintf(label, sizeof(label), "%s: unknown action", name);
+  Benchmark miss(label);
+  miss.run(200000, [&]() {
+    SinricProRequest request { unknown, instance, request_value, response_value };
+    device.handleRequest(request);
+  });
+  miss.report();
+  return true;
+}
+
+int main() {
+  Dispatcher<SinricProTV> tv;
+  tv.onPowerState([](const String&, bool&) { return true; });
+  tv.onSetVolume([](const String&, int&) { return true; });
+  tv.onAdjustVolume([](const String&, int&, bool) { return true; });
+  tv.onMute([](const String&, bool&) { return true; });
+  tv.onMediaControl([](const String&, String&) { return true; });
+  tv.onSelectInput([](const String&, String&) { return true; });
+  tv.onChangeChannel([](const String&, String&) { return true; });
+  tv.onSkipChannels([](const String&, const int, String&) { return true; });
+
+  Dispatcher<SinricProSpeaker> speaker;
+  speaker.onPowerState([](const String&, bool&) { return true; });
+  speaker.onMute([](const String&, bool&) { return true; });
+  speaker.onSetVolume([](const String&, int&) { return true; });
+  speaker.onAdjustVolume([](const String&, int&, bool) { return true; });
+  speaker.onMediaControl([](const String&, String&) { return true; });
+  speaker.onSelectInput([](const String&, String&) { return true; });
+  speaker.onSetBands([](const String&, const String&, int&) { return true; });
+  speaker.onAdjustBands([](const String&, const String&, int&) { return true; });
+  speaker.onResetBands([](const String&, const String&, int&) { return true; });
+  speaker.onSetMode([](const String&, String&) { return true; });
+
+  Dispatcher<SinricProThermostat> thermostat;
+  thermostat.onPowerState([](const String&, bool&) { return true; });
+  thermostat.onTargetTemperature([](const String&, float&) { return true; });
+  thermostat.onAdjustTargetTemperature([](const String&, float&) { return true; });
+  thermostat.onThermostatMode([](const String&, String&) { return true; });
+
+  Dispatcher<SinricProLight> light;
+  light.onPowerState([](const String&, bool&) { return true; });
+  light.onBrightness([](const String&, int&) { return true; });
+  light.onAdjustBrightness([](const String&, int&) { return true; });
+  light.onColor([](const String&, byte&, byte&, byte&) { return true; });
+  light.onColorTemperature([](const String&, int&) { return true; });
+  light.onIncreaseColorTemperature([](const String&, int&) { return true; });
+  light.onDecreaseColorTemperature([](const String&, int&) { return true; });
+
+  bool success =
+    checkStringCompatibility() &&
+    dispatch("TV", tv, { "setPowerState", "setVolume", "adjustVolume", "setMute", "mediaControl", "selectInput", "changeChannel", "skipChannels" }) &&
+    dispatch("Speaker", speaker, { "setPowerState", "setMute", "setVolume", "adjustVolume", "mediaControl", "selectInput", "setBands", "adjustBands", "resetBands", "setMode" }) &&
+    dispatch("Thermostat", thermostat, { "setPowerState", "targetTemperature", "adjustTargetTemperature", "setThermostatMode" }) &&
+    dispatch("Light", light, { "setPowerState", "setBrightness", "adjustBrightness", "setColor", "setColorTemperature", "increaseColorTemperature", "decreaseColorTemperature" });
+  return success ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SINRICPRO_DUAL_CORE on: the worker runs in a std::thread, the main thread calls
+// SinricPro.handle() like the Arduino loop task. Signed setPowerState requests are posted to
+// the websocket with up to WINDOW of them unanswered, the callback takes 0 or 20 us. Reports
+// requests per second and the loop task time per request. Checks first that every response
+// and an event sent by the loop task arrive correctly signed.
+// Built a second time without SINRICPRO_DUAL_CORE as SingleCoreBenchmark for comparison.
+
+#ifndef BENCHMARK_SINGLE_CORE
+#define SINRICPRO_DUAL_CORE
+#endif
+
+#include <SinricPro.h>
+#include <SinricProSwitch.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "Benchmark.h"
+
+#define DEVICES 8
+#define WINDOW  8   // requests in flight at most, they fit into the receive queue
+
+#ifdef SINRICPRO_DUAL_CORE
+#define MODE "dual core"
+#else
+#define MODE "single core"
+#endif
+
+static std::chrono::microseconds callbackWork(0);
+static std::atomic<size_t> responses(0), events(0);
+static std::mutex checkedMutex;
+static std::vector<std::string> checked;  // messages sent while `checking`
+static std::atomic<bool> checking(false);
+
+static std::string deviceId(int index) {
+  char id[DEVICEID_STRLEN + 1];
+  snprintf(id, sizeof(id), "5dc1564130dddddddddddd%02x", index);
+  return id;
+}
+
+static std::string signedRequest(int index) {
+  DynamicJsonDocument request(1024);
+  request["header"]["payloadVersion"] = 2;
+  request["header"]["signatureVersion"] = 1;
+  JsonObject payload = request.createNestedObject("payload");
+  payload["action"] = "setPowerState";
+  payload["clientId"] = "alexa-skill";
+  payload["createdAt"] = 1600000000;
+  payload.createNestedArray("deviceAttributes");
+  payload["deviceId"] = deviceId(index % DEVICES).c_str();
+  char token[MESSAGEID_STRLEN + 1];
+  snprintf(token, sizeof(token), "00000000-0000-4000-8000-%012x", index);
+  payload["replyToken"] = token;
+  payload["type"] = "request";
+  payload["value"]["state"] = index % 2 ? "On" : "Off";
+  String frame = signMessage(BENCHMARK_APP_SECRET, request);
+  return std::string(frame.c_str(), frame.length());
+}
+
+// called by the task sending: the worker in dual core mode
+static void onSend(const char* frame, size_t length) {
+  std::string text(frame, length);
+  if (checking) {
+    std::lock_guard<std::mutex> lock(checkedMutex);
+    checked.push_back(text);
+  }
+  if (text.find("\"type\":\"response\"") != std::string::npos) responses++;
+  if (text.find("\"type\":\"event\"") != std::string::npos) events++;
+}
+
+// posts `count` requests with at most WINDOW unanswered, returns the time spent in SinricPro.handle()
+static Benchmark::clock::duration run(WebSocketsClient* webSocket, const std::vector<std::string>& requests, size_t count, Benchmark::clock::duration timeout) {
+  size_t posted = 0, first = responses;
+  Benchmark::clock::duration inHandle = Benchmark::clock::duration::zero();
+  Benchmark::clock::time_point end = Benchmark::clock::now() + timeout;
+  while (responses - first < count && Benchmark::clock::now() < end) {
+    while (posted < count && posted - (responses - first) < WINDOW) {
+      const std::string& request = requests[posted++ % requests.size()];
+      webSocket->hostPost(request.c_str(), request.length());
+    }
+    Benchmark::clock::time_point start = Benchmark::clock::now();
+    SinricPro.handle();
+    inHandle += Benchmark::clock::now() - start;
+    if (!SinricPro.hasPendingWork()) std::this_thread::yield();  // like the Arduino loop task between two loop() calls
+  }
+  return inHandle;
+}
+
+static bool check(WebSocketsClient* webSocket, const std::vector<std::string>& requests, SinricProSwitch& firstSwitch) {
+  checking = true;
+  run(webSocket, requests, requests.size(), std::chrono::seconds(5));
+  firstSwitch.sendPowerStateEvent(true);
+  Benchmark::clock::time_point end = Benchmark::clock::now() + std::chrono::seconds(1);
+  while (events == 0 && Benchmark::clock::now() < end) SinricPro.handle();
+  checking = false;
+
+  std::lock_guard<std::mutex> lock(checkedMutex);
+  size_t valid = 0;
+  for (auto& frame : checked) {
+    DynamicJsonDocument message(1024);
+    deserializeJson(message, frame.c_str(), frame.length());
+    if (verifyMessage(BENCHMARK_APP_SECRET, message) && (message["payload"]["createdAt"] | 0) >= 1600000000) valid++;
+  }
+  if (checked.size() != requests.size() + 1 || valid != checked.size() || events != 1) {
+    fprintf(stderr, "%zu of %zu messages sent, %zu correctly signed\n", checked.size(), requests.size() + 1, valid);
+    return false;
+  }
+  return true;
+}
+
+static void measure(const char* name, WebSocketsClient* webSocket, const std::vector<std::string>& requests, std::chrono::microseconds work) {
+  const size_t count = 20000;
+  callbackWork = work;
+  Benchmark::clock::time_point start = Benchmark::clock::now();
+  Benchmark::clock::duration inHandle = run(webSocket, requests, count, std::chrono::seconds(60));
+  Benchmark benchmark(name);
+  benchmark.record(count, Benchmark::clock::now() - start);
+  char extra[96];
+  snprintf(extra, sizeof(extra), "%6.2f us/request in handle(), callback %d us", std::chrono::duration<double, std::micro>(inHandle).count() / count,
+           (int) work.count());
+  benchmark.report(extra);
+}
+
+int main() {
+  std::vector<SinricProSwitch*> switches;
+  for (int i = 0; i < DEVICES; i++) {
+    SinricProSwitch& device = SinricPro[deviceId(i).c_str()];
+    device.onPowerState([](const String&, bool&) {
+      Benchmark::clock::time_point end = Benchmark::clock::now() + callbackWork;
+      while (Benchmark::clock::now() < end);
+      return true;
+    });
+    switches.push_back(&device);
+  }
+  std::vector<std::string> requests;
+  for (int i = 0; i < 64; i++) requests.push_back(signedRequest(i));
+
+  SinricPro.begin(BENCHMARK_APP_KEY, BENCHMARK_APP_SECRET);
+  Benchmark::clock::time_point end = Benchmark::clock::now() + std::chrono::seconds(1);
+  while (!SinricPro.isConnected() && Benchmark::clock::now() < end) SinricPro.handle();
+  WebSocketsClient* webSocket = WebSocketsClient::hostInstance();
+  if (!webSocket || !SinricPro.isConnected()) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  webSocket->hostOnSend(onSend);
+  webSocket->hostPost("{\"timestamp\":1600000000}", 24);
+
+  if (!check(webSocket, requests, *switches[0])) return 1;
+  measure(MODE ": request -> response", webSocket, requests, std::chrono::microseconds(0));
+  measure(MODE ": request -> 20 us callback", webSocket, requests, std::chrono::microseconds(20));
+  SinricPro.stop();
+  return 0;
+}
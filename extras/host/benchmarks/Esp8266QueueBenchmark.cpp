@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Queue sizes of ESP8266: checks that the largest recorded requests fit SINRICPRO_QUEUE_RECORD_SIZE and that
+// nothing is dropped for a burst of requests as large as the receive queue holds, a drain of UDP_PACKETS_PER_HANDLE
+// packets and two events plus a telemetry event queued before handle() sends them.
+
+// the configuration of ESP8266, the rest of the library is built for the host
+#define ESP8266
+#include <SinricProConfig.h>
+#undef ESP8266
+
+#include "BenchmarkFleet.h"
+#include "WiFiUdp.h"
+
+#include <algorithm>
+
+static int fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  return 1;
+}
+
+static size_t recordSize(interface_t interface, size_t length) {
+  return (sizeof(SinricProMessage) + SinricProRemote::sizeFor(interface) + length + 1 + 3) & ~size_t(3);
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  // largest first, so every burst is made of the largest requests recorded
+  std::sort(requests.begin(), requests.end(), [](const std::string& a, const std::string& b) { return a.length() > b.length(); });
+  const size_t receiveBurst = SINRICPRO_RECEIVE_QUEUE_SIZE / SINRICPRO_QUEUE_RECORD_SIZE;
+  if (requests.size() < std::max(receiveBurst, (size_t) UDP_PACKETS_PER_HANDLE)) return 1;
+
+  printf("receive queue %d bytes (%zu messages), UDP_PACKETS_PER_HANDLE %d\n", SINRICPRO_RECEIVE_QUEUE_SIZE, receiveBurst, UDP_PACKETS_PER_HANDLE);
+  printf("send queue %d bytes: responses %d, events %d, telemetry %d\n", SINRICPRO_SEND_QUEUE_SIZE,
+         SINRICPRO_SEND_QUEUE_RESPONSE_SIZE, SINRICPRO_SEND_QUEUE_EVENT_SIZE, SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE);
+  if (recordSize(IF_UDP, requests[0].length()) > SINRICPRO_QUEUE_RECORD_SIZE) return fail("largest recorded request is larger than SINRICPRO_QUEUE_RECORD_SIZE");
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) return fail("SinricPro did not connect");
+
+  size_t sent = 0, failures = 0;
+  webSocket->hostOnSend([&](const char* payload, size_t) {
+    sent++;
+    if (strstr(payload, "\"type\":\"response\"") && !strstr(payload, "\"success\":true")) failures++;
+  });
+
+  // as many of the largest requests as the receive queue holds, arriving before handle()
+  for (size_t i = 0; i < receiveBurst; i++) webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+  SinricPro.handle();
+  if (sent != receiveBurst || failures) return fail("websocket burst: request or response dropped");
+
+  // one drain of UDP_PACKETS_PER_HANDLE packets
+  size_t replies = 0;
+  WiFiUDP::hostOnSend([&](IPAddress, uint16_t, const uint8_t*, size_t) { replies++; });
+  for (size_t i = 0; i < UDP_PACKETS_PER_HANDLE; i++) WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t*) requests[i].c_str(), requests[i].length());
+  SinricPro.handle();
+  WiFiUDP::hostOnSend(nullptr);
+  if (replies != UDP_PACKETS_PER_HANDLE) return fail("UDP drain: request or response dropped");
+
+  // two events and a telemetry event queued before handle(), of different devices so no rate limit applies
+  sent = 0;
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  if (!fleet.mySwitch->sendPowerStateEvent(true)) return fail("first event dropped");
+  if (!fleet.myDimSwitch->sendPowerLevelEvent(100)) return fail("second event dropped");
+  if (!fleet.myLight->sendPowerStateEvent(true, FSTR_SINRICPRO_PERIODIC_POLL)) return fail("telemetry event dropped");
+  SinricPro.handle();
+  if (sent != 3) return fail("queued events were not sent");
+  printf("%zu requests over websocket, %d over UDP and 3 events, nothing dropped\n", receiveBurst, UDP_PACKETS_PER_HANDLE);
+  return 0;
+}
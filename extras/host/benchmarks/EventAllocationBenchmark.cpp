@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Heap allocations per sendPowerStateEvent() / sendTemperatureEvent() call. The event
+// document is borrowed from the pool and queued into the send queue, so every allocation
+// counted here comes from building the event's content. Fails if an event allocates.
+
+#include <SinricProTemperaturesensor.h>
+
+#include "BenchmarkFleet.h"
+#include "HostHeap.h"
+
+#define SENSOR_ID "5dc1564130aaaaaaaaaaaa08"
+
+// sends `batches` x 16 events, flushing the send queue between batches outside of the measurement
+template <typename SendEvent>
+static bool measure(const char* name, uint64_t batches, SendEvent sendEvent) {
+  const uint64_t batchSize = 16;
+  Benchmark benchmark(name);
+  Benchmark::clock::duration time(0);
+  HostHeap::Stats heap = {0, 0, 0};
+  for (uint64_t batch = 0; batch < batches; batch++) {
+    HostHeap::reset();
+    Benchmark::clock::time_point start = Benchmark::clock::now();
+    for (uint64_t i = 0; i < batchSize; i++) {
+      HostClock::advanceMillis(DROP_OUT_TIME); // keeps the rate limiter from dropping events
+      sendEvent();
+    }
+    time += Benchmark::clock::now() - start;
+    HostHeap::Stats stats = HostHeap::stats();
+    heap.allocations += stats.allocations;
+    heap.bytes += stats.bytes;
+    SinricPro.handle();
+  }
+  uint64_t events = batches * batchSize;
+  benchmark.record(events, time);
+  char extra[96];
+  snprintf(extra, sizeof(extra), "%6.1f allocs/op %8.1f bytes/op", (double) heap.allocations / events, (double) heap.bytes / events);
+  benchmark.report(extra);
+  if (heap.allocations) fprintf(stderr, "%s allocates memory\n", name);
+  return heap.allocations == 0;
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  if (traffic.empty()) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  SinricProTemperaturesensor& sensor = SinricPro[SENSOR_ID];
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+
+  // sanity check: action and cause arrive as given
+  std::vector<std::string> sent;
+  webSocket->hostOnSend([&](const char* payload, size_t length) { sent.emplace_back(payload, length); });
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  fleet.mySwitch->sendPowerStateEvent(true);
+  sensor.sendTemperatureEvent(21.5, 40);
+  SinricPro.handle();
+  const char* expected[][2] = { { "setPowerState", "PHYSICAL_INTERACTION" }, { "currentTemperature", "PERIODIC_POLL" } };
+  for (size_t i = 0; i < 2; i++) {
+    DynamicJsonDocument event(1024);
+    if (i >= sent.size() || deserializeJson(event, sent[i].c_str())) {
+      fprintf(stderr, "Event %zu was not sent\n", i);
+      return 1;
+    }
+    if (strcmp(event["payload"]["action"] | "", expected[i][0]) || strcmp(event["payload"]["cause"]["type"] | "", expected[i][1])) {
+      fprintf(stderr, "Event has the wrong action or cause:\n%s\n", sent[i].c_str());
+      return 1;
+    }
+  }
+  webSocket->hostOnSend([](const char*, size_t) {});
+
+  bool state = false;
+  float temperature = 20;
+  bool noAllocations = measure("sendPowerStateEvent", 1250, [&]() { fleet.mySwitch->sendPowerStateEvent(state = !state); });
+  noAllocations &= measure("sendTemperatureEvent", 1250, [&]() { sensor.sendTemperatureEvent(temperature += 0.1f, 40); });
+  return noAllocations ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Events posted from other tasks: PRODUCERS threads post numbered events into a
+// SinricProEventIntake drained by the main thread, which checks that every accepted event is
+// taken once and in the order of its producer and that the rest is counted as dropped. Then end
+// to end on the virtual clock: the threads call post...Event() on the fleet while the main
+// thread runs SinricPro.handle(), every accepted event is either sent or rate limited.
+// Reports the time per post() with all producers competing.
+
+#define SINRICPRO_METRICS
+
+#include "BenchmarkFleet.h"
+#include "HostClock.h"
+
+#include <atomic>
+#include <thread>
+
+#define PRODUCERS 8
+
+static bool fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  return false;
+}
+
+// values[0] = producer, values[1] = number of the event posted by this producer
+static bool stress(size_t perProducer, Benchmark::clock::duration& posting) {
+  static SinricProEventIntake intake;
+  std::atomic<size_t> accepted(0), running(PRODUCERS);
+  std::atomic<int64_t> postingNanos(0);
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < PRODUCERS; producer++) {
+    producers.emplace_back([&, producer]() {
+      size_t mine = 0;
+      Benchmark::clock::time_point start = Benchmark::clock::now();
+      for (size_t i = 0; i < perProducer; i++) {
+        SinricProPostedEvent event { nullptr, nullptr, nullptr, false, { (float) producer, (float) i } };
+        if (intake.post(event)) mine++;
+        else std::this_thread::yield();  // full: let the consumer catch up, like an interrupt ending
+      }
+      postingNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(Benchmark::clock::now() - start).count();
+      accepted += mine;
+      running--;
+    });
+  }
+
+  std::vector<long> last(PRODUCERS, -1);
+  size_t taken = 0;
+  bool ordered = true;
+  SinricProPostedEvent event;
+  for (;;) {
+    bool done = running == 0;  // read before the last take(), an event posted meanwhile is taken by the next round
+    if (!intake.take(event)) {
+      if (done) break;
+      std::this_thread::yield();
+      continue;
+    }
+    int producer = (int) event.values[0];
+    long number = (long) event.values[1];
+    if (producer < 0 || producer >= PRODUCERS || number <= last[producer]) ordered = false;
+    else last[producer] = number;
+    taken++;
+  }
+  for (auto& thread : producers) thread.join();
+
+  posting = std::chrono::nanoseconds(postingNanos.load());
+  if (!ordered) return fail("events were taken out of order");
+  if (taken != accepted) return fail("accepted events got lost or were taken twice");
+  if (intake.getDropped() != PRODUCERS * perProducer - accepted) return fail("dropped events were not counted");
+  printf("%zu events posted, %zu taken, %u dropped\n", PRODUCERS * perProducer, taken, intake.getDropped());
+  return true;
+}
+
+static bool checkEndToEnd(WebSocketsClient* webSocket, BenchmarkFleet& fleet) {
+  const size_t perProducer = 2000;
+  std::atomic<size_t> sent(0), accepted(0), running(PRODUCERS);
+  webSocket->hostOnSend([&](const char* frame, size_t length) {
+    if (std::string(frame, length).find("\"type\":\"event\"") != std::string::npos) sent++;
+  });
+  SinricPro.getMetrics().reset();
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < PRODUCERS; producer++) {
+    producers.emplace_back([&, producer]() {
+      size_t mine = 0;
+      for (size_t i = 0; i < perProducer; i++) {
+        switch (i % 3) {
+          case 0: mine += fleet.mySwitch->postPowerStateEvent(i % 2); break;
+          case 1: mine += fleet.myLight->postPowerStateEvent(i % 2); break;
+          default: mine += fleet.myThermostat->postTemperatureEvent(20.0f + producer, 50.0f); break;
+        }
+        if (i % 16 == 0) std::this_thread::yield();
+      }
+      accepted += mine;
+      running--;
+    });
+  }
+  while (running > 0 || SinricPro.hasPendingWork()) {
+    HostClock::advanceMillis(DROP_IN_TIME);
+    SinricPro.handle();
+    if (!SinricPro.hasPendingWork()) std::this_thread::yield();
+  }
+  for (auto& thread : producers) thread.join();
+  webSocket->hostOnSend(nullptr);
+
+  size_t rateLimited = SinricPro.getMetrics().rateLimitedEvents.get();
+  printf("%zu events posted, %zu accepted: %zu sent, %zu rate limited\n", PRODUCERS * perProducer, (size_t) accepted, (size_t) sent, rateLimited);
+  if (accepted == 0 || sent == 0) return fail("no posted event was sent");
+  if (sent + rateLimited != accepted) return fail("posted events got lost between the intake and the websocket");
+  return true;
+}
+
+int main() {
+  const size_t perProducer = 200000;
+  Benchmark::clock::duration posting;
+  if (!stress(perProducer, posting)) return 1;
+
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  if (!checkEndToEnd(webSocket, fleet)) return 1;
+
+  Benchmark benchmark("post() with 8 producers");
+  benchmark.record(PRODUCERS * perProducer, posting);
+  benchmark.report("per event and producer, yielding while full");
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SinricPro.setHandleBudget(): a burst of requests handled without budget (one handle()), with
+// a budget of messages (requests and responses in turns, hasPendingWork() until the burst is
+// answered) and with a budget of time, then the longest handle() call for a burst with and
+// without a budget.
+
+#include "BenchmarkFleet.h"
+
+#define BURST 10  // requests fitting into the receive queue at once
+
+static bool fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  return false;
+}
+
+static void deliver(WebSocketsClient* webSocket, const std::vector<std::string>& requests) {
+  for (size_t i = 0; i < BURST; i++) webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+}
+
+static bool checkBudget(WebSocketsClient* webSocket, const std::vector<std::string>& requests) {
+  size_t sent = 0;
+  webSocket->hostOnSend([&](const char*, size_t) { sent++; });
+
+  // no budget: one handle() answers the burst
+  deliver(webSocket, requests);
+  if (!SinricPro.hasPendingWork()) return fail("hasPendingWork() is false with requests queued");
+  SinricPro.handle();
+  if (sent != BURST || SinricPro.hasPendingWork()) return fail("burst was not answered by one handle() without budget");
+
+  // 4 messages: two requests and their responses per call
+  SinricPro.setHandleBudget(4, 0);
+  sent = 0;
+  deliver(webSocket, requests);
+  for (size_t call = 1; call <= BURST / 2; call++) {
+    size_t before = sent;
+    SinricPro.handle();
+    if (sent - before != 2) return fail("receive and send queue were not handled in turns");
+    if (SinricPro.hasPendingWork() != (call < BURST / 2)) return fail("hasPendingWork() does not match the queues");
+  }
+  if (sent != BURST) return fail("not every request was answered within the message budget");
+
+  // 1 us: a single message per call
+  SinricPro.setHandleBudget(0, 1);
+  sent = 0;
+  deliver(webSocket, requests);
+  size_t calls = 0;
+  while (SinricPro.hasPendingWork() && calls < 4 * BURST) {
+    SinricPro.handle();
+    calls++;
+  }
+  if (sent != BURST || calls != 2 * BURST) return fail("time budget did not limit handle() to one message");
+
+  SinricPro.setHandleBudget(0, 0);
+  webSocket->hostOnSend(nullptr);
+  return true;
+}
+
+static void measure(const char* name, WebSocketsClient* webSocket, const std::vector<std::string>& requests, size_t messages) {
+  const size_t bursts = 2000;
+  SinricPro.setHandleBudget(messages, 0);
+  Benchmark::clock::duration longest = Benchmark::clock::duration::zero();
+  size_t calls = 0;
+  Benchmark benchmark(name);
+  Benchmark::clock::time_point start = Benchmark::clock::now();
+  for (size_t burst = 0; burst < bursts; burst++) {
+    deliver(webSocket, requests);
+    do {
+      Benchmark::clock::time_point callStart = Benchmark::clock::now();
+      SinricPro.handle();
+      longest = std::max(longest, Benchmark::clock::now() - callStart);
+      calls++;
+    } while (SinricPro.hasPendingWork());
+  }
+  Benchmark::clock::duration elapsed = Benchmark::clock::now() - start;
+  benchmark.record(bursts * BURST, elapsed);
+  char extra[128];
+  snprintf(extra, sizeof(extra), "%5.2f handle()/burst, handle() mean %.1f us longest %.1f us", (double) calls / bursts,
+           std::chrono::duration<double, std::micro>(elapsed).count() / calls, std::chrono::duration<double, std::micro>(longest).count());
+  benchmark.report(extra);
+  SinricPro.setHandleBudget(0, 0);
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.size() < BURST) return 1;
+
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  if (!checkBudget(webSocket, requests)) return 1;
+
+  measure("burst: no budget", webSocket, requests, 0);
+  measure("burst: 2 messages per handle()", webSocket, requests, 2);
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SINRICPRO_HEAP_TRACKING on: a steady stream of recorded requests and events through
+// SinricPro.handle(), heap allocations attributed to the library stages by
+// SinricPro.getHeapTracker(). Fails if a message allocates more than the budget or if the
+// heap keeps growing (memory retained by the steady state).
+
+#define SINRICPRO_HEAP_TRACKING
+
+#include "BenchmarkFleet.h"
+#include "HostHeap.h"
+
+// allocations per request -> response: the callbacks get the device id (and some values) as String,
+// events must not allocate at all (see EventAllocationBenchmark)
+#define REQUEST_ALLOCATION_BUDGET 2
+#define EVENT_ALLOCATION_BUDGET   0
+
+#define HOST_HEAP_SIZE 0x40000000
+
+static void hostHeapProbe(SinricProHeapSnapshot& snapshot) {
+  HostHeap::Stats stats = HostHeap::stats();
+  snapshot.allocations = (uint32_t) stats.allocations;
+  snapshot.bytes = (uint32_t) stats.bytes;
+  snapshot.freeHeap = HOST_HEAP_SIZE - (uint32_t) HostHeap::liveBytes();
+}
+
+// every request once and an event per request, on the virtual clock so no event is rate limited
+static void stream(WebSocketsClient* webSocket, BenchmarkFleet& fleet, const std::vector<std::string>& requests, size_t rounds) {
+  bool state = false;
+  for (size_t round = 0; round < rounds; round++) {
+    for (auto& frame : requests) {
+      {
+        SinricProHeapStage receive(HEAP_STAGE_RECEIVE); // on a device frames are received within SinricPro.handle()
+        webSocket->hostReceive(frame.c_str(), frame.length());
+      }
+      HostClock::advanceMillis(DROP_OUT_TIME);
+      fleet.myLight->sendPowerStateEvent(state = !state);
+      SinricPro.handle();
+    }
+  }
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.empty()) return 1;
+
+  SinricProHeapTracker& tracker = SinricPro.getHeapTracker();
+  tracker.setProbe(hostHeapProbe);
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  size_t sent = 0;
+  webSocket->hostOnSend([&](const char*, size_t) { sent++; });
+  printf("connect: %lu allocations, %lu bytes\n", (unsigned long) tracker.getStage(HEAP_STAGE_CONNECT).allocations,
+         (unsigned long) tracker.getStage(HEAP_STAGE_CONNECT).bytes);
+
+  // warm up: pools, queues and lazily created buffers reach their steady size
+  stream(webSocket, fleet, requests, 5);
+
+  const size_t rounds = 1000;
+  tracker.reset();
+  sent = 0;
+  Benchmark benchmark("steady state: request -> response + event");
+  Benchmark::clock::time_point start = Benchmark::clock::now();
+  stream(webSocket, fleet, requests, rounds);
+  benchmark.record(rounds * requests.size(), Benchmark::clock::now() - start);
+
+  SinricProHeapTracker::StageStats total = tracker.total();
+  SinricProHeapTracker::StageStats event = tracker.getStage(HEAP_STAGE_EVENT);
+  double messages = (double) rounds * requests.size();
+  double requestAllocations = (total.allocations - event.allocations) / messages;
+  double eventAllocations = event.allocations / messages;
+  char extra[128];
+  snprintf(extra, sizeof(extra), "%6.1f allocs/request %6.1f allocs/event %8.1f bytes/op", requestAllocations, eventAllocations, total.bytes / messages);
+  benchmark.report(extra);
+  tracker.printTo(Serial);
+
+  bool success = true;
+  if (sent != 2 * rounds * requests.size()) {
+    fprintf(stderr, "%zu of %.0f messages were sent\n", sent, 2 * messages);
+    success = false;
+  }
+  if (requestAllocations > REQUEST_ALLOCATION_BUDGET || eventAllocations > EVENT_ALLOCATION_BUDGET) {
+    fprintf(stderr, "allocation budget exceeded: %.1f allocs/request (budget %d), %.1f allocs/event (budget %d)\n",
+            requestAllocations, REQUEST_ALLOCATION_BUDGET, eventAllocations, EVENT_ALLOCATION_BUDGET);
+    success = false;
+  }
+  if (total.retained > 0) {
+    fprintf(stderr, "steady state retained %ld bytes\n", (long) total.retained);
+    success = false;
+  }
+  return success ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Parsing and formatting of DeviceId / AppKey / AppSecret: checks the table driven codec
+// against the sscanf / sprintf conversion it replaced (random ids, malformed strings) and
+// the compile time id literals against both, then compares ns per parse and per format.
+
+#include <SinricPro.h>
+
+#include "Benchmark.h"
+
+// the sscanf / sprintf conversion used before, the format strings are those of src/SinricProId.h
+#define DEVICEID_SCANF  "%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%c"
+#define DEVICEID_PRINTF "%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x"
+#define APPSECRET_SCANF  "%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%c"
+#define APPSECRET_PRINTF "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x-%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x"
+
+static bool legacyDeviceIdFromString(const char* str, uint8_t* d) {
+  char tmp;
+  bool valid = (sscanf(str, DEVICEID_SCANF, &d[11], &d[10], &d[9], &d[8], &d[7], &d[6], &d[5], &d[4], &d[3], &d[2], &d[1], &d[0], &tmp) == DEVICEID_BINLEN) && (strlen(str) == DEVICEID_STRLEN);
+  if (!valid) memset(d, 0, DEVICEID_BINLEN);
+  return valid;
+}
+
+static void legacyDeviceIdToString(const uint8_t* d, char* str) {
+  sprintf(str, DEVICEID_PRINTF, d[11], d[10], d[9], d[8], d[7], d[6], d[5], d[4], d[3], d[2], d[1], d[0]);
+}
+
+static bool legacyAppSecretFromString(const char* str, uint8_t* d) {
+  char tmp;
+  bool valid = (sscanf(str, APPSECRET_SCANF,
+    &d[31], &d[30], &d[29], &d[28], &d[27], &d[26], &d[25], &d[24], &d[23], &d[22], &d[21], &d[20], &d[19], &d[18], &d[17], &d[16],
+    &d[15], &d[14], &d[13], &d[12], &d[11], &d[10], &d[9], &d[8], &d[7], &d[6], &d[5], &d[4], &d[3], &d[2], &d[1], &d[0], &tmp) == APPSECRET_BINLEN) && (strlen(str) == APPSECRET_STRLEN);
+  if (!valid) memset(d, 0, APPSECRET_BINLEN);
+  return valid;
+}
+
+static void legacyAppSecretToString(const uint8_t* d, char* str) {
+  sprintf(str, APPSECRET_PRINTF,
+    d[31], d[30], d[29], d[28], d[27], d[26], d[25], d[24], d[23], d[22], d[21], d[20], d[19], d[18], d[17], d[16],
+    d[15], d[14], d[13], d[12], d[11], d[10], d[9], d[8], d[7], d[6], d[5], d[4], d[3], d[2], d[1], d[0]);
+}
+
+// formats random ids with both codecs and parses them back
+static bool checkRoundTrip() {
+  for (int n = 0; n < 10000; n++) {
+    DeviceId_Bin_t deviceId;
+    AppSecret_Bin_t appSecret;
+    for (auto& b : deviceId._data) b = rand();
+    for (auto& b : appSecret._data) b = rand();
+    char expected[APPSECRET_STRLEN + 1], actual[APPSECRET_STRLEN + 1];
+
+    legacyDeviceIdToString(deviceId._data, expected);
+    deviceId.toChars(actual);
+    DeviceId_Bin_t parsedDeviceId;
+    parsedDeviceId.fromString(actual);
+    if (strcmp(expected, actual) || memcmp(parsedDeviceId._data, deviceId._data, DEVICEID_BINLEN)) {
+      fprintf(stderr, "DeviceId round trip failed: %s != %s\n", actual, expected);
+      return false;
+    }
+
+    legacyAppSecretToString(appSecret._data, expected);
+    appSecret.toChars(actual);
+    AppSecret_Bin_t parsedAppSecret;
+    parsedAppSecret.fromString(actual);
+    if (strcmp(expected, actual) || memcmp(parsedAppSecret._data, appSecret._data, APPSECRET_BINLEN)) {
+      fprintf(stderr, "AppSecret round trip failed: %s != %s\n", actual, expected);
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool checkDeviceId(const char* str, bool valid) {
+  DeviceId_Bin_t deviceId;
+  deviceId.fromString(str);
+  uint8_t legacy[DEVICEID_BINLEN];
+  bool legacyValid = legacyDeviceIdFromString(str, legacy);
+  if (DeviceId(str).isValid() != valid || legacyValid != valid || memcmp(legacy, deviceId._data, DEVICEID_BINLEN)) {
+    fprintf(stderr, "DeviceId \"%s\" should be %s\n", str, valid ? "valid" : "invalid");
+    return false;
+  }
+  return true;
+}
+
+// the literal format checks run at compile time
+static_assert(idHexIsValid("5dc1564130aaaaaaaaaaaa01", DEVICEID_STRLEN, DeviceId_Bin_t::groups), "valid device id rejected");
+static_assert(!idHexIsValid("5dc1564130aaaaaaaaaaaa0g", DEVICEID_STRLEN, DeviceId_Bin_t::groups), "malformed device id accepted");
+static_assert(!idHexIsValid("5dc1564130aaaaaaaaaaaa0", DEVICEID_STRLEN - 1, DeviceId_Bin_t::groups), "short device id accepted");
+static_assert(!idHexIsValid("de0b0000-1030-4030-a020-5d00000302a", APPKEY_STRLEN - 1, AppKey_Bin_t::groups), "short app key accepted");
+static_assert(!idHexIsValid("de0b0000x1030-4030-a020-5d00000302a8", APPKEY_STRLEN, AppKey_Bin_t::groups), "app key without '-' accepted");
+
+constexpr DeviceId LITERAL_DEVICE_ID = "5dc1564130aaaaaaaaaaaa01"_deviceid;
+constexpr AppKey LITERAL_APP_KEY = "de0b0000-1030-4030-a020-5d00000302a8"_appkey;
+constexpr AppSecret LITERAL_APP_SECRET = "5f360000-0307-4030-0e0e-e86724a90000-4c4a0000-3030-050e-0903-333d65000000"_appsecret;
+
+static bool checkLiterals() {
+  if (LITERAL_DEVICE_ID != DeviceId("5dc1564130aaaaaaaaaaaa01") || !LITERAL_DEVICE_ID.isValid() ||
+      LITERAL_APP_KEY != AppKey("de0b0000-1030-4030-a020-5d00000302a8") ||
+      LITERAL_APP_SECRET != AppSecret("5f360000-0307-4030-0e0e-e86724a90000-4c4a0000-3030-050e-0903-333d65000000")) {
+    fprintf(stderr, "id literals differ from the parsed ids\n");
+    return false;
+  }
+  // outside of constant expressions a malformed literal gives an invalid id
+  const char* malformed = "5dc1564130aaaaaaaaaaaa0g";
+  if (operator"" _deviceid(malformed, strlen(malformed)).isValid()) {
+    fprintf(stderr, "malformed id literal is valid\n");
+    return false;
+  }
+  return true;
+}
+
+static bool checkAppKey(const char* str, bool valid) {
+  if (AppKey(str).isValid() != valid) {
+    fprintf(stderr, "AppKey \"%s\" should be %s\n", str, valid ? "valid" : "invalid");
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  if (!checkRoundTrip() || !checkLiterals()) return 1;
+  if (!checkDeviceId("5dc1564130aaaaaaaaaaaa01", true) ||
+      !checkDeviceId("5DC1564130AAAAAAAAAAAA01", true) ||
+      !checkDeviceId("5dc1564130aaaaaaaaaaaa0", false) ||    // too short
+      !checkDeviceId("5dc1564130aaaaaaaaaaaa011", false) ||  // too long
+      !checkDeviceId("5dc1564130aaaaaaaaaaaa0g", false) ||   // no hex digit
+      !checkDeviceId("5dc1564130aaaaa\xe1" "aaaaaa01", false) ||
+      !checkDeviceId("", false)) return 1;
+  if (!checkAppKey("de0bxxxx-1x3x-4x3x-ax2x-5dx0x0x3x2x8", false) ||
+      !checkAppKey("de0b0000-1030-4030-a020-5d00000302a8", true) ||
+      !checkAppKey("de0b0000-1030-4030-a020-5d00000302a", false) ||
+      !checkAppKey("de0b0000x1030-4030-a020-5d00000302a8", false)) return 1;
+
+  const char* deviceIdStr = "5dc1564130aaaaaaaaaaaa01";
+  char appSecretHex[APPSECRET_STRLEN + 1];
+  AppSecret_Bin_t appSecret;
+  for (auto& b : appSecret._data) b = rand();
+  appSecret.toChars(appSecretHex);
+
+  const uint64_t iterations = 1000000;
+  DeviceId_Bin_t deviceId;
+  uint8_t data[APPSECRET_BINLEN];
+  char str[APPSECRET_STRLEN + 1];
+
+  Benchmark parseLegacy("DeviceId parse: sscanf");
+  parseLegacy.run(iterations, [&]() { legacyDeviceIdFromString(deviceIdStr, data); });
+  parseLegacy.report();
+  Benchmark parse("DeviceId parse: table");
+  parse.run(iterations, [&]() { deviceId.fromString(deviceIdStr); });
+  parse.report();
+
+  Benchmark formatLegacy("DeviceId format: sprintf");
+  formatLegacy.run(iterations, [&]() { legacyDeviceIdToString(deviceId._data, str); });
+  formatLegacy.report();
+  Benchmark format("DeviceId format: table");
+  format.run(iterations, [&]() { deviceId.toChars(str); });
+  format.report();
+
+  Benchmark secretParseLegacy("AppSecret parse: sscanf");
+  secretParseLegacy.run(iterations / 4, [&]() { legacyAppSecretFromString(appSecretHex, data); });
+  secretParseLegacy.report();
+  Benchmark secretParse("AppSecret parse: table");
+  secretParse.run(iterations / 4, [&]() { appSecret.fromString(appSecretHex); });
+  secretParse.report();
+
+  Benchmark secretFormatLegacy("AppSecret format: sprintf");
+  secretFormatLegacy.run(iterations / 4, [&]() { legacyAppSecretToString(appSecret._data, str); });
+  secretFormatLegacy.report();
+  Benchmark secretFormat("AppSecret format: table");
+  secretFormat.run(iterations / 4, [&]() { appSecret.toChars(str); });
+  secretFormat.report();
+
+  DeviceId id(deviceIdStr);
+  size_t matches = 0;
+  Benchmark compare("DeviceId == const char*");
+  compare.run(iterations, [&]() { matches += (id == deviceIdStr); });
+  compare.report();
+  return matches ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// End to end load against the local server stand-in (SinricProServer.h): the server sends
+// signed setPowerState requests at a fixed rate across M switches (some of them over UDP),
+// the devices send events meanwhile, and every response and event is validated by the server.
+// Checks that the server rejects a forged response first. Fails if a message is invalid, a
+// request is unanswered or an event got lost.
+//
+//   LoadBenchmark [requests per second = 2000] [devices = 40] [seconds = 2] [UDP percent = 10]
+
+#include <SinricProSwitch.h>
+
+#include <algorithm>
+
+#include "Benchmark.h"
+#include "SinricProServer.h"
+
+static std::string deviceId(int index) {
+  char id[DEVICEID_STRLEN + 1];
+  snprintf(id, sizeof(id), "5dc1564130cccccccccc%04x", index);
+  return id;
+}
+
+static bool checkValidation(SinricProServer& server) {
+  std::string response;
+  WebSocketsClient::hostInstance()->hostOnSend([&](const char* frame, size_t length) { response.assign(frame, length); });
+  server.sendRequest(server.deviceIds().front(), "setPowerState", "{\"state\":\"On\"}");
+  SinricPro.handle();
+  server.accept(); // reattach the server to the websocket
+  size_t hmac = response.find("\"HMAC\":\"");
+  if (hmac == std::string::npos) return false;
+  std::string forged = response;
+  forged[hmac + 8] = forged[hmac + 8] == 'A' ? 'B' : 'A';
+  server.receive(forged.c_str(), forged.length(), IF_WEBSOCKET);
+  if (server.stats().invalid != 1) return false;
+  server.receive(response.c_str(), response.length(), IF_WEBSOCKET);
+  if (server.stats().responses != 1 || server.pending() != 0) return false;
+  server.resetStats();
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned rate = argc > 1 ? atoi(argv[1]) : 2000;
+  int devices = argc > 2 ? atoi(argv[2]) : 40;
+  unsigned seconds = argc > 3 ? atoi(argv[3]) : 2;
+  unsigned udpPercent = argc > 4 ? atoi(argv[4]) : 10;
+  if (!rate || devices <= 0 || devices > 0xFFFF || !seconds || udpPercent > 100) {
+    fprintf(stderr, "usage: LoadBenchmark [requests per second] [devices] [seconds] [UDP percent]\n");
+    return 1;
+  }
+
+  std::vector<SinricProSwitch*> switches;
+  for (int i = 0; i < devices; i++) {
+    SinricProSwitch& device = SinricPro[deviceId(i).c_str()];
+    device.onPowerState([](const String&, bool&) { return true; });
+    switches.push_back(&device);
+  }
+  SinricPro.begin(BENCHMARK_APP_KEY, BENCHMARK_APP_SECRET);
+  SinricPro.handle();
+
+  SinricProServer server(BENCHMARK_APP_KEY, BENCHMARK_APP_SECRET);
+  if (!server.accept() || server.deviceIds().size() != (size_t) devices) {
+    fprintf(stderr, "server did not accept the connection: %s\n", server.lastError().c_str());
+    return 1;
+  }
+  SinricPro.handle();
+  if (!checkValidation(server)) {
+    fprintf(stderr, "server does not validate responses\n");
+    return 1;
+  }
+
+  // every device sends an event every 1.1 s, within the rate limit of one event per second
+  const std::chrono::microseconds requestInterval(1000000 / rate);
+  const std::chrono::microseconds eventInterval(1100000 / devices);
+  size_t request = 0, event = 0, eventsSent = 0;
+  Benchmark::clock::time_point start = Benchmark::clock::now();
+  Benchmark::clock::time_point end = start + std::chrono::seconds(seconds);
+  Benchmark::clock::time_point nextRequest = start, nextEvent = start;
+  for (Benchmark::clock::time_point now = start; now < end; now = Benchmark::clock::now()) {
+    if (now >= nextRequest) {
+      const std::string& id = server.deviceIds()[request % devices];
+      interface_t interface = request % 100 < udpPercent ? IF_UDP : IF_WEBSOCKET;
+      server.sendRequest(id, "setPowerState", request % 2 ? "{\"state\":\"On\"}" : "{\"state\":\"Off\"}", interface);
+      request++;
+      nextRequest += requestInterval;
+    }
+    if (now >= nextEvent) {
+      eventsSent += switches[event % devices]->sendPowerStateEvent(event % 2);
+      event++;
+      nextEvent += eventInterval;
+    }
+    SinricPro.handle();
+  }
+  Benchmark::clock::duration elapsed = Benchmark::clock::now() - start;
+  for (int i = 0; i < 1000 && server.pending(); i++) SinricPro.handle();
+
+  const SinricProServer::Stats& stats = server.stats();
+  std::vector<double> latencies = server.latencies();
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](size_t percent) { return latencies.empty() ? 0 : latencies[(latencies.size() - 1) * percent / 100]; };
+  Benchmark benchmark("local server: request -> response");
+  benchmark.record(stats.requests, elapsed);
+  char extra[160];
+  snprintf(extra, sizeof(extra), "latency p50 %.1f p90 %.1f p99 %.1f max %.1f us, %zu devices, %u%% UDP, %u events", percentile(50),
+           percentile(90), percentile(99), percentile(100), (size_t) devices, udpPercent, stats.events);
+  benchmark.report(extra);
+
+  bool success = true;
+  if (stats.invalid) {
+    fprintf(stderr, "%u invalid messages, last: %s\n", stats.invalid, server.lastError().c_str());
+    success = false;
+  }
+  if (server.pending() || stats.failed) {
+    fprintf(stderr, "%zu of %u requests unanswered, %u failed\n", server.pending(), stats.requests, stats.failed);
+    success = false;
+  }
+  if (stats.events != eventsSent) {
+    fprintf(stderr, "%u of %zu events arrived\n", stats.events, eventsSent);
+    success = false;
+  }
+  if (stats.requests < (uint64_t) rate * seconds * 9 / 10) {
+    fprintf(stderr, "only %u of %u requests sent, the client is too slow for this rate\n", stats.requests, rate * seconds);
+    success = false;
+  }
+  return success ? 0 : 1;
+}
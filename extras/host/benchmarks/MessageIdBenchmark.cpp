@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// MessageID (replyToken): checks the UUID version 4 format and that every random byte
+// value and every hex digit is equally likely (chi-squared), then compares time and heap
+// allocations per id with the former String based implementation.
+
+#include <SinricPro.h>
+
+#include "Benchmark.h"
+#include "HostHeap.h"
+
+// the former implementation: 36 String appends, random(255) never returns 0xFF
+static String legacyMessageID() {
+  String id = "";
+  for (byte i=0; i<16; i++) {
+    byte rnd = random(255);
+    if (i==4) id += "-";
+    if (i==6) { id += "-"; rnd = 0x40 | (0x0F & rnd); }
+    if (i==8) { id += "-"; rnd = 0x80 | (0x3F & rnd); }
+    if (i==10) id += "-";
+    id += "0123456789abcdef"[rnd >> 4];
+    id += "0123456789abcdef"[rnd & 0x0f];
+  }
+  return id;
+}
+
+static bool checkFormat(const char* id) {
+  if (strlen(id) != MESSAGEID_STRLEN) return false;
+  for (int i = 0; i < MESSAGEID_STRLEN; i++) {
+    bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+    if (dash != (id[i] == '-')) return false;
+    if (!dash && !strchr("0123456789abcdef", id[i])) return false;
+  }
+  return id[14] == '4' && strchr("89ab", id[19]);
+}
+
+static double chiSquared(const uint64_t* counts, size_t buckets, uint64_t total) {
+  double expected = (double) total / buckets;
+  double sum = 0;
+  for (size_t i = 0; i < buckets; i++) sum += (counts[i] - expected) * (counts[i] - expected) / expected;
+  return sum;
+}
+
+static int hexValue(char c) { return c <= '9' ? c - '0' : c - 'a' + 10; }
+
+// byte values of the 14 bytes without fixed bits, and the hex digits at every position which is fully random
+static bool checkUniformity() {
+  const uint64_t ids = 200000;
+  static uint64_t byteCounts[256];
+  static uint64_t digitCounts[MESSAGEID_STRLEN][16];
+  for (uint64_t n = 0; n < ids; n++) {
+    MessageID messageId;
+    const char* id = messageId.getID();
+    if (!checkFormat(id)) {
+      fprintf(stderr, "MessageID \"%s\" is not a version 4 UUID\n", id);
+      return false;
+    }
+    for (int i = 0; i < MESSAGEID_STRLEN; i++) {
+      if (id[i] != '-') digitCounts[i][hexValue(id[i])]++;
+    }
+    uint8_t bytes[MESSAGEID_BINLEN];
+    int byteIndex = 0;
+    for (int i = 0; i < MESSAGEID_STRLEN; i += 2) {
+      if (id[i] == '-') i++;
+      bytes[byteIndex++] = hexValue(id[i]) << 4 | hexValue(id[i + 1]);
+    }
+    for (int i = 0; i < MESSAGEID_BINLEN; i++) {
+      if (i != 6 && i != 8) byteCounts[bytes[i]]++;
+    }
+  }
+
+  // 99.9% quantiles of the chi-squared distribution with 255 and 15 degrees of freedom
+  double byteChi = chiSquared(byteCounts, 256, ids * (MESSAGEID_BINLEN - 2));
+  printf("byte values: chi-squared %.1f (255 degrees of freedom, limit 330.5)\n", byteChi);
+  if (byteChi > 330.5) return false;
+  for (int i = 0; i < MESSAGEID_STRLEN; i++) {
+    if (i == 8 || i == 13 || i == 14 || i == 18 || i == 19 || i == 23) continue; // dashes, version and variant
+    double digitChi = chiSquared(digitCounts[i], 16, ids);
+    if (digitChi > 37.7) {
+      fprintf(stderr, "hex digit %d: chi-squared %.1f (15 degrees of freedom, limit 37.7)\n", i, digitChi);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void reportHeap(Benchmark& benchmark, uint64_t calls) {
+  HostHeap::Stats stats = HostHeap::stats();
+  char extra[96];
+  snprintf(extra, sizeof(extra), "%6.1f allocs/op %8.1f bytes/op", (double) stats.allocations / calls, (double) stats.bytes / calls);
+  benchmark.report(extra);
+}
+
+int main() {
+  if (!checkUniformity()) return 1;
+
+  const uint64_t iterations = 1000000;
+  size_t length = 0;
+  Benchmark legacy("MessageID: String appends");
+  HostHeap::reset();
+  legacy.run(iterations, [&]() { length += legacyMessageID().length(); });
+  reportHeap(legacy, iterations + iterations / 10); // run() includes the warm up calls
+
+  Benchmark fixed("MessageID: fixed buffer");
+  HostHeap::reset();
+  fixed.run(iterations, [&]() { length += strlen(MessageID().getID()); });
+  reportHeap(fixed, iterations + iterations / 10);
+  return length ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SinricPro.getMetrics(): checks on the virtual clock that recorded traffic, a slow callback,
+// a forged signature, a rate limited event, a message that can't be signed and a burst of requests show up in the histograms
+// and counters, then measures the pipeline with metrics compiled in (compare with
+// PipelineBenchmark, which is built without them) and the cost of recording a duration.
+
+#define SINRICPRO_METRICS
+
+#include "BenchmarkFleet.h"
+
+#define SLOW_CALLBACK_MICROS 300
+
+static bool fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  SinricPro.getMetrics().printTo(Serial);
+  return false;
+}
+
+// a custom device sending an event that can't be signed
+struct UnsignableSwitch : public SinricProSwitch {
+  UnsignableSwitch(const DeviceId& deviceId) : SinricProSwitch(deviceId) {}
+  bool sendUnsignableEvent() {
+    SinricProJsonDocument event = prepareEvent("setPowerState", "PHYSICAL_INTERACTION");
+    event["payload"].remove("createdAt");
+    return sendEvent(event);
+  }
+};
+
+static bool checkMetrics(WebSocketsClient* webSocket, BenchmarkFleet& fleet, UnsignableSwitch& unsignable, const std::vector<std::string>& requests) {
+  SinricProMetrics& metrics = SinricPro.getMetrics();
+  size_t powerStateRequests = 0;
+  for (auto& frame : requests) powerStateRequests += frame.find("\"action\":\"setPowerState\"") != std::string::npos;
+  // only the switch is slow, the other devices with setPowerState are fast
+  fleet.mySwitch->onPowerState([](const String&, bool&) {
+    HostClock::advanceMicros(SLOW_CALLBACK_MICROS);
+    return true;
+  });
+
+  // a burst of requests queued 1000 us apart and handled together
+  const size_t burst = 6;
+  metrics.reset();
+  for (size_t i = 0; i < burst; i++) {
+    webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+    HostClock::advanceMicros(1000);
+  }
+  SinricPro.handle();
+  if (metrics.receiveQueueHighWater.get() != burst) return fail("wrong receive queue high water mark");
+  if (metrics.receiveToDispatch.max() < burst * 1000) return fail("receive to dispatch latency is too short");
+  for (size_t i = burst; i < requests.size(); i++) {
+    webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+    SinricPro.handle();
+  }
+  if (metrics.receiveToDispatch.count() != requests.size() || metrics.signatureVerify.count() != requests.size()) return fail("not every request was counted");
+  if (metrics.sendQueueDwell.count() != requests.size() || metrics.sign.count() != requests.size()) return fail("not every response was counted");
+
+  const SinricProHistogram* slow = metrics.getCallbackTime("setPowerState");
+  if (!slow || slow->count() != powerStateRequests || slow->max() != SLOW_CALLBACK_MICROS || slow->percentile(100) != SLOW_CALLBACK_MICROS) return fail("slow callback was not recorded");
+  const SinricProHistogram* fast = metrics.getCallbackTime("setBrightness");
+  if (!fast || fast->max() != 0 || metrics.getCallbackTime("unknownAction")) return fail("callback histograms are mixed up");
+
+  // a request with a forged signature
+  std::string forged = requests.front();
+  size_t hmac = forged.find("\"HMAC\":\"") + 8;
+  forged[hmac] = forged[hmac] == 'A' ? 'B' : 'A';
+  webSocket->hostReceive(forged.c_str(), forged.length());
+  SinricPro.handle();
+  if (metrics.signatureFailures.get() != 1) return fail("signature failure was not counted");
+
+  // the second event within DROP_IN_TIME is dropped
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  fleet.myLight->sendPowerStateEvent(true);
+  fleet.myLight->sendPowerStateEvent(false);
+  SinricPro.handle();
+  if (metrics.rateLimitedEvents.get() != 1) return fail("rate limited event was not counted");
+
+  // a message without payload.createdAt can't be signed and must not be sent unsigned
+  size_t sent = 0;
+  webSocket->hostOnSend([&](const char*, size_t) { sent++; });
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  if (!unsignable.sendUnsignableEvent()) return fail("unsignable event was not queued");
+  SinricPro.handle();
+  webSocket->hostOnSend(nullptr);
+  if (sent != 0) return fail("unsigned message was sent");
+  if (metrics.unsignedMessages.get() != 1 || SinricPro.hasPendingWork()) return fail("unsigned message was not dropped and counted");
+
+  metrics.printTo(Serial);
+  return true;
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.empty()) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  UnsignableSwitch& unsignable = (UnsignableSwitch&) SinricPro["5dc1564130aaaaaaaaaaaa0f"];
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  if (!checkMetrics(webSocket, fleet, unsignable, requests)) return 1;
+
+  HostClock::useVirtualClock(false);
+  fleet.setup(); // callbacks without delay
+  size_t index = 0;
+  Benchmark single("request -> response with metrics");
+  single.run(20000, [&]() {
+    const std::string& frame = requests[index++ % requests.size()];
+    webSocket->hostReceive(frame.c_str(), frame.length());
+    SinricPro.handle();
+  });
+  single.report();
+
+  SinricProHistogram histogram;
+  uint32_t value = 0;
+  Benchmark record("SinricProHistogram::record");
+  record.run(10000000, [&]() { histogram.record(value += 7); });
+  record.report();
+  return histogram.count() ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SinricPro.nextWakeupMs() on the virtual clock: SinricProTimers across a millis() rollover,
+// then the deadlines of a connected fleet (network poll, queued work, heartbeat, a pending
+// coalesced event, reconnect attempts) and onWakeup() for a posted event. Then a simulated
+// idle hour with a request every 10 s: handle() called every millisecond against sleeping for
+// nextWakeupMs(), with the handle() calls, their CPU time and the request wait.
+
+#define SINRICPRO_NETWORK_POLL_INTERVAL 7000  // not a divisor of WEBSOCKET_PING_INTERVAL, so the heartbeat has its own wakeups
+
+#include "BenchmarkFleet.h"
+#include "HostClock.h"
+
+#include <atomic>
+
+#define REQUEST_INTERVAL 10000
+
+static bool fail(const char* what, unsigned long wait = 0) {
+  fprintf(stderr, "%s (nextWakeupMs() %lu)\n", what, wait);
+  return false;
+}
+
+static unsigned long now() { return (unsigned long) (HostClock::nowMicros() / 1000); }
+
+static bool checkTimers() {
+  SinricProTimers timers;
+  if (timers.timeUntilNext(0) != SINRICPRO_NO_DEADLINE) return fail("stopped timers have a deadline");
+  unsigned long start = SINRICPRO_NO_DEADLINE - 5;
+  timers.start(TIMER_HEARTBEAT, start, 10);
+  timers.start(TIMER_NETWORK, start, 20);
+  if (timers.timeUntilNext(start + 3) != 7) return fail("next timer is not the earliest");
+  if (timers.timeUntil(TIMER_HEARTBEAT, start + 10) != 0 || !timers.isDue(TIMER_HEARTBEAT, start + 12)) return fail("timer is not due across the millis() rollover");
+  timers.stop(TIMER_HEARTBEAT);
+  if (timers.timeUntilNext(start + 12) != 8) return fail("stopped timer still counts");
+  return true;
+}
+
+static std::atomic<int> wakeups(0);
+
+static bool checkDeadlines(WebSocketsClient* webSocket, BenchmarkFleet& fleet, const std::string& request) {
+  unsigned long connected = now();
+  unsigned long wait = SinricPro.nextWakeupMs();
+  if (wait != SINRICPRO_NETWORK_POLL_INTERVAL) return fail("connected and idle: not the network poll", wait);
+  HostClock::advanceMillis(4000);
+  if ((wait = SinricPro.nextWakeupMs()) != SINRICPRO_NETWORK_POLL_INTERVAL - 4000) return fail("network poll did not come closer", wait);
+
+  // queued work
+  webSocket->hostReceive(request.c_str(), request.length());
+  if ((wait = SinricPro.nextWakeupMs()) != 0) return fail("received request does not wake at once", wait);
+  SinricPro.handle();
+  if ((wait = SinricPro.nextWakeupMs()) != SINRICPRO_NETWORK_POLL_INTERVAL) return fail("network poll was not restarted by handle()", wait);
+
+  // sleeping from deadline to deadline wakes for the heartbeat
+  bool heartbeat = false;
+  while (now() - connected < 2 * WEBSOCKET_PING_INTERVAL) {
+    HostClock::advanceMillis(SinricPro.nextWakeupMs());
+    SinricPro.handle();
+    if (now() - connected == WEBSOCKET_PING_INTERVAL) heartbeat = true;
+  }
+  if (!heartbeat) return fail("no wakeup for the heartbeat");
+
+  // a coalesced event pending behind the minimum time between events
+  size_t events = 0;
+  webSocket->hostOnSend([&](const char*, size_t) { events++; });
+  fleet.myThermostat->setEventCoalescing("currentTemperature");
+  fleet.myThermostat->sendTemperatureEvent(20.0f);
+  fleet.myThermostat->sendTemperatureEvent(21.0f);
+  SinricPro.handle();
+  if (events != 1 || (wait = SinricPro.nextWakeupMs()) != DROP_IN_TIME) return fail("no wakeup for the pending event", wait);
+  HostClock::advanceMillis(wait);
+  SinricPro.handle();
+  if (events != 2) return fail("pending event was not sent at its wakeup");
+  if ((wait = SinricPro.nextWakeupMs()) != SINRICPRO_NETWORK_POLL_INTERVAL) return fail("sent event still has a wakeup", wait);
+  fleet.myThermostat->setEventCoalescing("currentTemperature", false);
+
+  // reconnect attempts while disconnected
+  webSocket->hostSetAutoConnect(false);
+  webSocket->hostDisconnect();
+  SinricPro.handle();
+  if ((wait = SinricPro.nextWakeupMs()) != WEBSOCKET_RECONNECT_INTERVAL) return fail("no wakeup for the reconnect attempt", wait);
+  HostClock::advanceMillis(wait);
+  SinricPro.handle();
+  if ((wait = SinricPro.nextWakeupMs()) != WEBSOCKET_RECONNECT_INTERVAL) return fail("reconnect attempt was not repeated", wait);
+  webSocket->hostSetAutoConnect(true);
+  HostClock::advanceMillis(wait);
+  SinricPro.handle();
+  if (!SinricPro.isConnected() || (wait = SinricPro.nextWakeupMs()) != SINRICPRO_NETWORK_POLL_INTERVAL) return fail("no network poll after reconnecting", wait);
+
+  // a posted event ends the sleep
+  SinricPro.onWakeup([]() { wakeups++; });
+  events = 0;
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  if (!fleet.mySwitch->postPowerStateEvent(true)) return fail("event was not posted");
+  if (wakeups != 1 || (wait = SinricPro.nextWakeupMs()) != 0) return fail("posted event does not wake at once", wait);
+  SinricPro.handle();
+  if (events != 1) return fail("posted event was not sent");
+  SinricPro.onWakeup(nullptr);
+  webSocket->hostOnSend(nullptr);
+  return true;
+}
+
+// one simulated hour with a request every REQUEST_INTERVAL ms, arriving at the websocket between two handle() calls
+static void measure(const char* name, WebSocketsClient* webSocket, const std::string& request, bool sleep) {
+  const unsigned long duration = 3600000;
+  unsigned long start = now(), nextRequest = start + REQUEST_INTERVAL / 2;
+  unsigned long received = 0, waited = 0, responses = 0;
+  webSocket->hostOnSend([&](const char* frame, size_t length) {
+    if (std::string(frame, length).find("\"type\":\"response\"") == std::string::npos) return;
+    waited += now() - received;
+    responses++;
+  });
+  size_t calls = 0;
+  Benchmark::clock::duration inHandle = Benchmark::clock::duration::zero();
+  while (now() - start < duration) {
+    unsigned long wake = now() + (sleep ? SinricPro.nextWakeupMs() : 1);
+    while ((long) (nextRequest - wake) <= 0) {
+      HostClock::advanceMillis(nextRequest - now());
+      webSocket->hostPost(request.c_str(), request.length());
+      received = nextRequest;
+      nextRequest += REQUEST_INTERVAL;
+    }
+    HostClock::advanceMillis(wake - now());
+    Benchmark::clock::time_point callStart = Benchmark::clock::now();
+    SinricPro.handle();
+    inHandle += Benchmark::clock::now() - callStart;
+    calls++;
+  }
+  webSocket->hostOnSend(nullptr);
+
+  Benchmark benchmark(name);
+  benchmark.record(calls, inHandle);
+  char extra[128];
+  snprintf(extra, sizeof(extra), "%zu handle()/h, %.1f ms CPU/h, request wait %.0f ms", calls,
+           std::chrono::duration<double, std::milli>(inHandle).count(), responses ? (double) waited / responses : 0.0);
+  benchmark.report(extra);
+}
+
+int main() {
+  if (!checkTimers()) return 1;
+
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::string request;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) {
+      request = frame;
+      break;
+    }
+  }
+  if (request.empty()) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  if (SinricPro.nextWakeupMs() != SINRICPRO_NO_DEADLINE) return fail("deadline before begin()");
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  if (!checkDeadlines(webSocket, fleet, request)) return 1;
+
+  measure("idle hour: handle() every ms", webSocket, request, false);
+  measure("idle hour: sleep nextWakeupMs()", webSocket, request, true);
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Runs recorded websocket traffic through SinricProClass::handle(), that is
+// handleReceiveQueue() (parse, verify, dispatch, build response) and handleSendQueue() (sign, send).
+
+#include "BenchmarkFleet.h"
+
+#include <algorithm>
+
+// number of frames, starting at first, that fit into the empty receive queue;
+// SINRICPRO_QUEUE_OVERFLOW drops the frames of a burst that don't fit, QUEUE_BLOCK handles them first
+static size_t framesThatFit(const std::vector<std::string>& frames, size_t first) {
+  if (SINRICPRO_QUEUE_OVERFLOW == QUEUE_BLOCK) return frames.size() - first;
+  size_t used = 0, count = 0;
+  for (size_t i = first; i < frames.size(); i++, count++) {
+    used += (sizeof(SinricProMessage) + frames[i].length() + 1 + 3) & ~size_t(3);
+    if (used > SINRICPRO_RECEIVE_QUEUE_SIZE) break;
+  }
+  return count;
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.empty()) return 1;
+
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+
+  size_t responses = 0;
+  size_t failures = 0;
+  webSocket->hostOnSend([&](const char* payload, size_t length) {
+    (void) length;
+    responses++;
+    if (strstr(payload, "\"success\":true") == nullptr) failures++;
+  });
+
+  // sanity check: a burst larger than the receive queue loses the requests that don't fit
+  size_t fitting = framesThatFit(requests, 0);
+  for (auto& frame : requests) webSocket->hostReceive(frame.c_str(), frame.length());
+  SinricPro.handle();
+  if (responses != fitting || failures) {
+    fprintf(stderr, "Burst of %zu requests: expected %zu successful responses, %zu dropped, got %zu responses (%zu failed)\n",
+            requests.size(), fitting, requests.size() - fitting, responses, failures);
+    return 1;
+  }
+
+  // sanity check: every recorded request must be answered successfully when handle() drains between bursts
+  responses = 0;
+  size_t bursts = 0, largestBurst = 0;
+  for (size_t first = 0; first < requests.size(); first += fitting, bursts++) {
+    fitting = framesThatFit(requests, first);
+    largestBurst = std::max(largestBurst, fitting);
+    for (size_t i = first; i < first + fitting; i++) webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+    SinricPro.handle();
+  }
+  if (responses != requests.size() || failures) {
+    fprintf(stderr, "Expected %zu successful responses, got %zu (%zu failed)\n", requests.size(), responses, failures);
+    return 1;
+  }
+  printf("%zu requests answered in %zu bursts, burst of %zu dropped %zu\n", requests.size(), bursts, requests.size(), requests.size() - framesThatFit(requests, 0));
+
+  size_t index = 0;
+  Benchmark single("request -> response (one per handle)");
+  single.run(20000, [&]() {
+    const std::string& frame = requests[index++ % requests.size()];
+    webSocket->hostReceive(frame.c_str(), frame.length());
+    SinricPro.handle();
+  });
+  single.report();
+
+  // bursts as large as the receive queue holds, so nothing is dropped
+  size_t burstSize = framesThatFit(requests, 0);
+  Benchmark burst("request -> response (burst per handle)");
+  double nsPerBurst = burst.run(1000, [&]() {
+    for (size_t i = 0; i < burstSize; i++) webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+    SinricPro.handle();
+  });
+  char extra[64];
+  snprintf(extra, sizeof(extra), "(%zu requests, %.1f ns/request)", burstSize, nsPerBurst / burstSize);
+  burst.report(extra);
+
+  // events: advance the virtual clock far enough that the leaky bucket never blocks
+  HostClock::useVirtualClock(true);
+  bool state = false;
+  Benchmark event("sendPowerStateEvent -> send");
+  event.run(20000, [&]() {
+    HostClock::advanceMillis(DROP_OUT_TIME);
+    fleet.mySwitch->sendPowerStateEvent(state = !state);
+    SinricPro.handle();
+  });
+  event.report();
+  return 0;
+}
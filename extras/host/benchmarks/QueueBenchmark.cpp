@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Push / pop of messages through the fixed size SinricProQueue compared to a std::queue
+// of heap allocated copies, after checking the overflow policies, wrap around and messages
+// read in place.
+
+#include <queue>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "HostHeap.h"
+#include "SinricProQueue.h"
+
+static const char* frame = "{\"header\":{\"payloadVersion\":2,\"signatureVersion\":1},\"payload\":{\"action\":\"setPowerState\","
+                           "\"clientId\":\"portal\",\"createdAt\":1600000000,\"deviceId\":\"5dc1564130aaaaaaaa000001\","
+                           "\"replyToken\":\"aaaa-bbbb\",\"type\":\"request\",\"value\":{\"state\":\"On\"}}}";
+
+static bool fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  return false;
+}
+
+template <size_t SIZE>
+static bool popText(SinricProQueue<SIZE>& queue, const char* expected) {
+  SinricProMessage* message = queue.front();
+  if (!message || strcmp(message->getMessage(), expected) != 0 || message->getLength() != strlen(expected)) return false;
+  queue.pop();
+  return true;
+}
+
+#define TEXT_LENGTH 25
+
+// TEXT_LENGTH characters
+static const char* text(int i) {
+  static char buffer[32];
+  snprintf(buffer, sizeof(buffer), "m%d%23s", i, "");
+  return buffer;
+}
+
+// bytes a message of TEXT_LENGTH takes in a queue, computed like SinricProQueue::reserve()
+static constexpr size_t recordSize(interface_t interface) {
+  return (sizeof(SinricProMessage) + SinricProRemote::sizeFor(interface) + TEXT_LENGTH + 1 + 3) & ~(size_t) 3;
+}
+
+// room for three of these messages and not for a fourth
+#define QUEUE_OF_3(interface) SinricProQueue<3 * recordSize(interface) + 4>
+
+static bool checkPolicies() {
+  QUEUE_OF_3(IF_WEBSOCKET) newest;
+  for (int i = 0; i < 5; i++) {
+    newest.push(IF_WEBSOCKET, text(i), strlen(text(i)));
+  }
+  if (newest.size() != 3 || newest.getDropped() != 2) return fail("QUEUE_DROP_NEWEST: wrong number of messages dropped");
+  if (!popText(newest, text(0)) || !popText(newest, text(1)) || !popText(newest, text(2)) || !newest.empty()) return fail("QUEUE_DROP_NEWEST: wrong messages kept");
+
+  QUEUE_OF_3(IF_UDP) oldest;
+  oldest.setOverflowPolicy(QUEUE_DROP_OLDEST);
+  for (int i = 0; i < 5; i++) {
+    if (!oldest.push(IF_UDP, text(i), strlen(text(i)))) return fail("QUEUE_DROP_OLDEST: push failed");
+  }
+  if (oldest.size() != 3 || oldest.getDropped() != 2) return fail("QUEUE_DROP_OLDEST: wrong number of messages dropped");
+  if (oldest.front()->getInterface() != IF_UDP) return fail("QUEUE_DROP_OLDEST: interface lost");
+  if (!popText(oldest, text(2)) || !popText(oldest, text(3)) || !popText(oldest, text(4))) return fail("QUEUE_DROP_OLDEST: wrong messages kept");
+
+  QUEUE_OF_3(IF_WEBSOCKET) block;
+  int drained = 0;
+  block.setOverflowPolicy(QUEUE_BLOCK, [&]() {
+    while (!block.empty()) { block.pop(); drained++; }
+  });
+  for (int i = 0; i < 5; i++) block.push(IF_WEBSOCKET, text(i), strlen(text(i)));
+  if (drained != 3 || block.size() != 2 || block.getDropped() != 0) return fail("QUEUE_BLOCK: queue was not drained");
+
+  QUEUE_OF_3(IF_WEBSOCKET) stuck;
+  stuck.setOverflowPolicy(QUEUE_BLOCK, []() {}); // consumer can't make progress
+  for (int i = 0; i < 4; i++) stuck.push(IF_WEBSOCKET, text(i), strlen(text(i)));
+  if (stuck.size() != 3 || stuck.getDropped() != 1) return fail("QUEUE_BLOCK: message not dropped when drain did not help");
+
+  // messages of varying length wrap around the arena many times and come out unchanged and in order,
+  // some are read in place (shorter than reserved, or not at all which must leave the queue as it was)
+  SinricProQueue<1024> ring;
+  std::queue<std::string> expected;
+  char buffer[300];
+  for (int i = 0; i < 20000; i++) {
+    size_t length = 1 + (i * 37) % 250;
+    for (size_t j = 0; j < length; j++) buffer[j] = 'a' + (i + j) % 26;
+    bool pushed;
+    if (i % 4 == 1) {
+      bool readFails = i % 8 == 1;
+      pushed = ring.push(IF_WEBSOCKET, length + 7, [&](char* message, size_t capacity) {
+        if (readFails || capacity != length + 7) return (size_t) 0;
+        memcpy(message, buffer, length);
+        return length;
+      });
+      if (pushed && readFails) return fail("message was queued although reading it failed");
+    } else {
+      pushed = ring.push(IF_WEBSOCKET, buffer, length);
+    }
+    if (pushed) expected.push(std::string(buffer, length));
+    if (i % 3 != 0) {
+      while (ring.size() > 2) {
+        if (!popText(ring, expected.front().c_str())) return fail("wrap around: message corrupted");
+        expected.pop();
+      }
+    }
+  }
+  while (!ring.empty()) {
+    if (!popText(ring, expected.front().c_str())) return fail("wrap around: message corrupted");
+    expected.pop();
+  }
+  if (!expected.empty()) return fail("wrap around: messages lost");
+
+  if (ring.push(IF_WEBSOCKET, buffer, 2000) || ring.getDropped() == 0) return fail("message larger than the queue was accepted");
+  return true;
+}
+
+// the queue as it was before: one SinricProMessage object and one copy of the text on the heap per message
+struct HeapMessage {
+  HeapMessage(interface_t interface, const char* message) : interface(interface), text(strdup(message)) {}
+  ~HeapMessage() { free(text); }
+  interface_t interface;
+  char* text;
+};
+
+static void reportHeap(Benchmark& benchmark, uint64_t calls) {
+  HostHeap::Stats stats = HostHeap::stats();
+  char extra[64];
+  snprintf(extra, sizeof(extra), "%6.1f allocs/op", (double) stats.allocations / calls);
+  benchmark.report(extra);
+}
+
+int main() {
+  if (!checkPolicies()) return 1;
+
+  const uint64_t iterations = 1000000;
+  const size_t length = strlen(frame);
+  const size_t depth = 8; // messages in flight
+
+  std::queue<HeapMessage*> heapQueue;
+  Benchmark heap("std::queue + strdup: push + pop");
+  HostHeap::reset();
+  heap.run(iterations, [&]() {
+    heapQueue.push(new HeapMessage(IF_WEBSOCKET, frame));
+    if (heapQueue.size() >= depth) {
+      delete heapQueue.front();
+      heapQueue.pop();
+    }
+  });
+  reportHeap(heap, iterations + iterations / 10 + 1);
+
+  static SinricProQueue<SINRICPRO_RECEIVE_QUEUE_SIZE> ring;
+  Benchmark arena("SinricProQueue: push + pop");
+  HostHeap::reset();
+  arena.run(iterations, [&]() {
+    ring.push(IF_WEBSOCKET, frame, length);
+    if (ring.size() >= depth) ring.pop();
+  });
+  reportHeap(arena, iterations + iterations / 10 + 1);
+  if (ring.getDropped() != 0) {
+    fail("SinricProQueue dropped messages");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Event rate limits: checks bursts, refills, minimum spacing, the time until the next
+// allowed event, millis() rollover, the device / global limits and a device with more
+// actions than EVENT_LIMIT_ACTIONS_PER_DEVICE, then measures the cost of a rate limit
+// check and of a rejected sendPowerStateEvent().
+
+#define EVENT_LIMIT_DEVICE_BURST  4
+#define EVENT_LIMIT_DEVICE_REFILL 5000
+#define EVENT_LIMIT_GLOBAL_BURST  6
+#define EVENT_LIMIT_GLOBAL_REFILL 20000
+
+#include <limits.h>
+
+#include "BenchmarkFleet.h"
+#include "HostHeap.h"
+
+static bool fail(const char* what, unsigned long now) {
+  fprintf(stderr, "%s (at %lu)\n", what, now);
+  return false;
+}
+
+// the per action limit starting at `start`, which may be just before millis() rolls over
+static bool checkActionBucket(unsigned long start) {
+  SinricProTokenBucket bucket(BUCKET_SIZE, DROP_OUT_TIME, DROP_IN_TIME);
+  unsigned long now = start;
+  for (int i = 0; i < BUCKET_SIZE; i++) {
+    if (bucket.timeUntilAvailable(now) != 0) return fail("burst was limited", now);
+    bucket.take(now);
+    if (i < BUCKET_SIZE - 1 && bucket.timeUntilAvailable(now + DROP_IN_TIME - 1) != 1) return fail("events are not spaced by DROP_IN_TIME", now);
+    now += DROP_IN_TIME;
+  }
+  // the first token comes back DROP_OUT_TIME after the first event
+  unsigned long wait = bucket.timeUntilAvailable(now);
+  if (!bucket.isEmpty() || wait != DROP_OUT_TIME - BUCKET_SIZE * DROP_IN_TIME) return fail("empty bucket reports the wrong waiting time", now);
+  now += wait;
+  if (bucket.timeUntilAvailable(now) != 0) return fail("bucket was not refilled", now);
+  bucket.take(now);
+  if (bucket.timeUntilAvailable(now + DROP_IN_TIME) != DROP_OUT_TIME - DROP_IN_TIME) return fail("refill interval is wrong", now);
+  // a long break refills the whole bucket and not more
+  now += BUCKET_SIZE * 2 * DROP_OUT_TIME;
+  for (int i = 0; i < BUCKET_SIZE; i++) {
+    if (bucket.timeUntilAvailable(now) != 0) return fail("bucket was not refilled completely", now);
+    bucket.take(now);
+    now += DROP_IN_TIME;
+  }
+  if (bucket.timeUntilAvailable(now) == 0) return fail("bucket was refilled beyond its size", now);
+  return true;
+}
+
+static bool checkHierarchy(unsigned long start) {
+  SinricProEventLimiter device1, device2;
+  uint8_t power = SinricProEventLimiter::actionId("setPowerState");
+  uint8_t temperature = SinricProEventLimiter::actionId("currentTemperature");
+  if (SinricProEventLimiter::actionId("setPowerState") != power || power == temperature) return fail("action ids are not unique", start);
+
+  unsigned long now = start;
+  // the device allows 4 events in a row, no matter which action
+  for (int i = 0; i < 4; i++) {
+    if (!device1.tryTake(i % 2 ? power : temperature, now, false)) return fail("device burst was limited", now);
+    now += DROP_IN_TIME;
+  }
+  if (device1.tryTake(power, now, false)) return fail("device limit was exceeded", now);
+  if (device1.timeUntilNextEvent(power, now) != EVENT_LIMIT_DEVICE_REFILL - 4 * DROP_IN_TIME) return fail("device limit reports the wrong waiting time", now);
+  // all devices together allow 6 events in a row
+  if (!device2.tryTake(power, now, false) || !device2.tryTake(temperature, now, false)) return fail("second device was limited by the first one", now);
+  if (device2.tryTake(SinricProEventLimiter::actionId("setBrightness"), now, false)) return fail("global limit was exceeded", now);
+  if (device2.timeUntilNextEvent(SinricProEventLimiter::actionId("setBrightness"), now) != EVENT_LIMIT_GLOBAL_REFILL - 4 * DROP_IN_TIME) return fail("global limit reports the wrong waiting time", now);
+  return true;
+}
+
+// more actions than EVENT_LIMIT_ACTIONS_PER_DEVICE: every action keeps its own bucket, asking for the waiting time adds none
+static bool checkManyActions(unsigned long start) {
+  const unsigned long rest = EVENT_LIMIT_GLOBAL_BURST * EVENT_LIMIT_GLOBAL_REFILL; // refills the device and the global bucket
+  SinricProEventLimiter device;
+  std::vector<uint8_t> actions;
+  char name[32];
+  for (int i = 0; i < EVENT_LIMIT_ACTIONS_PER_DEVICE + 4; i++) {
+    snprintf(name, sizeof(name), "customAction%d", i);
+    actions.push_back(SinricProEventLimiter::actionId(name));
+  }
+
+  unsigned long now = start + rest;
+  HostHeap::reset();
+  for (auto action : actions) {
+    if (device.timeUntilNextEvent(action, now) != 0) return fail("action without events has to wait", now);
+  }
+  if (HostHeap::stats().allocations) return fail("asking for the waiting time added a bucket", now);
+
+  for (int i = 0; i < EVENT_LIMIT_ACTIONS_PER_DEVICE; i++) {
+    if (!device.tryTake(actions[i], now, false)) return fail("action was limited by another action", now);
+    now += rest;
+  }
+  // a shared bucket would keep these two DROP_IN_TIME apart
+  uint8_t first = actions[EVENT_LIMIT_ACTIONS_PER_DEVICE], second = actions[EVENT_LIMIT_ACTIONS_PER_DEVICE + 1];
+  if (!device.tryTake(first, now, false) || !device.tryTake(second, now, false)) return fail("further actions share a bucket", now);
+  if (device.timeUntilNextEvent(second, now) != DROP_IN_TIME || device.timeUntilNextEvent(actions.back(), now) != 0) return fail("further actions report the wrong waiting time", now);
+  return true;
+}
+
+int main() {
+  if (!checkActionBucket(0) || !checkActionBucket(123456) || !checkActionBucket(ULONG_MAX - 2500)) return 1;
+  if (!checkHierarchy(ULONG_MAX - 3000)) return 1;
+  if (!checkManyActions(ULONG_MAX - 3000)) return 1;
+
+  const uint64_t iterations = 1000000;
+  SinricProEventLimiter limiter;
+  uint8_t actionId = SinricProEventLimiter::actionId("setPowerState");
+  unsigned long now = 0;
+  Benchmark check("tryTake: allowed");
+  HostHeap::reset();
+  check.run(iterations, [&]() {
+    now += DROP_OUT_TIME;
+    limiter.tryTake(actionId, now, false);
+  });
+  HostHeap::Stats stats = HostHeap::stats();
+  char extra[64];
+  snprintf(extra, sizeof(extra), "%6.1f allocs/op", (double) stats.allocations / iterations);
+  check.report(extra);
+
+  Benchmark blocked("tryTake: blocked");
+  blocked.run(iterations, [&]() { limiter.tryTake(actionId, now, false); });
+  blocked.report();
+
+  // events of 32 devices, all rejected by the global limit
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  if (traffic.empty()) return 1;
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  std::vector<SinricProSwitch*> switches;
+  char deviceId[32];
+  for (int i = 0; i < 32; i++) {
+    snprintf(deviceId, sizeof(deviceId), "5dc1564130aaaaaaaa%06x", i);
+    SinricProSwitch& mySwitch = SinricPro[deviceId];
+    switches.push_back(&mySwitch);
+  }
+  if (!fleet.connect(traffic)) return 1;
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  size_t index = 0;
+  Benchmark rejected("sendPowerStateEvent: rejected");
+  rejected.run(iterations / 10, [&]() { switches[index++ % switches.size()]->sendPowerStateEvent(true); });
+  rejected.report();
+  return 0;
+}
@@ -0,0 +1,240 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SINRICPRO_CAPTURE on: records a restoreDeviceStates storm (a setPowerState request for
+// each of 40 devices, 250 us apart, plus one UDP request) through the websocket and UDP
+// listeners, checks the capture, then replays it as fast as possible and at its original
+// speed with throughput and request -> response latency percentiles.
+//
+//   ReplayBenchmark [capture]   replays a capture written by SinricPro.getCapture() instead,
+//                               its requests must be signed with BENCHMARK_APP_SECRET
+
+#define SINRICPRO_CAPTURE
+
+#include <SinricPro.h>
+#include <SinricProSwitch.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "Benchmark.h"
+#include "HostClock.h"
+#include "WiFiUdp.h"
+
+#define STORM_DEVICES       40
+#define STORM_SPACING_MICROS 250
+
+// capture written into memory
+class CaptureBuffer : public Print {
+  public:
+    size_t write(uint8_t c) override { data.push_back(c); return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { data.insert(data.end(), buffer, buffer + size); return size; }
+    using Print::write;
+    std::vector<uint8_t> data;
+};
+
+static std::string replyToken(const char* frame, size_t length) {
+  std::string text(frame, length);
+  size_t start = text.find("\"replyToken\":\"");
+  if (start == std::string::npos) return "";
+  start += 14;
+  return text.substr(start, text.find('"', start) - start);
+}
+
+static std::string deviceId(int index) {
+  char id[DEVICEID_STRLEN + 1];
+  snprintf(id, sizeof(id), "5dc1564130bbbbbbbbbbbb%02x", index);
+  return id;
+}
+
+static std::string signedRequest(const std::string& deviceId, int index) {
+  DynamicJsonDocument request(1024);
+  request["header"]["payloadVersion"] = 2;
+  request["header"]["signatureVersion"] = 1;
+  JsonObject payload = request.createNestedObject("payload");
+  payload["action"] = "setPowerState";
+  payload["clientId"] = "sinricpro-restore";
+  payload["createdAt"] = 1600000000 + index;
+  payload.createNestedArray("deviceAttributes");
+  payload["deviceId"] = deviceId.c_str();
+  char token[MESSAGEID_STRLEN + 1];
+  snprintf(token, sizeof(token), "00000000-0000-4000-8000-%012x", index);
+  payload["replyToken"] = token;
+  payload["type"] = "request";
+  payload["value"]["state"] = index % 2 ? "On" : "Off";
+  String frame = signMessage(BENCHMARK_APP_SECRET, request);
+  return std::string(frame.c_str(), frame.length());
+}
+
+static void deliver(const SinricProCaptureRecord& record) {
+  if (record.interface == IF_UDP) {
+    WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, record.payload, record.length);
+  } else {
+    WebSocketsClient::hostInstance()->hostReceive((const char*) record.payload, record.length);
+  }
+}
+
+// the storm through the listeners into the capture, on the virtual clock
+static std::vector<std::string> recordStorm(CaptureBuffer& capture) {
+  std::vector<std::string> frames;
+  HostClock::useVirtualClock(true);
+  SinricPro.getCapture().begin(capture);
+  for (int i = 0; i < STORM_DEVICES; i++) {
+    frames.push_back(signedRequest(deviceId(i), i));
+    HostClock::advanceMicros(STORM_SPACING_MICROS);
+    WebSocketsClient::hostInstance()->hostReceive(frames.back().c_str(), frames.back().length());
+    SinricPro.handle();
+  }
+  frames.push_back(signedRequest(deviceId(0), STORM_DEVICES));
+  HostClock::advanceMicros(STORM_SPACING_MICROS);
+  WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t*) frames.back().c_str(), frames.back().length());
+  SinricPro.handle();
+  SinricPro.getCapture().end();
+  HostClock::useVirtualClock(false);
+  return frames;
+}
+
+static bool checkCapture(const CaptureBuffer& capture, const std::vector<std::string>& frames) {
+  SinricProCaptureReader reader(capture.data.data(), capture.data.size());
+  SinricProCaptureRecord record;
+  size_t count = 0;
+  while (reader.next(record)) {
+    if (count >= frames.size()) break;
+    interface_t interface = count < STORM_DEVICES ? IF_WEBSOCKET : IF_UDP;
+    if (record.time != (count + 1) * STORM_SPACING_MICROS || record.interface != interface ||
+        frames[count].compare(0, std::string::npos, (const char*) record.payload, record.length)) {
+      fprintf(stderr, "frame %zu was captured wrong\n", count);
+      return false;
+    }
+    count++;
+  }
+  if (!reader.isValid() || count != frames.size() || SinricPro.getCapture().records() != frames.size()) {
+    fprintf(stderr, "%zu of %zu frames captured\n", count, frames.size());
+    return false;
+  }
+  printf("capture: %zu frames, %zu bytes (%zu bytes of frames)\n", count, capture.data.size(), [&]() {
+    size_t bytes = 0;
+    for (auto& frame : frames) bytes += frame.length();
+    return bytes;
+  }());
+  return true;
+}
+
+class Replay {
+  public:
+    explicit Replay(const std::vector<uint8_t>& capture) : _capture(capture) {
+      auto onSend = [this](const char* payload, size_t length) {
+        auto pending = _pending.find(replyToken(payload, length));
+        if (pending == _pending.end()) return;
+        _latencies.push_back(std::chrono::duration<double, std::micro>(Benchmark::clock::now() - pending->second).count());
+        _pending.erase(pending);
+      };
+      WebSocketsClient::hostInstance()->hostOnSend(onSend);
+      WiFiUDP::hostOnSend([onSend](IPAddress, uint16_t, const uint8_t* data, size_t length) { onSend((const char*) data, length); });
+    }
+
+    // every frame right after the previous one has been handled
+    bool fast(const char* name, size_t rounds) {
+      _latencies.clear();
+      _pending.clear();
+      size_t requests = 0;
+      Benchmark::clock::time_point start = Benchmark::clock::now();
+      for (size_t round = 0; round < rounds; round++) {
+        SinricProCaptureReader reader(_capture.data(), _capture.size());
+        SinricProCaptureRecord record;
+        while (reader.next(record)) {
+          requests += expect(record, Benchmark::clock::now());
+          deliver(record);
+          SinricPro.handle();
+        }
+      }
+      return report(name, requests, Benchmark::clock::now() - start);
+    }
+
+    // every frame at its captured time, SinricPro.handle() is called in a tight loop meanwhile
+    bool originalSpeed(const char* name) {
+      _latencies.clear();
+      _pending.clear();
+      size_t requests = 0;
+      SinricProCaptureReader reader(_capture.data(), _capture.size());
+      SinricProCaptureRecord record;
+      Benchmark::clock::time_point start = Benchmark::clock::now();
+      while (reader.next(record)) {
+        Benchmark::clock::time_point due = start + std::chrono::microseconds(record.time);
+        while (Benchmark::clock::now() < due) SinricPro.handle();
+        requests += expect(record, due);
+        deliver(record);
+      }
+      while (!_pending.empty() && Benchmark::clock::now() - start < std::chrono::seconds(1) + std::chrono::microseconds(record.time)) SinricPro.handle();
+      return report(name, requests, Benchmark::clock::now() - start);
+    }
+
+  private:
+    size_t expect(const SinricProCaptureRecord& record, Benchmark::clock::time_point received) {
+      std::string token = replyToken((const char*) record.payload, record.length);
+      if (token.empty()) return 0;
+      _pending[token] = received;
+      return 1;
+    }
+
+    bool report(const char* name, size_t requests, Benchmark::clock::duration elapsed) {
+      Benchmark benchmark(name);
+      benchmark.record(requests, elapsed);
+      std::sort(_latencies.begin(), _latencies.end());
+      auto percentile = [this](size_t percent) { return _latencies.empty() ? 0 : _latencies[(_latencies.size() - 1) * percent / 100]; };
+      char extra[128];
+      snprintf(extra, sizeof(extra), "latency p50 %.1f p90 %.1f p99 %.1f max %.1f us, %zu unanswered", percentile(50), percentile(90), percentile(99),
+               percentile(100), _pending.size());
+      benchmark.report(extra);
+      return _latencies.size() == requests;
+    }
+
+    const std::vector<uint8_t>& _capture;
+    std::map<std::string, Benchmark::clock::time_point> _pending;
+    std::vector<double> _latencies;
+};
+
+int main(int argc, char** argv) {
+  for (int i = 0; i < STORM_DEVICES; i++) {
+    SinricProSwitch& device = SinricPro[deviceId(i).c_str()];
+    device.onPowerState([](const String&, bool&) { return true; });
+  }
+  SinricPro.restoreDeviceStates(true);
+  SinricPro.begin(BENCHMARK_APP_KEY, BENCHMARK_APP_SECRET);
+  SinricPro.handle();
+  WebSocketsClient* webSocket = WebSocketsClient::hostInstance();
+  if (!webSocket || !SinricPro.isConnected()) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  webSocket->hostReceive("{\"timestamp\":1600000000}");
+  SinricPro.handle();
+
+  CaptureBuffer capture;
+  std::vector<std::string> frames = recordStorm(capture);
+  if (!checkCapture(capture, frames)) return 1;
+
+  if (argc > 1) {
+    std::ifstream file(argv[1], std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!SinricProCaptureReader(data.data(), data.size()).isValid()) {
+      fprintf(stderr, "\"%s\" is not a capture\n", argv[1]);
+      return 1;
+    }
+    Replay replay(data);
+    replay.fast("replay: as fast as possible", 100);
+    replay.originalSpeed("replay: original speed");
+    return 0;
+  }
+
+  Replay replay(capture.data);
+  bool answered = replay.fast("storm replay: as fast as possible", 500);
+  answered &= replay.originalSpeed("storm replay: original speed");
+  if (!answered) fprintf(stderr, "not every request of the storm was answered\n");
+  return answered ? 0 : 1;
+}
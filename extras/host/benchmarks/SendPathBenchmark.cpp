@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Heap allocations and time spent per outgoing message, split into the stage that
+// builds and queues the message and the stage that stamps, signs and sends it.
+
+#include "BenchmarkFleet.h"
+#include "HostHeap.h"
+
+static void reportHeap(Benchmark& benchmark, const HostHeap::Stats& stats, uint64_t calls, size_t peak = 0) {
+  char extra[128];
+  int length = snprintf(extra, sizeof(extra), "%6.1f allocs/op %8.1f bytes/op", (double) stats.allocations / calls, (double) stats.bytes / calls);
+  if (peak) snprintf(extra + length, sizeof(extra) - length, " %8zu bytes peak", peak);
+  benchmark.report(extra);
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.empty()) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+
+  std::string sent;
+  webSocket->hostOnSend([&](const char* payload, size_t length) { sent.assign(payload, length); });
+
+  // sanity check: an event leaves stamped with the current time and correctly signed
+  HostClock::advanceMillis(DROP_OUT_TIME);
+  fleet.mySwitch->sendPowerStateEvent(true);
+  SinricPro.handle();
+  DynamicJsonDocument event(1024);
+  deserializeJson(event, sent.c_str());
+  unsigned long createdAt = event["payload"]["createdAt"] | 0;
+  if (createdAt != SinricPro.getTimestamp() || !verifyMessage(BENCHMARK_APP_SECRET, event)) {
+    fprintf(stderr, "Event is not stamped or signed correctly:\n%s\n", sent.c_str());
+    return 1;
+  }
+
+  // the event lane of the send queue has a fixed size: sendPowerStateEvent() reports when it is full
+  bool state = false;
+  size_t sentEvents = 0;
+  webSocket->hostOnSend([&](const char*, size_t) { sentEvents++; });
+  uint64_t batchSize = 0;
+  bool dropped = false;
+  while (batchSize < SINRICPRO_SEND_QUEUE_EVENT_SIZE) { // more than fit, unless QUEUE_BLOCK sends them
+    HostClock::advanceMillis(DROP_OUT_TIME); // keeps the leaky bucket from dropping events
+    if ((dropped = !fleet.mySwitch->sendPowerStateEvent(state = !state))) break;
+    batchSize++;
+  }
+  SinricPro.handle();
+  if (batchSize == 0 || sentEvents != batchSize) {
+    fprintf(stderr, "Full event lane: %llu events queued, %zu sent\n", (unsigned long long) batchSize, sentEvents);
+    return 1;
+  }
+  // the dropped event did not count against the rate limits, so it can be sent again right away
+  if (dropped && !fleet.mySwitch->sendPowerStateEvent(state)) {
+    fprintf(stderr, "Event dropped by the full send queue used up a rate limit token\n");
+    return 1;
+  }
+  SinricPro.handle();
+
+  // so events are queued and flushed in batches
+  const uint64_t batches = 20000 / batchSize;
+  const uint64_t events = batches * batchSize;
+  sentEvents = 0;
+
+  Benchmark queue("event: build + queue");
+  Benchmark flush("event: stamp + sign + send");
+  Benchmark::clock::duration queueTime(0), flushTime(0);
+  HostHeap::Stats queueHeap = {0, 0, 0}, flushHeap = {0, 0, 0};
+  for (uint64_t batch = 0; batch < batches; batch++) {
+    HostHeap::reset();
+    Benchmark::clock::time_point start = Benchmark::clock::now();
+    for (uint64_t i = 0; i < batchSize; i++) {
+      HostClock::advanceMillis(DROP_OUT_TIME); // keeps the leaky bucket from dropping events
+      fleet.mySwitch->sendPowerStateEvent(state = !state);
+    }
+    queueTime += Benchmark::clock::now() - start;
+    HostHeap::Stats stats = HostHeap::stats();
+    queueHeap.allocations += stats.allocations;
+    queueHeap.bytes += stats.bytes;
+
+    HostHeap::reset();
+    start = Benchmark::clock::now();
+    SinricPro.handle();
+    flushTime += Benchmark::clock::now() - start;
+    stats = HostHeap::stats();
+    flushHeap.allocations += stats.allocations;
+    flushHeap.bytes += stats.bytes;
+  }
+  queue.record(events, queueTime);
+  reportHeap(queue, queueHeap, events);
+  flush.record(events, flushTime);
+  reportHeap(flush, flushHeap, events);
+  if (sentEvents != events) {
+    fprintf(stderr, "Expected %llu events to be sent, got %zu\n", (unsigned long long) events, sentEvents);
+    return 1;
+  }
+
+  size_t index = 0;
+  // peak is the heap used on top of what is allocated once connected
+  Benchmark response("request -> response");
+  size_t connectedHeap = HostHeap::liveBytes();
+  HostHeap::reset();
+  response.run(20000, [&]() {
+    const std::string& frame = requests[index++ % requests.size()];
+    webSocket->hostReceive(frame.c_str(), frame.length());
+    SinricPro.handle();
+  });
+  reportHeap(response, HostHeap::stats(), 20000 + 20000 / 10 + 1, HostHeap::peakBytes() - connectedHeap); // run() includes the warm up calls
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Send queue lanes: the order of SinricProPriorityQueue with and without starvation guard,
+// then end to end with a backlog of PERIODIC_POLL temperature events and two interaction
+// events queued: a request's response is sent ahead of the backlog, and the telemetry lane
+// still gets its turn while a burst of requests is answered. Reports the time from receiving
+// a request to sending its response behind the backlog.
+
+// room for a telemetry backlog
+#define SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE 16384
+
+#include "BenchmarkFleet.h"
+#include "HostClock.h"
+
+#define BACKLOG 20
+#define BURST   10  // requests fitting into the receive queue at once
+
+static bool fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  return false;
+}
+
+static std::string popOrder(SinricProPriorityQueue<1024, 1024, 1024>& queue) {
+  std::string order;
+  while (SinricProMessage* message = queue.front()) {
+    order += message->getMessage();
+    queue.pop();
+  }
+  return order;
+}
+
+static bool checkLanes() {
+  SinricProPriorityQueue<1024, 1024, 1024> queue;
+  auto fill = [&queue]() {
+    for (int i = 0; i < 3; i++) queue.push(PRIORITY_TELEMETRY, IF_WEBSOCKET, "T", 1);
+    for (int i = 0; i < 2; i++) queue.push(PRIORITY_EVENT, IF_WEBSOCKET, "E", 1);
+    for (int i = 0; i < 6; i++) queue.push(PRIORITY_RESPONSE, IF_WEBSOCKET, "R", 1);
+  };
+  queue.setStarvationLimit(0);
+  fill();
+  if (popOrder(queue) != "RRRRRREETTT") return fail("lanes are not popped by priority");
+  queue.setStarvationLimit(2);
+  fill();
+  if (popOrder(queue) != "RRETRETRRTR") return fail("starvation guard did not serve the waiting lanes");
+  return queue.empty();
+}
+
+// queue the backlog, on the virtual clock so no event is rate limited
+static void queueBacklog(BenchmarkFleet& fleet) {
+  for (int i = 0; i < BACKLOG; i++) {
+    HostClock::advanceMillis(DROP_OUT_TIME);
+    fleet.myThermostat->sendTemperatureEvent(20.0f + i);
+  }
+  for (int i = 0; i < 2; i++) {
+    HostClock::advanceMillis(DROP_OUT_TIME);
+    fleet.myLight->sendPowerStateEvent(i % 2);
+  }
+}
+
+static bool checkEndToEnd(WebSocketsClient* webSocket, BenchmarkFleet& fleet, const std::vector<std::string>& requests) {
+  std::string order;
+  webSocket->hostOnSend([&](const char* frame, size_t length) {
+    std::string text(frame, length);
+    if (text.find("\"type\":\"response\"") != std::string::npos) order += 'R';
+    else if (text.find("PERIODIC_POLL") != std::string::npos) order += 'T';
+    else order += 'E';
+  });
+
+  // a response is sent ahead of the backlog: at most one message of the send lane goes before the request is received
+  queueBacklog(fleet);
+  webSocket->hostReceive(requests[0].c_str(), requests[0].length());
+  SinricPro.handle();
+  if (order.length() != BACKLOG + 3 || order.find('R') > 1) return fail("response waited behind the backlog");
+  if (order.find('T') < order.rfind('E')) return fail("telemetry was sent ahead of interaction events");
+
+  // a burst of requests doesn't starve the telemetry lane
+  order.clear();
+  queueBacklog(fleet);
+  for (size_t i = 0; i < BURST; i++) webSocket->hostReceive(requests[i].c_str(), requests[i].length());
+  SinricPro.handle();
+  if (order.length() != BACKLOG + 2 + BURST) return fail("not every message was sent");
+  if (order.find('T') > SINRICPRO_SEND_STARVATION_LIMIT + 1) return fail("telemetry lane starved behind the responses");
+  printf("burst of %d requests behind %d telemetry events: %s\n", BURST, BACKLOG, order.c_str());
+
+  webSocket->hostOnSend(nullptr);
+  return true;
+}
+
+static void measure(WebSocketsClient* webSocket, BenchmarkFleet& fleet, const std::vector<std::string>& requests) {
+  const size_t rounds = 2000;
+  Benchmark::clock::time_point received;
+  Benchmark::clock::duration latency = Benchmark::clock::duration::zero();
+  webSocket->hostOnSend([&](const char* frame, size_t length) {
+    if (std::string(frame, length).find("\"type\":\"response\"") != std::string::npos) latency += Benchmark::clock::now() - received;
+  });
+  for (size_t round = 0; round < rounds; round++) {
+    queueBacklog(fleet);
+    const std::string& request = requests[round % requests.size()];
+    webSocket->hostReceive(request.c_str(), request.length());
+    received = Benchmark::clock::now();
+    SinricPro.handle();
+  }
+  Benchmark benchmark("response behind telemetry backlog");
+  benchmark.record(rounds, latency);
+  char extra[64];
+  snprintf(extra, sizeof(extra), "%d events queued ahead", BACKLOG + 2);
+  benchmark.report(extra);
+  webSocket->hostOnSend(nullptr);
+}
+
+int main() {
+  if (!checkLanes()) return 1;
+
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.size() < BURST) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  WebSocketsClient* webSocket = fleet.connect(traffic);
+  if (!webSocket) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  if (!checkEndToEnd(webSocket, fleet, requests)) return 1;
+  measure(webSocket, fleet, requests);
+  return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// SHA256 / SHA256HMAC known answers (FIPS 180-2, RFC 4231) followed by throughput of the
+// SHA256 kernel in cycles per byte for aligned and unaligned input.
+
+#include <Arduino.h>
+#include "extralib/Crypto/Crypto.h"
+
+#include "Benchmark.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t cycles() { return __rdtsc(); }
+#else
+static uint64_t cycles() { return 0; }
+#endif
+
+static String toHex(const byte* data, size_t length) {
+  String result;
+  char hex[3];
+  for (size_t i = 0; i < length; i++) {
+    sprintf(hex, "%02x", data[i]);
+    result += hex;
+  }
+  return result;
+}
+
+static bool expect(const char* name, const byte* digest, const char* expected) {
+  String actual = toHex(digest, SHA256_SIZE);
+  if (actual == expected) return true;
+  fprintf(stderr, "%s: expected %s, got %s\n", name, expected, actual.c_str());
+  return false;
+}
+
+// hashes message split into chunks of chunkSize bytes, starting at an odd address
+static void sha256(const char* message, size_t length, size_t chunkSize, byte* digest) {
+  std::vector<byte> unaligned(length + 1);
+  memcpy(unaligned.data() + 1, message, length);
+  SHA256 hash;
+  for (size_t offset = 0; offset < length; offset += chunkSize) {
+    hash.doUpdate(unaligned.data() + 1 + offset, std::min(chunkSize, length - offset));
+  }
+  hash.doFinal(digest);
+}
+
+static bool knownAnswers() {
+  struct { const char* message; const char* digest; } shaVectors[] = {
+    { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+    { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+    { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1" },
+  };
+  bool success = true;
+  byte digest[SHA256_SIZE];
+  for (auto& vector : shaVectors) {
+    size_t length = strlen(vector.message);
+    SHA256 hash;
+    hash.doUpdate(vector.message, length);
+    hash.doFinal(digest);
+    success &= expect(vector.message, digest, vector.digest);
+    for (size_t chunkSize : { 1, 3, 63, 64, 65 }) {
+      sha256(vector.message, length, chunkSize, digest);
+      success &= expect(vector.message, digest, vector.digest);
+    }
+  }
+
+  std::string million(1000000, 'a');
+  sha256(million.data(), million.size(), 4096, digest);
+  success &= expect("1,000,000 x 'a'", digest, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+  // RFC 4231 test cases 2, 6 and 7 (key shorter and longer than one block)
+  std::string longKey(131, '\xaa');
+  struct { std::string key; const char* message; const char* digest; } hmacVectors[] = {
+    { "Jefe", "what do ya want for nothing?", "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843" },
+    { longKey, "Test Using Larger Than Block-Size Key - Hash Key First", "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54" },
+    { longKey, "This is a test using a larger than block-size key and a larger than block-size data. The key needs to be hashed before being used by the HMAC algorithm.", "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2" },
+  };
+  for (auto& vector : hmacVectors) {
+    SHA256HMAC keyed((const byte*) vector.key.data(), vector.key.size());
+    SHA256HMAC hmac(keyed);
+    hmac.doUpdate(vector.message);
+    hmac.doFinal(digest);
+    success &= expect(vector.message, digest, vector.digest);
+  }
+  return success;
+}
+
+static void throughput(const char* name, const byte* data, size_t length, uint64_t iterations) {
+  byte digest[SHA256_SIZE];
+  Benchmark benchmark(name);
+  uint64_t start = cycles();
+  double ns = benchmark.run(iterations, [&]() {
+    SHA256 hash;
+    hash.doUpdate(data, length);
+    hash.doFinal(digest);
+  });
+  double cyclesPerOp = (double) (cycles() - start) / (iterations + iterations / 10 + 1);
+  char extra[96];
+  if (cyclesPerOp) {
+    snprintf(extra, sizeof(extra), "%6.2f ns/byte %6.2f cycles/byte", ns / length, cyclesPerOp / length);
+  } else {
+    snprintf(extra, sizeof(extra), "%6.2f ns/byte", ns / length);
+  }
+  benchmark.report(extra);
+}
+
+int main() {
+  if (!knownAnswers()) return 1;
+
+  std::vector<uint32_t> words(4096 / 4 + 1);
+  byte* aligned = (byte*) words.data();
+  for (size_t i = 0; i < 4096 + 4; i++) aligned[i] = (byte) random(256);
+
+  throughput("sha256: 64 bytes aligned", aligned, 64, 200000);
+  throughput("sha256: 256 bytes aligned", aligned, 256, 100000);
+  throughput("sha256: 4096 bytes aligned", aligned, 4096, 10000);
+  throughput("sha256: 4096 bytes unaligned", aligned + 1, 4096, 10000);
+  return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Signatures per second with the app secret hashed for every message (key formatted from
+// AppSecret and HMAC keyed per call) versus a SHA256HMAC keyed once and copied per message.
+
+#include <SinricPro.h>
+
+#include "Benchmark.h"
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.empty()) return 1;
+
+  AppSecret appSecret(BENCHMARK_APP_SECRET);
+  String key = appSecret.toString();
+  SHA256HMAC keyedHmac((byte*) key.c_str(), key.length());
+
+  DynamicJsonDocument request(1024);
+  deserializeJson(request, requests[0].c_str());
+  String payload;
+  serializeJson(request["payload"], payload);
+
+  // sanity check: both ways produce the recorded signature
+  char perMessage[SIGNATURE_LENGTH+1];
+  char cached[SIGNATURE_LENGTH+1];
+  calculateSignature(key.c_str(), payload.c_str(), payload.length(), perMessage);
+  calculateSignature(keyedHmac, payload.c_str(), payload.length(), cached);
+  const char* recorded = request["signature"]["HMAC"];
+  if (!recorded || strcmp(perMessage, recorded) || strcmp(cached, recorded)) {
+    fprintf(stderr, "Signature mismatch: recorded %s, per message %s, cached %s\n", recorded ? recorded : "-", perMessage, cached);
+    return 1;
+  }
+
+  char extra[64];
+  snprintf(extra, sizeof(extra), "(%u byte payload)", payload.length());
+
+  Benchmark sign("sign: key per message");
+  sign.run(100000, [&]() {
+    String secret = appSecret.toString();
+    calculateSignature(secret.c_str(), payload.c_str(), payload.length(), perMessage);
+  });
+  sign.report(extra);
+
+  Benchmark signCached("sign: cached key");
+  signCached.run(100000, [&]() {
+    calculateSignature(keyedHmac, payload.c_str(), payload.length(), cached);
+  });
+  signCached.report(extra);
+
+  bool valid = true;
+  Benchmark verify("verify: key per message");
+  verify.run(100000, [&]() { valid &= verifyMessage(appSecret.toString(), request); });
+  verify.report(extra);
+
+  Benchmark verifyCached("verify: cached key");
+  verifyCached.run(100000, [&]() { valid &= verifyMessage(keyedHmac, request); });
+  verifyCached.report(extra);
+
+  if (!valid) {
+    fprintf(stderr, "Recorded request failed verification\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_SERVER_H_
+#define _SINRICPRO_SERVER_H_
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <SinricPro.h>
+#include <WiFiUdp.h>
+
+// createdAt of a response or event may differ this much from the server's clock
+#define SERVER_CLOCK_TOLERANCE 5
+
+/**
+ * @brief Local stand-in for the SinricPro server
+ *
+ * Speaks the protocol of ws.sinric.pro to the host build of the library. It is attached to the
+ * `WebSocketsClient` and `WiFiUDP` stand-ins instead of real sockets, so frames take the same
+ * path through the library as on a board. The server
+ * - checks the `appkey` and `deviceids` headers of the connection and sends the `{"timestamp":…}` message
+ * - sends requests signed with the app secret over websocket or UDP
+ * - validates responses (signature, type, replyToken, deviceId, createdAt) and events (signature, type, deviceId, action, cause)
+ * - measures request -> response latency
+ **/
+class SinricProServer {
+  public:
+    typedef std::chrono::steady_clock clock;
+
+    struct Stats {
+      uint32_t requests;
+      uint32_t responses;   // valid responses
+      uint32_t events;      // valid events
+      uint32_t invalid;     // responses and events rejected by validation
+      uint32_t failed;      // valid responses with success=false
+    };
+
+    SinricProServer(const char *appKey, const char *appSecret);
+    ~SinricProServer();
+
+    bool accept();
+    const std::vector<std::string> &deviceIds() const { return _deviceIds; }
+
+    std::string sendRequest(const std::string &deviceId, const char *action, const char *value, interface_t interface = IF_WEBSOCKET);
+    void receive(const char *frame, size_t length, interface_t interface);
+
+    size_t pending() const { return _pending.size(); }
+    const Stats &stats() const { return _stats; }
+    const std::vector<double> &latencies() const { return _latencies; }
+    const std::string &lastError() const { return _lastError; }
+    void resetStats();
+
+  private:
+    struct PendingRequest {
+      std::string deviceId;
+      interface_t interface;
+      clock::time_point sent;
+    };
+
+    bool fail(const char *error);
+    bool reject(const char *error, const char *frame, size_t length);
+    static unsigned long unixTime();
+
+    std::string _appKey;
+    String _appSecret;
+    std::vector<std::string> _deviceIds;
+    std::map<std::string, PendingRequest> _pending;
+    std::vector<double> _latencies;
+    Stats _stats;
+    uint64_t _nextToken;
+    std::string _lastError;
+};
+
+SinricProServer::SinricProServer(const char *appKey, const char *appSecret) : _appKey(appKey), _appSecret(appSecret), _nextToken(1) {
+  resetStats();
+}
+
+SinricProServer::~SinricProServer() {
+  WebSocketsClient *webSocket = WebSocketsClient::hostInstance();
+  if (webSocket) webSocket->hostOnSend(nullptr);
+  WiFiUDP::hostOnSend(nullptr);
+}
+
+unsigned long SinricProServer::unixTime() {
+  return (unsigned long) time(nullptr);
+}
+
+/**
+ * @brief Accept the connection of the client which called `SinricPro.begin()`
+ * @return false if the client isn't connected or sent a wrong app key / no device ids
+ **/
+bool SinricProServer::accept() {
+  WebSocketsClient *webSocket = WebSocketsClient::hostInstance();
+  if (!webSocket || !webSocket->isConnected()) return fail("client is not connected");
+
+  // headers are "name:value" lines
+  std::string headers = webSocket->hostExtraHeaders().c_str();
+  auto header = [&headers](const char *name) {
+    std::string key = std::string(name) + ":";
+    size_t start = headers.find(key);
+    if (start == std::string::npos) return std::string();
+    start += key.length();
+    return headers.substr(start, headers.find("\r\n", start) - start);
+  };
+  if (header("appkey") != _appKey) return fail("wrong appkey header");
+  std::string deviceIds = header("deviceids");
+  _deviceIds.clear();
+  for (size_t start = 0; start < deviceIds.length();) {
+    size_t end = deviceIds.find(';', start);
+    if (end == std::string::npos) end = deviceIds.length();
+    _deviceIds.push_back(deviceIds.substr(start, end - start));
+    start = end + 1;
+  }
+  if (_deviceIds.empty()) return fail("no deviceids header");
+
+  webSocket->hostOnSend([this](const char *frame, size_t length) { receive(frame, length, IF_WEBSOCKET); });
+  WiFiUDP::hostOnSend([this](IPAddress, uint16_t, const uint8_t *data, size_t length) { receive((const char *) data, length, IF_UDP); });
+  char timestamp[32];
+  snprintf(timestamp, sizeof(timestamp), "{\"timestamp\":%lu}", unixTime());
+  webSocket->hostReceive(timestamp);
+  return true;
+}
+
+/**
+ * @brief Send a signed request
+ * @param value JSON object with the request's value, e.g. `{"state":"On"}`
+ * @return the request's replyToken
+ **/
+std::string SinricProServer::sendRequest(const std::string &deviceId, const char *action, const char *value, interface_t interface) {
+  char replyToken[MESSAGEID_STRLEN + 1];
+  snprintf(replyToken, sizeof(replyToken), "00000000-0000-4000-8000-%012llx", (unsigned long long) _nextToken++);
+
+  DynamicJsonDocument valueDocument(512);
+  deserializeJson(valueDocument, value);
+  DynamicJsonDocument request(1024);
+  request["header"]["payloadVersion"] = 2;
+  request["header"]["signatureVersion"] = 1;
+  JsonObject payload = request.createNestedObject("payload");
+  payload["action"] = action;
+  payload["clientId"] = "sinricpro-local-server";
+  payload["createdAt"] = unixTime();
+  payload.createNestedArray("deviceAttributes");
+  payload["deviceId"] = deviceId.c_str();
+  payload["replyToken"] = replyToken;
+  payload["type"] = "request";
+  payload["value"] = valueDocument.as<JsonObject>();
+  String frame = signMessage(_appSecret, request);
+
+  _pending[replyToken] = PendingRequest { deviceId, interface, clock::now() };
+  _stats.requests++;
+  if (interface == IF_UDP) {
+    WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t *) frame.c_str(), frame.length());
+  } else {
+    WebSocketsClient::hostInstance()->hostReceive(frame.c_str(), frame.length());
+  }
+  return replyToken;
+}
+
+bool SinricProServer::fail(const char *error) {
+  _lastError = error;
+  return false;
+}
+
+bool SinricProServer::reject(const char *error, const char *frame, size_t length) {
+  _stats.invalid++;
+  _lastError = std::string(error) + ": " + std::string(frame, length);
+  return false;
+}
+
+/**
+ * @brief Validate a message sent by the client, called for every websocket and UDP frame the client sends
+ **/
+void SinricProServer::receive(const char *frame, size_t length, interface_t interface) {
+  clock::time_point received = clock::now();
+  DynamicJsonDocument message(2048);
+  if (deserializeJson(message, frame, length)) { reject("no JSON", frame, length); return; }
+  if (!verifyMessage(_appSecret, message)) { reject("wrong signature", frame, length); return; }
+  if ((message["header"]["payloadVersion"] | 0) != 2 || (message["header"]["signatureVersion"] | 0) != 1) { reject("wrong header", frame, length); return; }
+
+  JsonObject payload = message["payload"];
+  long createdAt = payload["createdAt"] | 0L;
+  if (labs(createdAt - (long) unixTime()) > SERVER_CLOCK_TOLERANCE) { reject("wrong createdAt", frame, length); return; }
+  const char *type = payload["type"] | "";
+  const char *replyToken = payload["replyToken"] | "";
+  const char *deviceId = payload["deviceId"] | "";
+
+  if (strcmp(type, "response") == 0) {
+    auto request = _pending.find(replyToken);
+    if (request == _pending.end()) { reject("response to an unknown request", frame, length); return; }
+    if (request->second.deviceId != deviceId || request->second.interface != interface) { reject("response from the wrong device or interface", frame, length); return; }
+    if (!payload["success"].is<bool>() || !payload["value"].is<JsonObject>()) { reject("response without success or value", frame, length); return; }
+    if (!(payload["success"] | false)) _stats.failed++;
+    _latencies.push_back(std::chrono::duration<double, std::micro>(received - request->second.sent).count());
+    _pending.erase(request);
+    _stats.responses++;
+    return;
+  }
+
+  if (strcmp(type, "event") == 0) {
+    if (interface != IF_WEBSOCKET) { reject("event over UDP", frame, length); return; }
+    if (std::find(_deviceIds.begin(), _deviceIds.end(), deviceId) == _deviceIds.end()) { reject("event from an unknown device", frame, length); return; }
+    if (!*(payload["action"] | "") || !*(payload["cause"]["type"] | "") || strlen(replyToken) != MESSAGEID_STRLEN) { reject("event without action, cause or replyToken", frame, length); return; }
+    _stats.events++;
+    return;
+  }
+
+  reject("unknown message type", frame, length);
+}
+
+void SinricProServer::resetStats() {
+  _stats = Stats { 0, 0, 0, 0, 0 };
+  _latencies.clear();
+  _pending.clear();
+  _lastError.clear();
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// UDP listener: a burst of packets against the former listener (one packet per handle()
+// through a 1024 byte stack buffer, multicast group joined again after every reply), then
+// end to end: requests from two senders answered to the address each came from, one by one and
+// as a burst answered within one SinricPro.handle() without joining the group again, and
+// packets of 1024 bytes and more.
+
+#include "BenchmarkFleet.h"
+#include "WiFiUdp.h"
+
+#define BURST 8
+
+// the former implementation
+class LegacyUdpListener {
+  public:
+    void begin(SinricProReceiveQueue_t* receiveQueue) {
+      this->receiveQueue = receiveQueue;
+      _udp.beginMulticast(UDP_MULTICAST_IP, UDP_MULTICAST_PORT);
+    }
+    void handle() {
+      if (!_udp.available()) return;
+      int len = _udp.parsePacket();
+      if (len) {
+        char buffer[1024];
+        int n = _udp.read(buffer, 1024);
+        buffer[n] = 0;
+        receiveQueue->push(IF_UDP, buffer, n);
+      }
+    }
+    void sendMessage(const char* message, size_t length, SinricProRemote) {
+      _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
+      _udp.write((const uint8_t*) message, length);
+      _udp.endPacket();
+      _udp.beginMulticast(UDP_MULTICAST_IP, UDP_MULTICAST_PORT);
+    }
+    void stop() { _udp.stop(); }
+  private:
+    WiFiUDP _udp;
+    SinricProReceiveQueue_t* receiveQueue;
+};
+
+static bool fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  return false;
+}
+
+// a burst into the receive queue and a reply per packet, without the rest of the library
+template <typename Listener>
+static bool measure(const char* name, const std::vector<std::string>& requests) {
+  static SinricProReceiveQueue_t queue;
+  Listener listener;
+  listener.begin(&queue);
+  const uint64_t bursts = 20000;
+  uint64_t handles = 0;
+  uint32_t joins = WiFiUDP::hostJoinCount();
+  Benchmark benchmark(name);
+  Benchmark::clock::time_point start = Benchmark::clock::now();
+  for (uint64_t burst = 0; burst < bursts; burst++) {
+    for (size_t i = 0; i < BURST; i++) WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t*) requests[i].c_str(), requests[i].length());
+    while (queue.size() < BURST) {
+      listener.handle();
+      handles++;
+    }
+    for (size_t i = 0; i < BURST; i++) {
+      listener.sendMessage(queue.front()->getMessage(), 2, queue.front()->getRemote());
+      queue.pop();
+    }
+  }
+  benchmark.record(bursts * BURST, Benchmark::clock::now() - start);
+  char extra[96];
+  snprintf(extra, sizeof(extra), "%5.2f handle()/packet %5.2f joins/reply", (double) handles / (bursts * BURST),
+           (double) (WiFiUDP::hostJoinCount() - joins) / (bursts * BURST));
+  benchmark.report(extra);
+  listener.stop();
+  return queue.empty();
+}
+
+struct Reply { IPAddress to; uint16_t port; std::string token; };
+
+// every reply goes back to the sender of its request, request i came from 192.168.1.100 + i % 2 port 50000 + i
+static bool checkSenders(const std::vector<Reply>& replies, const std::vector<std::string>& requests) {
+  if (replies.size() != BURST) return fail("not every UDP request was answered");
+  for (size_t i = 0; i < BURST; i++) {
+    DynamicJsonDocument request(1024);
+    deserializeJson(request, requests[i].c_str());
+    if (replies[i].to != IPAddress(192, 168, 1, 100 + i % 2) || replies[i].port != 50000 + i || replies[i].token != (request["payload"]["replyToken"] | "")) {
+      return fail("UDP reply went to the wrong address");
+    }
+  }
+  return true;
+}
+
+static void deliverFromSenders(const std::vector<std::string>& requests, bool handleEach) {
+  for (size_t i = 0; i < BURST; i++) {
+    IPAddress from(192, 168, 1, 100 + i % 2);
+    WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t*) requests[i].c_str(), requests[i].length(), from, 50000 + i);
+    if (handleEach) SinricPro.handle();
+  }
+}
+
+static bool checkEndToEnd(const std::vector<std::string>& requests) {
+  std::vector<Reply> replies;
+  WiFiUDP::hostOnSend([&](IPAddress to, uint16_t port, const uint8_t* data, size_t length) {
+    DynamicJsonDocument reply(1024);
+    deserializeJson(reply, (const char*) data, length);
+    replies.push_back(Reply { to, port, reply["payload"]["replyToken"] | "" });
+  });
+  uint32_t joins = WiFiUDP::hostJoinCount();
+
+  // requests from two senders handled one by one
+  deliverFromSenders(requests, true);
+  if (!checkSenders(replies, requests)) return false;
+
+  // the same arriving at once: queued and answered by one handle(), still to the sender of each request
+  replies.clear();
+  deliverFromSenders(requests, false);
+  SinricPro.handle();
+  if (replies.size() != BURST) return fail("UDP burst was not drained by one handle()");
+  if (!checkSenders(replies, requests)) return false;
+  if (WiFiUDP::hostJoinCount() != joins) return fail("multicast group was joined again");
+
+  // 1024 bytes overflowed the former stack buffer, bigger packets were truncated
+  for (size_t size : { 1023, 1024, 1025, 2000 }) {
+    std::string packet(size, ' ');
+    packet[0] = '{';
+    packet[size - 1] = '}';
+    WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t*) packet.c_str(), packet.length());
+  }
+  replies.clear();
+  WiFiUDP::hostDeliver(UDP_MULTICAST_PORT, (const uint8_t*) requests[0].c_str(), requests[0].length());
+  SinricPro.handle();
+  if (replies.size() != 1) return fail("UDP request after big packets was not answered");
+  WiFiUDP::hostOnSend(nullptr);
+  return true;
+}
+
+int main() {
+  std::vector<std::string> traffic = loadTraffic("requests.txt");
+  std::vector<std::string> requests;
+  for (auto& frame : traffic) {
+    if (frame.find("\"type\":\"request\"") != std::string::npos) requests.push_back(frame);
+  }
+  if (requests.size() < BURST) return 1;
+
+  // before SinricPro.begin(), so the library's own socket doesn't receive these packets
+  if (!measure<LegacyUdpListener>("UDP burst: one packet per handle()", requests)) return 1;
+  if (!measure<udpListener>("UDP burst: drained per handle()", requests)) return 1;
+
+  HostClock::useVirtualClock(true);
+  BenchmarkFleet fleet;
+  fleet.setup();
+  if (!fleet.connect(traffic)) {
+    fprintf(stderr, "SinricPro did not connect\n");
+    return 1;
+  }
+  return checkEndToEnd(requests) ? 0 : 1;
+}
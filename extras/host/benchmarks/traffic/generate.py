@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2019 Sinric. All rights reserved.
+#  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+#
+#  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+#
+# Generates requests.txt: one websocket frame per line, shaped and signed exactly like
+# the frames ws.sinric.pro sends. The credentials must match extras/host/benchmarks/Benchmark.h.
+
+import base64
+import hashlib
+import hmac
+import json
+import os
+import uuid
+
+APP_SECRET = "5f36aaaa-b3b7-4c3c-aeae-e86724a9aaaa-4c4abbbb-3b3b-b5be-b9b3-333d65bbbbbb"
+TIMESTAMP = 1600000000
+
+DEVICES = {
+    "switch":     "5dc1564130aaaaaaaaaaaa01",
+    "dimswitch":  "5dc1564130aaaaaaaaaaaa02",
+    "light":      "5dc1564130aaaaaaaaaaaa03",
+    "thermostat": "5dc1564130aaaaaaaaaaaa04",
+    "tv":         "5dc1564130aaaaaaaaaaaa05",
+    "speaker":    "5dc1564130aaaaaaaaaaaa06",
+    "blinds":     "5dc1564130aaaaaaaaaaaa07",
+}
+
+REQUESTS = [
+    ("switch",     "setPowerState",     None, {"state": "On"}),
+    ("switch",     "setPowerState",     None, {"state": "Off"}),
+    ("dimswitch",  "setPowerState",     None, {"state": "On"}),
+    ("dimswitch",  "setPowerLevel",     None, {"powerLevel": 42}),
+    ("dimswitch",  "adjustPowerLevel",  None, {"powerLevelDelta": -10}),
+    ("light",      "setPowerState",     None, {"state": "On"}),
+    ("light",      "setBrightness",     None, {"brightness": 75}),
+    ("light",      "setColor",          None, {"color": {"b": 255, "g": 128, "r": 0}}),
+    ("light",      "setColorTemperature", None, {"colorTemperature": 4000}),
+    ("thermostat", "targetTemperature", None, {"temperature": 21}),
+    ("thermostat", "setThermostatMode", None, {"thermostatMode": "HEAT"}),
+    ("tv",         "setPowerState",     None, {"state": "On"}),
+    ("tv",         "setVolume",         None, {"volume": 30}),
+    ("tv",         "selectInput",       None, {"input": "HDMI 1"}),
+    ("tv",         "changeChannel",     None, {"channel": {"name": "HBO"}}),
+    ("tv",         "mediaControl",      None, {"control": "Play"}),
+    ("speaker",    "setMute",           None, {"mute": True}),
+    ("speaker",    "setBands",          None, {"bands": [{"level": 5, "name": "BASS"},
+                                                         {"level": 3, "name": "MIDRANGE"},
+                                                         {"level": 1, "name": "TREBLE"}]}),
+    ("speaker",    "setMode",           None, {"mode": "MUSIC"}),
+    ("blinds",     "setRangeValue",     None, {"rangeValue": 2}),
+    ("blinds",     "adjustRangeValue",  None, {"rangeValueDelta": 1}),
+]
+
+
+def dumps(value):
+    return json.dumps(value, separators=(",", ":"), ensure_ascii=False)
+
+
+def sign(payload):
+    digest = hmac.new(APP_SECRET.encode(), dumps(payload).encode(), hashlib.sha256).digest()
+    return base64.b64encode(digest).decode()
+
+
+def request(index, device, action, instance, value):
+    payload = {
+        "action": action,
+        "clientId": "alexa-skill",
+        "createdAt": TIMESTAMP + index,
+        "deviceAttributes": [],
+        "deviceId": DEVICES[device],
+    }
+    if instance:
+        payload["instanceId"] = instance
+    payload.update({
+        "replyToken": str(uuid.UUID(int=index + 1, version=4)),
+        "type": "request",
+        "value": value,
+    })
+    return {
+        "header": {"payloadVersion": 2, "signatureVersion": 1},
+        "payload": payload,
+        "signature": {"HMAC": sign(payload)},
+    }
+
+
+def main():
+    lines = [dumps({"timestamp": TIMESTAMP})]
+    for index, (device, action, instance, value) in enumerate(REQUESTS):
+        lines.append(dumps(request(index, device, action, instance, value)))
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "requests.txt")
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#include "Arduino.h"
+
+#include <stdarg.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+// HostClock / millis / micros
+// ---------------------------------------------------------------------------
+
+static bool     clockIsVirtual = false;
+static uint64_t virtualMicros = 0;
+
+static uint64_t systemMicros() {
+  static uint64_t start = 0;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t now = (uint64_t) ts.tv_sec * 1000000ull + (uint64_t) ts.tv_nsec / 1000ull;
+  if (!start) start = now;
+  return now - start;
+}
+
+void HostClock::useVirtualClock(bool flag) {
+  if (flag && !clockIsVirtual) virtualMicros = systemMicros();
+  clockIsVirtual = flag;
+}
+
+bool HostClock::isVirtual() { return clockIsVirtual; }
+void HostClock::setMicros(uint64_t us) { virtualMicros = us; }
+void HostClock::advanceMillis(uint64_t ms) { virtualMicros += ms * 1000ull; }
+void HostClock::advanceMicros(uint64_t us) { virtualMicros += us; }
+uint64_t HostClock::nowMicros() { return clockIsVirtual ? virtualMicros : systemMicros(); }
+
+unsigned long millis() { return (unsigned long) (uint32_t) (HostClock::nowMicros() / 1000ull); }
+unsigned long micros() { return (unsigned long) (uint32_t) HostClock::nowMicros(); }
+
+void delay(unsigned long ms) {
+  if (clockIsVirtual) {
+    HostClock::advanceMillis(ms);
+    return;
+  }
+  struct timespec ts = { (time_t) (ms / 1000), (long) (ms % 1000) * 1000000L };
+  nanosleep(&ts, nullptr);
+}
+
+void yield() {}
+
+// ---------------------------------------------------------------------------
+// random
+// ---------------------------------------------------------------------------
+
+static uint32_t randomState = 0x2545F491u;
+
+void randomSeed(unsigned long seed) {
+  if (seed) randomState = (uint32_t) seed;
+}
+
+static uint32_t nextRandom() {
+  // xorshift32, deterministic so that benchmark runs are reproducible
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return (long) (nextRandom() % (uint32_t) howbig);
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+// ---------------------------------------------------------------------------
+// Print / Stream / Serial
+// ---------------------------------------------------------------------------
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (!write(*buffer++)) break;
+    n++;
+  }
+  return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+  char buf[256];
+  va_list arg;
+  va_start(arg, format);
+  int len = vsnprintf(buf, sizeof(buf), format, arg);
+  va_end(arg);
+  if (len < 0) return 0;
+  if ((size_t) len < sizeof(buf)) return write((const uint8_t *) buf, (size_t) len);
+
+  char *big = (char *) malloc((size_t) len + 1);
+  if (!big) return 0;
+  va_start(arg, format);
+  vsnprintf(big, (size_t) len + 1, format, arg);
+  va_end(arg);
+  size_t n = write((const uint8_t *) big, (size_t) len);
+  free(big);
+  return n;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = read();
+    if (c < 0) break;
+    *buffer++ = (char) c;
+    count++;
+  }
+  return count;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+  fflush(stdout);
+}
+
+HardwareSerial Serial;
+
+// ---------------------------------------------------------------------------
+// IPAddress
+// ---------------------------------------------------------------------------
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address[0], _address[1], _address[2], _address[3]);
+  return String(buf);
+}
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+// Host (Linux) stand-in for the Arduino core. Only what SinricPro needs is provided.
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+#include "HostClock.h"
+
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+#endif
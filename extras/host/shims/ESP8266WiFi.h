@@ -0,0 +1,13 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_ESP8266WIFI_H_
+#define _HOST_ESP8266WIFI_H_
+
+#include "WiFi.h"
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_HARDWARESERIAL_H_
+#define _HOST_HARDWARESERIAL_H_
+
+#include "Stream.h"
+
+/**
+ * @brief Serial port stand-in writing to stdout
+ **/
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud) { (void) baud; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_CLOCK_H_
+#define _HOST_CLOCK_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Time source behind `millis()` and `micros()` on the host build
+ *
+ * By default the clock follows the monotonic system clock. Benchmarks and tests that need
+ * reproducible timing switch to the virtual clock and advance it by hand.
+ **/
+class HostClock {
+  public:
+    static void useVirtualClock(bool flag);
+    static bool isVirtual();
+    static void setMicros(uint64_t us);
+    static void advanceMillis(uint64_t ms);
+    static void advanceMicros(uint64_t us);
+    static uint64_t nowMicros();
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#include "HostHeap.h"
+
+#include <malloc.h>
+#include <atomic>
+
+extern "C" {
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void  __libc_free(void* ptr);
+}
+
+static std::atomic<uint64_t> _allocations(0);
+static std::atomic<uint64_t> _bytes(0);
+static std::atomic<uint64_t> _frees(0);
+static std::atomic<size_t> _live(0);
+static std::atomic<size_t> _peak(0);
+
+static void countAllocation(void* ptr, size_t size) {
+  _allocations.fetch_add(1, std::memory_order_relaxed);
+  _bytes.fetch_add(size, std::memory_order_relaxed);
+  if (!ptr) return;
+  size_t live = _live.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed) + malloc_usable_size(ptr);
+  size_t peak = _peak.load(std::memory_order_relaxed);
+  while (live > peak && !_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+static void countFree(void* ptr) {
+  if (!ptr) return;
+  _frees.fetch_add(1, std::memory_order_relaxed);
+  _live.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+}
+
+extern "C" {
+
+void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  countAllocation(ptr, size);
+  return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+  void* ptr = __libc_calloc(count, size);
+  countAllocation(ptr, count * size);
+  return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+  if (ptr && !size) {
+    free(ptr);
+    return nullptr;
+  }
+  if (ptr) _live.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+  void* newPtr = __libc_realloc(ptr, size);
+  if (!newPtr && ptr) _live.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+  countAllocation(newPtr, size);
+  return newPtr;
+}
+
+void free(void* ptr) {
+  countFree(ptr);
+  __libc_free(ptr);
+}
+
+}
+
+void HostHeap::reset() {
+  _allocations = 0;
+  _bytes = 0;
+  _frees = 0;
+  _peak = _live.load();
+}
+
+HostHeap::Stats HostHeap::stats() {
+  Stats result = { _allocations.load(), _bytes.load(), _frees.load() };
+  return result;
+}
+
+size_t HostHeap::liveBytes() {
+  return _live.load();
+}
+
+size_t HostHeap::peakBytes() {
+  return _peak.load();
+}
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_HEAP_H_
+#define _HOST_HEAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Heap allocation counters for the host build
+ *
+ * Linking `HostHeap.cpp` into an executable wraps `malloc`, `calloc`, `realloc` and `free`
+ * (and therefore `new` / `delete`) to count every allocation. Counters are process wide.
+ **/
+class HostHeap {
+  public:
+    struct Stats {
+      uint64_t allocations;  // number of malloc / calloc / realloc calls
+      uint64_t bytes;        // bytes requested by these calls
+      uint64_t frees;
+    };
+
+    static void reset();
+    static Stats stats();
+    static size_t liveBytes();
+    static size_t peakBytes();
+};
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_IPADDRESS_H_
+#define _HOST_IPADDRESS_H_
+
+#include <stdint.h>
+
+#include "WString.h"
+
+class IPAddress {
+  public:
+    IPAddress() : _address{} {}
+    IPAddress(uint8_t o1, uint8_t o2, uint8_t o3, uint8_t o4) : _address{o1, o2, o3, o4} {}
+    IPAddress(uint32_t address) { fromUint32(address); }
+
+    operator uint32_t() const { return (uint32_t) _address[0] | (uint32_t) _address[1] << 8 | (uint32_t) _address[2] << 16 | (uint32_t) _address[3] << 24; }
+    bool operator==(const IPAddress &other) const { return (uint32_t) *this == (uint32_t) other; }
+    bool operator!=(const IPAddress &other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return _address[index]; }
+    uint8_t &operator[](int index) { return _address[index]; }
+
+    String toString() const;
+
+  private:
+    void fromUint32(uint32_t address) {
+      for (int i = 0; i < 4; i++) _address[i] = (uint8_t) (address >> (8 * i));
+    }
+    uint8_t _address[4];
+};
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_PRINT_H_
+#define _HOST_PRINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "WString.h"
+
+class Print;
+
+class Printable {
+  public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str ? write((const uint8_t *) str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *) buffer, size); }
+    virtual void flush() {}
+
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+
+    size_t print(const String &s) { return write(s.c_str(), s.length()); }
+    size_t print(const char *str) { return write(str); }
+    size_t print(char c) { return write((uint8_t) c); }
+    size_t print(int n, int base = 10) { return print(String(n, (unsigned char) base)); }
+    size_t print(unsigned int n, int base = 10) { return print(String(n, (unsigned char) base)); }
+    size_t print(long n, int base = 10) { return print(String(n, (unsigned char) base)); }
+    size_t print(unsigned long n, int base = 10) { return print(String(n, (unsigned char) base)); }
+    size_t print(double n, int digits = 2) { return print(String(n, (unsigned char) digits)); }
+    size_t print(const Printable &x) { return x.printTo(*this); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &value) { size_t n = print(value); return n + println(); }
+};
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_STREAM_H_
+#define _HOST_STREAM_H_
+
+#include "Print.h"
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *) buffer, length); }
+
+  protected:
+    unsigned long _timeout = 1000;
+};
+
+#endif
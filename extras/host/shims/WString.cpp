@@ -0,0 +1,458 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <utility>
+
+String::String(const char *cstr) {
+  init();
+  if (cstr) copy(cstr, strlen(cstr));
+}
+
+String::String(const char *cstr, unsigned int length) {
+  init();
+  if (cstr) copy(cstr, length);
+}
+
+String::String(const String &value) {
+  init();
+  *this = value;
+}
+
+String::String(String &&rval) {
+  init();
+  move(rval);
+}
+
+String::String(StringSumHelper &&rval) {
+  init();
+  move(rval);
+}
+
+String::String(char c) {
+  init();
+  char buf[2] = { c, 0 };
+  *this = buf;
+}
+
+static void formatNumber(char *buf, size_t size, unsigned long long value, bool negative, unsigned char base) {
+  char tmp[68];
+  int i = 0;
+  if (base < 2) base = 10;
+  do {
+    unsigned digit = (unsigned) (value % base);
+    tmp[i++] = (char) (digit < 10 ? '0' + digit : 'a' + digit - 10);
+    value /= base;
+  } while (value);
+  size_t n = 0;
+  if (negative && n + 1 < size) buf[n++] = '-';
+  while (i > 0 && n + 1 < size) buf[n++] = tmp[--i];
+  buf[n] = 0;
+}
+
+static void formatSigned(char *buf, size_t size, long long value, unsigned char base) {
+  if (value < 0 && base == 10) formatNumber(buf, size, (unsigned long long) (-(value + 1)) + 1, true, base);
+  else formatNumber(buf, size, (unsigned long long) value, false, base);
+}
+
+String::String(unsigned char value, unsigned char base) {
+  init();
+  char buf[68];
+  formatNumber(buf, sizeof(buf), value, false, base);
+  *this = buf;
+}
+
+String::String(int value, unsigned char base) {
+  init();
+  char buf[68];
+  formatSigned(buf, sizeof(buf), value, base);
+  *this = buf;
+}
+
+String::String(unsigned int value, unsigned char base) {
+  init();
+  char buf[68];
+  formatNumber(buf, sizeof(buf), value, false, base);
+  *this = buf;
+}
+
+String::String(long value, unsigned char base) {
+  init();
+  char buf[68];
+  formatSigned(buf, sizeof(buf), value, base);
+  *this = buf;
+}
+
+String::String(unsigned long value, unsigned char base) {
+  init();
+  char buf[68];
+  formatNumber(buf, sizeof(buf), value, false, base);
+  *this = buf;
+}
+
+String::String(long long value, unsigned char base) {
+  init();
+  char buf[68];
+  formatSigned(buf, sizeof(buf), value, base);
+  *this = buf;
+}
+
+String::String(unsigned long long value, unsigned char base) {
+  init();
+  char buf[68];
+  formatNumber(buf, sizeof(buf), value, false, base);
+  *this = buf;
+}
+
+String::String(float value, unsigned char decimalPlaces) {
+  init();
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, (double) value);
+  *this = buf;
+}
+
+String::String(double value, unsigned char decimalPlaces) {
+  init();
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  *this = buf;
+}
+
+String::~String() {
+  free(buffer);
+}
+
+void String::init() {
+  buffer = nullptr;
+  capacity = 0;
+  len = 0;
+}
+
+void String::invalidate() {
+  free(buffer);
+  init();
+}
+
+bool String::reserve(unsigned int size) {
+  if (buffer && capacity >= size) return true;
+  if (changeBuffer(size)) {
+    if (len == 0) buffer[0] = 0;
+    return true;
+  }
+  return false;
+}
+
+bool String::changeBuffer(unsigned int maxStrLen) {
+  char *newbuffer = (char *) realloc(buffer, maxStrLen + 1);
+  if (!newbuffer) return false;
+  buffer = newbuffer;
+  capacity = maxStrLen;
+  return true;
+}
+
+String &String::copy(const char *cstr, unsigned int length) {
+  if (!reserve(length)) {
+    invalidate();
+    return *this;
+  }
+  len = length;
+  memmove(buffer, cstr, length);
+  buffer[len] = 0;
+  return *this;
+}
+
+void String::move(String &rhs) {
+  if (this == &rhs) return;
+  free(buffer);
+  buffer = rhs.buffer;
+  capacity = rhs.capacity;
+  len = rhs.len;
+  rhs.init();
+}
+
+String &String::operator=(const String &rhs) {
+  if (this == &rhs) return *this;
+  if (rhs.buffer) copy(rhs.buffer, rhs.len);
+  else invalidate();
+  return *this;
+}
+
+String &String::operator=(String &&rval) {
+  move(rval);
+  return *this;
+}
+
+String &String::operator=(StringSumHelper &&rval) {
+  move(rval);
+  return *this;
+}
+
+String &String::operator=(const char *cstr) {
+  if (cstr) copy(cstr, strlen(cstr));
+  else invalidate();
+  return *this;
+}
+
+bool String::concat(const String &s) {
+  if (&s == this) {
+    unsigned int oldLen = len;
+    if (!reserve(len * 2)) return false;
+    memcpy(buffer + oldLen, buffer, oldLen);
+    len = oldLen * 2;
+    buffer[len] = 0;
+    return true;
+  }
+  return concat(s.buffer ? s.buffer : "", s.len);
+}
+
+bool String::concat(const char *cstr, unsigned int length) {
+  unsigned int newlen = len + length;
+  if (!cstr) return false;
+  if (length == 0) return true;
+  if (!reserve(newlen)) return false;
+  memmove(buffer + len, cstr, length);
+  len = newlen;
+  buffer[len] = 0;
+  return true;
+}
+
+bool String::concat(const char *cstr) {
+  if (!cstr) return false;
+  return concat(cstr, strlen(cstr));
+}
+
+bool String::concat(char c) {
+  char buf[2] = { c, 0 };
+  return concat(buf, 1);
+}
+
+bool String::concat(unsigned char num) { return concat(String(num)); }
+bool String::concat(int num) { return concat(String(num)); }
+bool String::concat(unsigned int num) { return concat(String(num)); }
+bool String::concat(long num) { return concat(String(num)); }
+bool String::concat(unsigned long num) { return concat(String(num)); }
+bool String::concat(long long num) { return concat(String(num)); }
+bool String::concat(unsigned long long num) { return concat(String(num)); }
+bool String::concat(float num) { return concat(String(num)); }
+bool String::concat(double num) { return concat(String(num)); }
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const String &rhs) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(rhs)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const char *cstr) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!cstr || !a.concat(cstr)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, char c) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(c)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, unsigned char num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, int num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, unsigned int num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, long num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, unsigned long num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, float num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, double num) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  if (!a.concat(num)) a.invalidate();
+  return a;
+}
+
+int String::compareTo(const String &s) const {
+  return strcmp(c_str(), s.c_str());
+}
+
+bool String::equals(const String &s) const {
+  return len == s.len && compareTo(s) == 0;
+}
+
+bool String::equals(const char *cstr) const {
+  if (!cstr) return len == 0;
+  return strcmp(c_str(), cstr) == 0;
+}
+
+bool String::equalsIgnoreCase(const String &s) const {
+  if (len != s.len) return false;
+  for (unsigned int i = 0; i < len; i++) {
+    if (tolower((unsigned char) buffer[i]) != tolower((unsigned char) s.buffer[i])) return false;
+  }
+  return true;
+}
+
+bool String::startsWith(const String &prefix) const {
+  if (prefix.len > len) return false;
+  return strncmp(c_str(), prefix.c_str(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String &suffix) const {
+  if (suffix.len > len) return false;
+  return strcmp(c_str() + len - suffix.len, suffix.c_str()) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+  return operator[](index);
+}
+
+void String::setCharAt(unsigned int index, char c) {
+  if (index < len) buffer[index] = c;
+}
+
+char String::operator[](unsigned int index) const {
+  if (index >= len) return 0;
+  return buffer[index];
+}
+
+char &String::operator[](unsigned int index) {
+  static char dummy_writable_char;
+  if (index >= len) {
+    dummy_writable_char = 0;
+    return dummy_writable_char;
+  }
+  return buffer[index];
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize, unsigned int index) const {
+  if (!bufsize || !buf) return;
+  if (index >= len) {
+    buf[0] = 0;
+    return;
+  }
+  unsigned int n = bufsize - 1;
+  if (n > len - index) n = len - index;
+  memcpy(buf, buffer + index, n);
+  buf[n] = 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  if (fromIndex >= len) return -1;
+  const char *temp = strchr(buffer + fromIndex, ch);
+  if (!temp) return -1;
+  return temp - buffer;
+}
+
+int String::indexOf(const String &s, unsigned int fromIndex) const {
+  if (fromIndex >= len) return -1;
+  const char *found = strstr(buffer + fromIndex, s.c_str());
+  if (!found) return -1;
+  return found - buffer;
+}
+
+int String::lastIndexOf(char ch) const {
+  if (!len) return -1;
+  const char *temp = strrchr(buffer, ch);
+  if (!temp) return -1;
+  return temp - buffer;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+  if (left > right) std::swap(left, right);
+  if (left >= len) return String();
+  if (right > len) right = len;
+  return String(buffer + left, right - left);
+}
+
+void String::replace(const String &find, const String &replace) {
+  if (len == 0 || find.len == 0) return;
+  String result;
+  unsigned int i = 0;
+  while (i < len) {
+    if (strncmp(buffer + i, find.c_str(), find.len) == 0) {
+      result.concat(replace);
+      i += find.len;
+    } else {
+      result.concat(buffer[i++]);
+    }
+  }
+  *this = result;
+}
+
+void String::remove(unsigned int index) {
+  remove(index, (unsigned int) -1);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= len) return;
+  if (count > len - index) count = len - index;
+  memmove(buffer + index, buffer + index + count, len - index - count);
+  len -= count;
+  buffer[len] = 0;
+}
+
+void String::toLowerCase() {
+  for (unsigned int i = 0; i < len; i++) buffer[i] = (char) tolower((unsigned char) buffer[i]);
+}
+
+void String::toUpperCase() {
+  for (unsigned int i = 0; i < len; i++) buffer[i] = (char) toupper((unsigned char) buffer[i]);
+}
+
+void String::trim() {
+  if (!buffer || len == 0) return;
+  char *begin = buffer;
+  while (isspace((unsigned char) *begin)) begin++;
+  char *end = buffer + len - 1;
+  while (isspace((unsigned char) *end) && end >= begin) end--;
+  len = end + 1 - begin;
+  if (begin > buffer) memmove(buffer, begin, len);
+  buffer[len] = 0;
+}
+
+long String::toInt() const {
+  return buffer ? atol(buffer) : 0;
+}
+
+float String::toFloat() const {
+  return buffer ? (float) atof(buffer) : 0;
+}
+
+double String::toDouble() const {
+  return buffer ? atof(buffer) : 0;
+}
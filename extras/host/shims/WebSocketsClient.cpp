@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#include "WebSocketsClient.h"
+
+WebSocketsClient *WebSocketsClient::_instance = nullptr;
+
+WebSocketsClient::WebSocketsClient() : _client{0} {}
+
+WebSocketsClient::~WebSocketsClient() {
+  if (_instance == this) _instance = nullptr;
+}
+
+void WebSocketsClient::begin(const char *host, uint16_t port, const char *url, const char *protocol) {
+  (void) host;
+  (void) port;
+  (void) url;
+  (void) protocol;
+  _begin = true;
+  _instance = this;
+}
+
+void WebSocketsClient::begin(String host, uint16_t port, String url, String protocol) {
+  begin(host.c_str(), port, url.c_str(), protocol.c_str());
+}
+
+void WebSocketsClient::beginSSL(const char *host, uint16_t port, const char *url, const char *fingerprint, const char *protocol) {
+  (void) fingerprint;
+  begin(host, port, url, protocol);
+}
+
+void WebSocketsClient::loop() {
+  if (_begin && _autoConnect && !_connected) hostConnect();
+  std::string frame;
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(_postedMutex);
+      if (_posted.empty()) break;
+      frame.swap(_posted.front());
+      _posted.pop_front();
+    }
+    if (_connected) hostReceive(frame.c_str(), frame.length());
+  }
+}
+
+bool WebSocketsClient::sendTXT(uint8_t *payload, size_t length, bool headerToPayload) {
+  (void) headerToPayload;
+  if (!_connected) return false;
+  if (length == 0) length = strlen((const char *) payload);
+  if (_hostSendCb) _hostSendCb((const char *) payload, length);
+  return true;
+}
+
+bool WebSocketsClient::sendTXT(const uint8_t *payload, size_t length) { return sendTXT((uint8_t *) payload, length); }
+bool WebSocketsClient::sendTXT(char *payload, size_t length, bool headerToPayload) { return sendTXT((uint8_t *) payload, length, headerToPayload); }
+bool WebSocketsClient::sendTXT(const char *payload, size_t length) { return sendTXT((uint8_t *) payload, length); }
+bool WebSocketsClient::sendTXT(String &payload) { return sendTXT((uint8_t *) payload.c_str(), payload.length()); }
+bool WebSocketsClient::sendTXT(char payload) { return sendTXT((uint8_t *) &payload, 1); }
+
+void WebSocketsClient::disconnect() {
+  _begin = false;
+  hostDisconnect();
+}
+
+void WebSocketsClient::setExtraHeaders(const char *extraHeaders) {
+  _extraHeaders = extraHeaders ? extraHeaders : "";
+}
+
+void WebSocketsClient::enableHeartbeat(uint32_t pingInterval, uint32_t pongTimeout, uint8_t disconnectTimeoutCount) {
+  (void) pingInterval;
+  (void) pongTimeout;
+  (void) disconnectTimeoutCount;
+}
+
+void WebSocketsClient::hostConnect() {
+  if (_connected) return;
+  _connected = true;
+  runCbEvent(WStype_CONNECTED, (uint8_t *) "/", 1);
+}
+
+void WebSocketsClient::hostDisconnect() {
+  if (!_connected) return;
+  _connected = false;
+  runCbEvent(WStype_DISCONNECTED, nullptr, 0);
+}
+
+void WebSocketsClient::hostReceive(const char *payload, size_t length) {
+  // the WebSockets library hands out a zero terminated copy of the frame
+  _rxBuffer.resize(length + 1);
+  memcpy(_rxBuffer.data(), payload, length);
+  _rxBuffer[length] = 0;
+  messageReceived(&_client, WSop_text, _rxBuffer.data(), length, true);
+}
+
+void WebSocketsClient::hostPost(const char *payload, size_t length) {
+  std::lock_guard<std::mutex> lock(_postedMutex);
+  _posted.emplace_back(payload, length);
+}
+
+void WebSocketsClient::hostPong() {
+  messageReceived(&_client, WSop_pong, nullptr, 0, true);
+}
+
+void WebSocketsClient::messageReceived(WSclient_t *client, WSopcode_t opcode, uint8_t *payload, size_t length, bool fin) {
+  (void) client;
+  (void) fin;
+  switch (opcode) {
+    case WSop_text:   runCbEvent(WStype_TEXT, payload, length); break;
+    case WSop_binary: runCbEvent(WStype_BIN, payload, length); break;
+    case WSop_ping:   runCbEvent(WStype_PING, payload, length); break;
+    case WSop_pong:   runCbEvent(WStype_PONG, payload, length); break;
+    default:          break;
+  }
+}
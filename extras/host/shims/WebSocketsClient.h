@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_WEBSOCKETSCLIENT_H_
+#define _HOST_WEBSOCKETSCLIENT_H_
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+// pretend to be the minimum version SinricPro requires
+#define WEBSOCKETS_VERSION_INT 2003003
+
+typedef enum {
+  WStype_ERROR,
+  WStype_DISCONNECTED,
+  WStype_CONNECTED,
+  WStype_TEXT,
+  WStype_BIN,
+  WStype_FRAGMENT_TEXT_START,
+  WStype_FRAGMENT_BIN_START,
+  WStype_FRAGMENT,
+  WStype_FRAGMENT_FIN,
+  WStype_PING,
+  WStype_PONG,
+} WStype_t;
+
+typedef enum {
+  WSop_continuation = 0x00,
+  WSop_text         = 0x01,
+  WSop_binary       = 0x02,
+  WSop_close        = 0x08,
+  WSop_ping         = 0x09,
+  WSop_pong         = 0x0A
+} WSopcode_t;
+
+typedef struct {
+  uint32_t lastPing;
+} WSclient_t;
+
+/**
+ * @brief WebSocketsClient stand-in without any network below it
+ *
+ * The client "connects" on the first `loop()` after `begin()`. Frames are injected with
+ * `hostReceive()` and everything the library sends is handed to the callback registered
+ * with `hostOnSend()`. `hostInstance()` returns the client that called `begin()` last.
+ * `hostPost()` may be called from any thread, the frame is received by the next `loop()`
+ * like a frame arriving from the network.
+ **/
+class WebSocketsClient {
+  public:
+    typedef std::function<void(WStype_t type, uint8_t *payload, size_t length)> WebSocketClientEvent;
+    typedef std::function<void(const char *payload, size_t length)> HostSendCallback;
+
+    WebSocketsClient();
+    virtual ~WebSocketsClient();
+
+    void begin(const char *host, uint16_t port, const char *url = "/", const char *protocol = "arduino");
+    void begin(String host, uint16_t port, String url = "/", String protocol = "arduino");
+    void beginSSL(const char *host, uint16_t port, const char *url = "/", const char *fingerprint = "", const char *protocol = "arduino");
+
+    void loop();
+    void onEvent(WebSocketClientEvent cbEvent) { _cbEvent = cbEvent; }
+
+    bool sendTXT(uint8_t *payload, size_t length = 0, bool headerToPayload = false);
+    bool sendTXT(const uint8_t *payload, size_t length = 0);
+    bool sendTXT(char *payload, size_t length = 0, bool headerToPayload = false);
+    bool sendTXT(const char *payload, size_t length = 0);
+    bool sendTXT(String &payload);
+    bool sendTXT(char payload);
+
+    void disconnect();
+    void setExtraHeaders(const char *extraHeaders = NULL);
+    void enableHeartbeat(uint32_t pingInterval, uint32_t pongTimeout, uint8_t disconnectTimeoutCount);
+    void setReconnectInterval(unsigned long time) { (void) time; }
+    bool isConnected() { return _connected; }
+
+    // host side
+    static WebSocketsClient *hostInstance() { return _instance; }
+    void hostSetAutoConnect(bool flag) { _autoConnect = flag; }
+    void hostConnect();
+    void hostDisconnect();
+    void hostReceive(const char *payload, size_t length);
+    void hostReceive(const char *payload) { hostReceive(payload, strlen(payload)); }
+    void hostPost(const char *payload, size_t length);
+    void hostPong();
+    void hostOnSend(HostSendCallback cb) { _hostSendCb = cb; }
+    const String &hostExtraHeaders() const { return _extraHeaders; }
+
+  protected:
+    WSclient_t _client;
+    virtual void messageReceived(WSclient_t *client, WSopcode_t opcode, uint8_t *payload, size_t length, bool fin);
+    void runCbEvent(WStype_t type, uint8_t *payload, size_t length) {
+      if (_cbEvent) _cbEvent(type, payload, length);
+    }
+
+  private:
+    WebSocketClientEvent _cbEvent;
+    HostSendCallback _hostSendCb;
+    String _extraHeaders;
+    std::vector<uint8_t> _rxBuffer;
+    std::deque<std::string> _posted;
+    std::mutex _postedMutex;
+    bool _begin = false;
+    bool _connected = false;
+    bool _autoConnect = true;
+
+    static WebSocketsClient *_instance;
+};
+
+#endif
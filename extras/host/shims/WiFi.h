@@ -0,0 +1,31 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_WIFI_H_
+#define _HOST_WIFI_H_
+
+#include "Arduino.h"
+
+typedef enum {
+  WL_IDLE_STATUS  = 0,
+  WL_CONNECTED    = 3,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+/**
+ * @brief WiFi stand-in, the host is always "connected"
+ **/
+class WiFiClass {
+  public:
+    wl_status_t status() { return WL_CONNECTED; }
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    String macAddress() { return String("00:00:00:00:00:00"); }
+};
+
+extern WiFiClass WiFi;
+
+#endif
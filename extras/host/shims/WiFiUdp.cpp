@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#include "WiFiUdp.h"
+
+WiFiClass WiFi;
+
+// constructed on first use: SinricPro's WiFiUDP is a global which may be constructed before this file's globals
+std::vector<WiFiUDP *> &WiFiUDP::sockets() {
+  static std::vector<WiFiUDP *> sockets;
+  return sockets;
+}
+
+WiFiUDP::HostSendCallback WiFiUDP::_sendCb;
+uint32_t WiFiUDP::_joinCount = 0;
+
+WiFiUDP::WiFiUDP() {
+  sockets().push_back(this);
+}
+
+WiFiUDP::~WiFiUDP() {
+  sockets().erase(std::remove(sockets().begin(), sockets().end(), this), sockets().end());
+}
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  _port = port;
+  _bound = true;
+  return 1;
+}
+
+uint8_t WiFiUDP::beginMulticast(IPAddress multicast, uint16_t port) {
+  (void) multicast;
+  _joinCount++;
+  return begin(port);
+}
+
+uint8_t WiFiUDP::beginMulticast(IPAddress interfaceAddr, IPAddress multicast, uint16_t port) {
+  (void) interfaceAddr;
+  return beginMulticast(multicast, port);
+}
+
+void WiFiUDP::stop() {
+  _bound = false;
+  _inbox.clear();
+  _current.clear();
+  _readPos = 0;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+  _sendIP = ip;
+  _sendPort = port;
+  _outgoing.clear();
+  return 1;
+}
+
+int WiFiUDP::endPacket() {
+  if (_sendCb) _sendCb(_sendIP, _sendPort, _outgoing.data(), _outgoing.size());
+  _outgoing.clear();
+  return 1;
+}
+
+size_t WiFiUDP::write(uint8_t c) {
+  _outgoing.push_back(c);
+  return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t *buffer, size_t size) {
+  _outgoing.insert(_outgoing.end(), buffer, buffer + size);
+  return size;
+}
+
+int WiFiUDP::parsePacket() {
+  if (_inbox.empty()) return 0;
+  Packet &packet = _inbox.front();
+  _current.swap(packet.data);
+  _remoteIP = packet.from;
+  _remotePort = packet.fromPort;
+  _inbox.pop_front();
+  _readPos = 0;
+  return (int) _current.size();
+}
+
+int WiFiUDP::available() {
+  if (_readPos < _current.size()) return (int) (_current.size() - _readPos);
+  return _inbox.empty() ? 0 : (int) _inbox.front().data.size();
+}
+
+int WiFiUDP::read() {
+  if (_readPos >= _current.size()) return -1;
+  return _current[_readPos++];
+}
+
+int WiFiUDP::read(unsigned char *buffer, size_t len) {
+  size_t n = _current.size() - _readPos;
+  if (n > len) n = len;
+  memcpy(buffer, _current.data() + _readPos, n);
+  _readPos += n;
+  return (int) n;
+}
+
+int WiFiUDP::peek() {
+  if (_readPos >= _current.size()) return -1;
+  return _current[_readPos];
+}
+
+void WiFiUDP::flush() {
+  _readPos = _current.size();
+}
+
+void WiFiUDP::hostDeliver(uint16_t port, const uint8_t *data, size_t length, IPAddress from, uint16_t fromPort) {
+  for (auto socket : sockets()) {
+    if (!socket->_bound || socket->_port != port) continue;
+    Packet packet;
+    packet.from = from;
+    packet.fromPort = fromPort;
+    packet.data.assign(data, data + length);
+    socket->_inbox.push_back(std::move(packet));
+  }
+}
+
+void WiFiUDP::hostOnSend(HostSendCallback cb) {
+  _sendCb = cb;
+}
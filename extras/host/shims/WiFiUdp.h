@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_WIFIUDP_H_
+#define _HOST_WIFIUDP_H_
+
+#include <deque>
+#include <vector>
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+/**
+ * @brief WiFiUDP stand-in backed by an in-process packet exchange
+ *
+ * Packets are injected with `hostDeliver()` and everything the library sends is handed
+ * to the callback registered with `hostOnSend()`.
+ **/
+class WiFiUDP : public Stream {
+  public:
+    typedef std::function<void(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, size_t length)> HostSendCallback;
+
+    WiFiUDP();
+    ~WiFiUDP();
+
+    uint8_t begin(uint16_t port);
+    uint8_t beginMulticast(IPAddress multicast, uint16_t port);
+    uint8_t beginMulticast(IPAddress interfaceAddr, IPAddress multicast, uint16_t port);
+    void stop();
+
+    int beginPacket(IPAddress ip, uint16_t port);
+    int endPacket();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    int parsePacket();
+    int available() override;
+    int read() override;
+    int read(unsigned char *buffer, size_t len);
+    int read(char *buffer, size_t len) { return read((unsigned char *) buffer, len); }
+    int peek() override;
+    void flush() override;
+
+    IPAddress remoteIP() { return _remoteIP; }
+    uint16_t remotePort() { return _remotePort; }
+
+    // host side
+    static void hostDeliver(uint16_t port, const uint8_t *data, size_t length, IPAddress from = IPAddress(127, 0, 0, 1), uint16_t fromPort = 40000);
+    static void hostOnSend(HostSendCallback cb);
+    static uint32_t hostJoinCount() { return _joinCount; }
+
+  private:
+    struct Packet {
+      IPAddress from;
+      uint16_t fromPort;
+      std::vector<uint8_t> data;
+    };
+
+    uint16_t _port = 0;
+    bool _bound = false;
+    std::deque<Packet> _inbox;
+    std::vector<uint8_t> _current;
+    size_t _readPos = 0;
+    IPAddress _remoteIP;
+    uint16_t _remotePort = 0;
+
+    std::vector<uint8_t> _outgoing;
+    IPAddress _sendIP;
+    uint16_t _sendPort = 0;
+
+    static std::vector<WiFiUDP *> &sockets();
+    static HostSendCallback _sendCb;
+    static uint32_t _joinCount;
+};
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _HOST_PGMSPACE_H_
+#define _HOST_PGMSPACE_H_
+
+#include <string.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+#define PGM_P const char *
+#define pgm_read_byte(addr) (*(const unsigned char *) (addr))
+#define pgm_read_word(addr) (*(const unsigned short *) (addr))
+#define pgm_read_dword(addr) (*(const unsigned long *) (addr))
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef _AIRQUALITYSENSOR_H_
 #define _AIRQUALITYSENSOR_H_
 
+#include "SinricProStrings.h"
+
+FSTR(AIRQUALITYSENSOR, airQuality);
+
 /**
  * @brief AirQuality
  * @ingroup Capabilities
@@ -8,7 +12,8 @@
 template <typename T>
 class AirQualitySensor {
   public:
-    bool sendAirQualityEvent(int pm1 = 0, int pm2_5 = 0, int pm10 = 0, String cause = "PERIODIC_POLL");
+    bool sendAirQualityEvent(int pm1 = 0, int pm2_5 = 0, int pm10 = 0, const char* cause = FSTR_SINRICPRO_PERIODIC_POLL);
+    bool sendAirQualityEvent(int pm1, int pm2_5, int pm10, const String& cause);
 };
 
 /**
@@ -17,16 +22,16 @@ class AirQualitySensor {
  * @param   pm1           `int` 1.0 μm particle pollutant	in μg/m3
  * @param   pm2_5         `int` 2.5 μm particle pollutant	in μg/m3
  * @param   pm10          `int` 10 μm particle pollutant in μg/m3
- * @param   cause         (optional) `String` reason why event is sent (default = `"PERIODIC_POLL"`)
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PERIODIC_POLL"`)
  * @return  the success of sending the event
  * @retval  true          event has been sent successfully
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool AirQualitySensor<T>::sendAirQualityEvent(int pm1, int pm2_5, int pm10, String cause) {
+bool AirQualitySensor<T>::sendAirQualityEvent(int pm1, int pm2_5, int pm10, const char* cause) {
   T& device = static_cast<T&>(*this);
   
-  DynamicJsonDocument eventMessage = device.prepareEvent("airQuality", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_AIRQUALITYSENSOR_airQuality, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
 
   event_value["pm1"] = pm1;
@@ -36,4 +41,12 @@ bool AirQualitySensor<T>::sendAirQualityEvent(int pm1, int pm2_5, int pm10, Stri
   return device.sendEvent(eventMessage);
 }
 
+/**
+ * @brief Same as sendAirQualityEvent() with the cause as `String`
+ **/
+template <typename T>
+bool AirQualitySensor<T>::sendAirQualityEvent(int pm1, int pm2_5, int pm10, const String& cause) {
+  return sendAirQualityEvent(pm1, pm2_5, pm10, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,10 @@
 #define _BRIGHTNESSCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(BRIGHTNESS, setBrightness);
+FSTR(BRIGHTNESS, adjustBrightness);
 
 /**
  * @brief BrightnessController
@@ -10,7 +14,7 @@
 template <typename T>
 class BrightnessController {
   public:
-    BrightnessController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&BrightnessController<T>::handleBrightnessController, this, std::placeholders::_1)); }
+    BrightnessController() { static_cast<T &>(*this).template addActionHandler<T, BrightnessController<T>, &BrightnessController<T>::handleBrightnessController>({FSTR_BRIGHTNESS_setBrightness, FSTR_BRIGHTNESS_adjustBrightness}); }
     /**
      * @brief Callback definition for onBrightness function
      * 
@@ -44,7 +48,8 @@ class BrightnessController {
     void onBrightness(BrightnessCallback cb);
     void onAdjustBrightness(AdjustBrightnessCallback cb);
 
-    bool sendBrightnessEvent(int brightness, String cause = "PHYSICAL_INTERACTION");
+    bool sendBrightnessEvent(int brightness, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendBrightnessEvent(int brightness, const String& cause);
   protected:
     bool handleBrightnessController(SinricProRequest &request);
 
@@ -82,16 +87,16 @@ void BrightnessController<T>::onAdjustBrightness(AdjustBrightnessCallback cb) {
  * @brief Send `setBrightness` event to SinricPro Server indicating actual brightness
  * 
  * @param brightness    Integer value with actual brightness the device is set to
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool BrightnessController<T>::sendBrightnessEvent(int brightness, String cause) {
+bool BrightnessController<T>::sendBrightnessEvent(int brightness, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setBrightness", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_BRIGHTNESS_setBrightness, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["brightness"] = brightness;
   return device.sendEvent(eventMessage);
@@ -102,13 +107,13 @@ bool BrightnessController<T>::handleBrightnessController(SinricProRequest &reque
   T &device = static_cast<T &>(*this);
   bool success = false;
 
-  if (brightnessCallback && request.action == "setBrightness") {
+  if (brightnessCallback && request.action == FSTR_BRIGHTNESS_setBrightness) {
     int brightness = request.request_value["brightness"];
     success = brightnessCallback(device.deviceId, brightness);
     request.response_value["brightness"] = brightness;
   }
 
-  if (adjustBrightnessCallback && request.action == "adjustBrightness") {
+  if (adjustBrightnessCallback && request.action == FSTR_BRIGHTNESS_adjustBrightness) {
     int brightnessDelta = request.request_value["brightnessDelta"];
     success = adjustBrightnessCallback(device.deviceId, brightnessDelta);
     request.response_value["brightness"] = brightnessDelta;
@@ -117,4 +122,12 @@ bool BrightnessController<T>::handleBrightnessController(SinricProRequest &reque
   return success;
 }
 
+/**
+ * @brief Same as sendBrightnessEvent() with the cause as `String`
+ **/
+template <typename T>
+bool BrightnessController<T>::sendBrightnessEvent(int brightness, const String& cause) {
+  return sendBrightnessEvent(brightness, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,10 @@
 #define _CHANNELCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(CHANNEL, changeChannel);
+FSTR(CHANNEL, skipChannels);
 
 /**
  * @brief ChannelController
@@ -10,7 +14,7 @@
 template <typename T>
 class ChannelController {
   public:
-    ChannelController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&ChannelController<T>::handleChannelController, this, std::placeholders::_1)); }
+    ChannelController() { static_cast<T &>(*this).template addActionHandler<T, ChannelController<T>, &ChannelController<T>::handleChannelController>({FSTR_CHANNEL_changeChannel, FSTR_CHANNEL_skipChannels}); }
     /**
      * @brief Callback definition for onChangeChannel function
      * 
@@ -63,7 +67,8 @@ class ChannelController {
     void onChangeChannelNumber(ChangeChannelNumberCallback cb);
     void onSkipChannels(SkipChannelsCallback cb);
 
-    bool sendChangeChannelEvent(String channelName, String cause = "PHYSICAL_INTERACTION");
+    bool sendChangeChannelEvent(const String& channelName, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendChangeChannelEvent(const String& channelName, const String& cause);
   protected:
     bool handleChannelController(SinricProRequest &request);
 
@@ -114,16 +119,16 @@ void ChannelController<T>::onSkipChannels(SkipChannelsCallback cb) {
  * @brief Send `changeChannel` event to SinricPro Server to report selected channel
  * 
  * @param channelName     String with actual channel
- * @param cause           (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause           (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ChannelController<T>::sendChangeChannelEvent(String channelName, String cause) {
+bool ChannelController<T>::sendChangeChannelEvent(const String& channelName, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("changeChannel", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_CHANNEL_changeChannel, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["channel"]["name"] = channelName;
   return device.sendEvent(eventMessage);
@@ -135,7 +140,7 @@ bool ChannelController<T>::handleChannelController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (request.action == "changeChannel") {
+  if (request.action == FSTR_CHANNEL_changeChannel) {
 
     if (changeChannelCallback && request.request_value["channel"].containsKey("name")) {
       String channelName = request.request_value["channel"]["name"] | "";
@@ -152,7 +157,7 @@ bool ChannelController<T>::handleChannelController(SinricProRequest &request) {
     return success;
   }
 
-  if (skipChannelsCallback && request.action == "skipChannels") {
+  if (skipChannelsCallback && request.action == FSTR_CHANNEL_skipChannels) {
     int channelCount = request.request_value["channelCount"] | 0;
     String channelName;
     success = skipChannelsCallback(device.deviceId, channelCount, channelName);
@@ -163,4 +168,12 @@ bool ChannelController<T>::handleChannelController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendChangeChannelEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ChannelController<T>::sendChangeChannelEvent(const String& channelName, const String& cause) {
+  return sendChangeChannelEvent(channelName, cause.c_str());
+}
+
 #endif
\ No newline at end of file
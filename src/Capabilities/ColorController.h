@@ -2,6 +2,9 @@
 #define _COLORCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(COLOR, setColor);
 
 /**
  * @brief ColorController
@@ -10,7 +13,7 @@
 template <typename T>
 class ColorController {
   public:
-    ColorController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&ColorController<T>::handleColorController, this, std::placeholders::_1)); }
+    ColorController() { static_cast<T &>(*this).template addActionHandler<T, ColorController<T>, &ColorController<T>::handleColorController>({FSTR_COLOR_setColor}); }
     /**
      * @brief Callback definition for onColor function
      * 
@@ -31,7 +34,8 @@ class ColorController {
     using ColorCallback = std::function<bool(const String &, byte &, byte &, byte &)>;
 
     void onColor(ColorCallback cb);
-    bool sendColorEvent(byte r, byte g, byte b, String cause = "PHYSICAL_INTERACTION");
+    bool sendColorEvent(byte r, byte g, byte b, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendColorEvent(byte r, byte g, byte b, const String& cause);
 
   protected:
     bool handleColorController(SinricProRequest &request);
@@ -59,16 +63,16 @@ void ColorController<T>::onColor(ColorCallback cb) {
  * @param r       Byte value for red
  * @param g       Byte value for green
  * @param b       Byte value for blue
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ColorController<T>::sendColorEvent(byte r, byte g, byte b, String cause) {
+bool ColorController<T>::sendColorEvent(byte r, byte g, byte b, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setColor", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_COLOR_setColor, cause);
   JsonObject event_color = eventMessage["payload"]["value"].createNestedObject("color");
   event_color["r"] = r;
   event_color["g"] = g;
@@ -82,7 +86,7 @@ bool ColorController<T>::handleColorController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (colorCallback && request.action == "setColor") {
+  if (colorCallback && request.action == FSTR_COLOR_setColor) {
     unsigned char r, g, b;
     r = request.request_value["color"]["r"];
     g = request.request_value["color"]["g"];
@@ -97,4 +101,12 @@ bool ColorController<T>::handleColorController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendColorEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ColorController<T>::sendColorEvent(byte r, byte g, byte b, const String& cause) {
+  return sendColorEvent(r, g, b, cause.c_str());
+}
+
 #endif
\ No newline at end of file
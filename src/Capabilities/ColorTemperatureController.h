@@ -2,6 +2,11 @@
 #define _COLORTEMPERATURECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(COLORTEMPERATURE, setColorTemperature);
+FSTR(COLORTEMPERATURE, increaseColorTemperature);
+FSTR(COLORTEMPERATURE, decreaseColorTemperature);
 
 /**
  * @brief ColorTemperatureController
@@ -10,7 +15,7 @@
 template <typename T>
 class ColorTemperatureController {
   public:
-    ColorTemperatureController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&ColorTemperatureController<T>::handleColorTemperatureController, this, std::placeholders::_1)); }
+    ColorTemperatureController() { static_cast<T &>(*this).template addActionHandler<T, ColorTemperatureController<T>, &ColorTemperatureController<T>::handleColorTemperatureController>({FSTR_COLORTEMPERATURE_setColorTemperature, FSTR_COLORTEMPERATURE_increaseColorTemperature, FSTR_COLORTEMPERATURE_decreaseColorTemperature}); }
     /**
      * @brief Callback definition for onColorTemperature function
      * 
@@ -60,7 +65,8 @@ class ColorTemperatureController {
     void onIncreaseColorTemperature(IncreaseColorTemperatureCallback cb);
     void onDecreaseColorTemperature(DecreaseColorTemperatureCallback cb);
 
-    bool sendColorTemperatureEvent(int colorTemperature, String cause = "PHYSICAL_INTERACTION");
+    bool sendColorTemperatureEvent(int colorTemperature, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendColorTemperatureEvent(int colorTemperature, const String& cause);
 
   protected:
     bool handleColorTemperatureController(SinricProRequest &request);
@@ -111,16 +117,16 @@ void ColorTemperatureController<T>::onDecreaseColorTemperature(DecreaseColorTemp
  * @brief Send `setColorTemperature` event to SinricPro Server indicating actual color temperature
  * 
  * @param colorTemperature Integer with new color temperature the device is set to \n `2200` = warm white \n `2700` = soft white \n `4000` = white \n `5500` = daylight white \n `7000` = cool white
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ColorTemperatureController<T>::sendColorTemperatureEvent(int colorTemperature, String cause) {
+bool ColorTemperatureController<T>::sendColorTemperatureEvent(int colorTemperature, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setColorTemperature", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_COLORTEMPERATURE_setColorTemperature, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["colorTemperature"] = colorTemperature;
   return device.sendEvent(eventMessage);
@@ -132,19 +138,19 @@ bool ColorTemperatureController<T>::handleColorTemperatureController(SinricProRe
 
   bool success = false;
 
-  if (colorTemperatureCallback && request.action == "setColorTemperature") {
+  if (colorTemperatureCallback && request.action == FSTR_COLORTEMPERATURE_setColorTemperature) {
     int colorTemperature = request.request_value["colorTemperature"];
     success = colorTemperatureCallback(device.deviceId, colorTemperature);
     request.response_value["colorTemperature"] = colorTemperature;
   }
 
-  if (increaseColorTemperatureCallback && request.action == "increaseColorTemperature") {
+  if (increaseColorTemperatureCallback && request.action == FSTR_COLORTEMPERATURE_increaseColorTemperature) {
     int colorTemperature = 1;
     success = increaseColorTemperatureCallback(device.deviceId, colorTemperature);
     request.response_value["colorTemperature"] = colorTemperature;
   }
 
-  if (decreaseColorTemperatureCallback && request.action == "decreaseColorTemperature") {
+  if (decreaseColorTemperatureCallback && request.action == FSTR_COLORTEMPERATURE_decreaseColorTemperature) {
     int colorTemperature = -1;
     success = decreaseColorTemperatureCallback(device.deviceId, colorTemperature);
     request.response_value["colorTemperature"] = colorTemperature;
@@ -153,4 +159,12 @@ bool ColorTemperatureController<T>::handleColorTemperatureController(SinricProRe
   return success;
 }
 
+/**
+ * @brief Same as sendColorTemperatureEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ColorTemperatureController<T>::sendColorTemperatureEvent(int colorTemperature, const String& cause) {
+  return sendColorTemperatureEvent(colorTemperature, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -1,6 +1,10 @@
 #ifndef _CONTACTSENSOR_H_
 #define _CONTACTSENSOR_H_
 
+#include "SinricProStrings.h"
+
+FSTR(CONTACTSENSOR, setContactState);
+
 /**
  * @brief ContactSensor
  * @ingroup Capabilities
@@ -8,25 +12,50 @@
 template <typename T>
 class ContactSensor {
   public:
-    bool sendContactEvent(bool detected, String cause = "PHYSICAL_INTERACTION");
+    bool sendContactEvent(bool detected, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendContactEvent(bool detected, const String& cause);
+    bool postContactEvent(bool detected, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
 };
 
 /**
  * \brief Send `setContactState` event to SinricPro Server indicating actual power state
  * 
  * @param detected [in] `bool``true` = contact is closed \n [in] `false` = contact is open
- * @param cause [in] `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause [in] `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return `true` event has been sent successfully
  * @return `false` event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ContactSensor<T>::sendContactEvent(bool detected, String cause) {
+bool ContactSensor<T>::sendContactEvent(bool detected, const char* cause) {
   T& device = static_cast<T&>(*this);
   
-  DynamicJsonDocument eventMessage = device.prepareEvent("setContactState", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_CONTACTSENSOR_setContactState, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["state"] = detected ? "closed" : "open";
   return device.sendEvent(eventMessage);
 }
 
+/**
+ * @brief Queues a `setContactState` event which SinricPro.handle() sends like sendContactEvent() does
+ * 
+ * Safe to call from interrupt handlers and other tasks.
+ * @param   detected      `true` = contact is closed \n `false` = contact is open
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`), must stay valid until the event is sent
+ * @return  `true` event has been queued, `false` the device has not been added to SinricPro or all SINRICPRO_EVENT_INTAKE_SLOTS are in use
+ **/
+template <typename T>
+SINRICPRO_ISR_ATTR bool ContactSensor<T>::postContactEvent(bool detected, const char* cause) {
+  return static_cast<T&>(*this).postEvent([](SinricProDevice& device, const SinricProPostedEvent& event) {
+    return static_cast<T&>(device).sendContactEvent(event.state, event.cause);
+  }, cause, detected);
+}
+
+/**
+ * @brief Same as sendContactEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ContactSensor<T>::sendContactEvent(bool detected, const String& cause) {
+  return sendContactEvent(detected, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -1,6 +1,10 @@
 #ifndef _DOORBELL_H_
 #define _DOORBELL_H_
 
+#include "SinricProStrings.h"
+
+FSTR(DOORBELL, DoorbellPress);
+
 /**
  * @brief Dorbell
  * @ingroup Capabilities
@@ -8,25 +12,49 @@
 template <typename T>
 class Doorbell {
   public:
-    bool sendDoorbellEvent(String cause = "PHYSICAL_INTERACTION");
+    bool sendDoorbellEvent(const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendDoorbellEvent(const String& cause);
+    bool postDoorbellEvent(const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
 };
 
 /**
  * @brief Send Doorbell event to SinricPro Server indicating someone pressed the doorbell button
  * 
- * @param   cause         `String` (optional) Reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param   cause         `const char*` (optional) Reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return  the success of sending the event
  * @retval  true          event has been sent successfully
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool Doorbell<T>::sendDoorbellEvent(String cause) {
+bool Doorbell<T>::sendDoorbellEvent(const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("DoorbellPress", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_DOORBELL_DoorbellPress, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["state"] = "pressed";
   return device.sendEvent(eventMessage);
 }
 
+/**
+ * @brief Queues a `DoorbellPress` event which SinricPro.handle() sends like sendDoorbellEvent() does
+ * 
+ * Safe to call from interrupt handlers and other tasks.
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`), must stay valid until the event is sent
+ * @return  `true` event has been queued, `false` the device has not been added to SinricPro or all SINRICPRO_EVENT_INTAKE_SLOTS are in use
+ **/
+template <typename T>
+SINRICPRO_ISR_ATTR bool Doorbell<T>::postDoorbellEvent(const char* cause) {
+  return static_cast<T&>(*this).postEvent([](SinricProDevice& device, const SinricProPostedEvent& event) {
+    return static_cast<T&>(device).sendDoorbellEvent(event.cause);
+  }, cause);
+}
+
+/**
+ * @brief Same as sendDoorbellEvent() with the cause as `String`
+ **/
+template <typename T>
+bool Doorbell<T>::sendDoorbellEvent(const String& cause) {
+  return sendDoorbellEvent(cause.c_str());
+}
+
 #endif
\ No newline at end of file
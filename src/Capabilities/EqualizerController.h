@@ -2,6 +2,11 @@
 #define _EQUALIZERCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(EQUALIZER, setBands);
+FSTR(EQUALIZER, adjustBands);
+FSTR(EQUALIZER, resetBands);
 
 /**
  * @brief EqualizerController
@@ -10,7 +15,7 @@
 template <typename T>
 class EqualizerController {
 public:
-  EqualizerController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&EqualizerController<T>::handleEqualizerController, this, std::placeholders::_1)); }
+  EqualizerController() { static_cast<T &>(*this).template addActionHandler<T, EqualizerController<T>, &EqualizerController<T>::handleEqualizerController>({FSTR_EQUALIZER_setBands, FSTR_EQUALIZER_adjustBands, FSTR_EQUALIZER_resetBands}); }
   /**
      * @brief Callback definition for onSetBands function
      * 
@@ -68,7 +73,8 @@ public:
   void onAdjustBands(AdjustBandsCallback cb);
   void onResetBands(ResetBandsCallback cb);
 
-  bool sendBandsEvent(String bands, int level, String cause = "PHYSICAL_INTERACTION");
+  bool sendBandsEvent(const String& bands, int level, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+  bool sendBandsEvent(const String& bands, int level, const String& cause);
 
 protected:
   bool handleEqualizerController(SinricProRequest &request);
@@ -114,16 +120,16 @@ void EqualizerController<T>::onResetBands(ResetBandsCallback cb) { resetBandsCal
  * 
  * @param bands   String which bands has changed \n `BASS`, `MIDRANGE`, `TREBBLE`
  * @param level   Integer with changed bands level
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool EqualizerController<T>::sendBandsEvent(String bands, int level, String cause) {
+bool EqualizerController<T>::sendBandsEvent(const String& bands, int level, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setBands", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_EQUALIZER_setBands, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   JsonArray event_value_bands = event_value.createNestedArray("bands");
   JsonObject event_bands = event_value_bands.createNestedObject();
@@ -137,7 +143,7 @@ bool EqualizerController<T>::handleEqualizerController(SinricProRequest &request
   T &device = static_cast<T &>(*this);
   bool success = false;
 
-  if (setBandsCallback && request.action == "setBands") {
+  if (setBandsCallback && request.action == FSTR_EQUALIZER_setBands) {
     JsonArray bands_array = request.request_value["bands"];
     JsonArray response_value_bands = request.response_value.createNestedArray("bands");
 
@@ -152,7 +158,7 @@ bool EqualizerController<T>::handleEqualizerController(SinricProRequest &request
     return success;
   }
 
-  if (adjustBandsCallback && request.action == "adjustBands") {
+  if (adjustBandsCallback && request.action == FSTR_EQUALIZER_adjustBands) {
     JsonArray bands_array = request.request_value["bands"];
     JsonArray response_value_bands = request.response_value.createNestedArray("bands");
 
@@ -170,7 +176,7 @@ bool EqualizerController<T>::handleEqualizerController(SinricProRequest &request
     return success;
   }
 
-  if (resetBandsCallback && request.action == "resetBands") {
+  if (resetBandsCallback && request.action == FSTR_EQUALIZER_resetBands) {
     JsonArray bands_array = request.request_value["bands"];
     JsonArray response_value_bands = request.response_value.createNestedArray("bands");
 
@@ -188,4 +194,12 @@ bool EqualizerController<T>::handleEqualizerController(SinricProRequest &request
   return success;
 }
 
+/**
+ * @brief Same as sendBandsEvent() with the cause as `String`
+ **/
+template <typename T>
+bool EqualizerController<T>::sendBandsEvent(const String& bands, int level, const String& cause) {
+  return sendBandsEvent(bands, level, cause.c_str());
+}
+
 #endif
\ No newline at end of file
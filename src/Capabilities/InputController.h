@@ -2,6 +2,9 @@
 #define _INPUTCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(INPUT, selectInput);
 
 /**
  * @brief InputController
@@ -10,7 +13,7 @@
 template <typename T>
 class InputController {
   public:
-    InputController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&InputController<T>::handleInputController, this, std::placeholders::_1)); }
+    InputController() { static_cast<T &>(*this).template addActionHandler<T, InputController<T>, &InputController<T>::handleInputController>({FSTR_INPUT_selectInput}); }
     /**
      * @brief Callback definition for onSelectInput function
      * 
@@ -28,7 +31,8 @@ class InputController {
     using SelectInputCallback = std::function<bool(const String &, String &)>;
 
     void onSelectInput(SelectInputCallback cb);
-    bool sendSelectInputEvent(String intput, String cause = "PHYSICAL_INTERACTION");
+    bool sendSelectInputEvent(const String& intput, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendSelectInputEvent(const String& intput, const String& cause);
 
   protected:
     bool handleInputController(SinricProRequest &request);
@@ -53,16 +57,16 @@ void InputController<T>::onSelectInput(SelectInputCallback cb) {
  * @brief Send `selectInput` event to SinricPro Server to report selected input
  * 
  * @param input           String with actual media control \n `AUX 1`..`AUX 7`, `BLURAY`, `CABLE`, `CD`, `COAX 1`,`COAX 2`, `COMPOSITE 1`, `DVD`, `GAME`, `HD RADIO`, `HDMI 1`.. `HDMI 10`, `HDMI ARC`, `INPUT 1`..`INPUT 10`, `IPOD`, `LINE 1`..`LINE 7`, `MEDIA PLAYER`, `OPTICAL 1`, `OPTICAL 2`, `PHONO`, `PLAYSTATION`, `PLAYSTATION 3`, `PLAYSTATION 4`, `SATELLITE`, `SMARTCAST`, `TUNER`, `TV`, `USB DAC`, `VIDEO 1`..`VIDEO 3`, `XBOX`
- * @param cause           (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause           (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool InputController<T>::sendSelectInputEvent(String input, String cause) {
+bool InputController<T>::sendSelectInputEvent(const String& input, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("selectInput", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_INPUT_selectInput, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["input"] = input;
   return device.sendEvent(eventMessage);
@@ -74,7 +78,7 @@ bool InputController<T>::handleInputController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (selectInputCallback && request.action == "selectInput") {
+  if (selectInputCallback && request.action == FSTR_INPUT_selectInput) {
     String input = request.request_value["input"];
     success = selectInputCallback(device.deviceId, input);
     request.response_value["input"] = input;
@@ -84,4 +88,12 @@ bool InputController<T>::handleInputController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendSelectInputEvent() with the cause as `String`
+ **/
+template <typename T>
+bool InputController<T>::sendSelectInputEvent(const String& intput, const String& cause) {
+  return sendSelectInputEvent(intput, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define _KEYPADCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(KEYPAD, SendKeystroke);
 
 /**
  * @brief KeypadController
@@ -10,7 +13,7 @@
 template <typename T>
 class KeypadController {
   public:
-    KeypadController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&KeypadController<T>::handleKeypadController, this, std::placeholders::_1)); }
+    KeypadController() { static_cast<T &>(*this).template addActionHandler<T, KeypadController<T>, &KeypadController<T>::handleKeypadController>({FSTR_KEYPAD_SendKeystroke}); }
     /**
      * @brief Callback definition for onKeystroke function
      * 
@@ -52,7 +55,7 @@ bool KeypadController<T>::handleKeypadController(SinricProRequest &request) {
   T &device = static_cast<T &>(*this);
 
   bool success = false;
-  if (request.action != "SendKeystroke") return false;
+  if (request.action != FSTR_KEYPAD_SendKeystroke) return false;
 
   if (keystrokeCallback) {
     String keystroke = request.request_value["keystroke"] | "";
@@ -2,6 +2,9 @@
 #define _LOCKCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(LOCK, setLockState);
 
 /**
  * @brief LockController
@@ -10,7 +13,7 @@
 template <typename T>
 class LockController {
   public:
-    LockController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&LockController<T>::handleLockController, this, std::placeholders::_1)); }
+    LockController() { static_cast<T &>(*this).template addActionHandler<T, LockController<T>, &LockController<T>::handleLockController>({FSTR_LOCK_setLockState}); }
     /**
      * @brief Callback definition for onLockState function
      * 
@@ -33,7 +36,8 @@ class LockController {
     using LockStateCallback = std::function<bool(const String &, bool &)>; // void onLockState(const DeviceId &deviceId, bool& lockState);
 
     void onLockState(LockStateCallback cb);
-    bool sendLockStateEvent(bool state, String cause = "PHYSICAL_INTERACTION");
+    bool sendLockStateEvent(bool state, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendLockStateEvent(bool state, const String& cause);
 
   protected:
     bool handleLockController(SinricProRequest &request);
@@ -58,16 +62,16 @@ void LockController<T>::onLockState(LockStateCallback cb) {
  * @brief Send `lockState` event to SinricPro Server indicating actual lock state
  * 
  * @param state   `true` = device is locked \n `false` = device is unlocked
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool LockController<T>::sendLockStateEvent(bool state, String cause) {
+bool LockController<T>::sendLockStateEvent(bool state, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setLockState", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_LOCK_setLockState, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   state ? event_value["state"] = "LOCKED" : event_value["state"] = "UNLOCKED";
   return device.sendEvent(eventMessage);
@@ -79,7 +83,7 @@ bool LockController<T>::handleLockController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (request.action == "setLockState" && lockStateCallback)  {
+  if (request.action == FSTR_LOCK_setLockState && lockStateCallback)  {
     bool lockState = request.request_value["state"] == "lock" ? true : false;
     success = lockStateCallback(device.deviceId, lockState);
     request.response_value["state"] = success ? lockState ? "LOCKED" : "UNLOCKED" : "JAMMED";
@@ -88,4 +92,12 @@ bool LockController<T>::handleLockController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendLockStateEvent() with the cause as `String`
+ **/
+template <typename T>
+bool LockController<T>::sendLockStateEvent(bool state, const String& cause) {
+  return sendLockStateEvent(state, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define _MEDIACONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(MEDIA, mediaControl);
 
 /**
  * @brief MediaController
@@ -10,7 +13,7 @@
 template <typename T>
 class MediaController {
   public:
-    MediaController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&MediaController<T>::handleMediaController, this, std::placeholders::_1)); }
+    MediaController() { static_cast<T &>(*this).template addActionHandler<T, MediaController<T>, &MediaController<T>::handleMediaController>({FSTR_MEDIA_mediaControl}); }
     /**
      * @brief Callback definition for onMediaControl function
      * 
@@ -28,7 +31,8 @@ class MediaController {
     using MediaControlCallback = std::function<bool(const String &, String &)>;
 
     void onMediaControl(MediaControlCallback cb);
-    bool sendMediaControlEvent(String mediaControl, String cause = "PHYSICAL_INTERACTION");
+    bool sendMediaControlEvent(const String& mediaControl, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendMediaControlEvent(const String& mediaControl, const String& cause);
 
   protected:
     bool handleMediaController(SinricProRequest &request);
@@ -53,16 +57,16 @@ void MediaController<T>::onMediaControl(MediaControlCallback cb) {
  * @brief Send `mediaControl` event to SinricPro Server indicating devices media control state
  * 
  * @param mediaControl    String with actual media control \n `FastForward`, `Next`, `Pause`, `Play`, `Previous`, `Rewind`, `StartOver`, `Stop`
- * @param cause           (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause           (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool MediaController<T>::sendMediaControlEvent(String mediaControl, String cause) {
+bool MediaController<T>::sendMediaControlEvent(const String& mediaControl, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("mediaControl", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_MEDIA_mediaControl, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["control"] = mediaControl;
   return device.sendEvent(eventMessage);
@@ -74,7 +78,7 @@ bool MediaController<T>::handleMediaController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (mediaControlCallback && request.action == "mediaControl") {
+  if (mediaControlCallback && request.action == FSTR_MEDIA_mediaControl) {
     String mediaControl = request.request_value["control"];
     success = mediaControlCallback(device.deviceId, mediaControl);
     request.response_value["control"] = mediaControl;
@@ -84,4 +88,12 @@ bool MediaController<T>::handleMediaController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendMediaControlEvent() with the cause as `String`
+ **/
+template <typename T>
+bool MediaController<T>::sendMediaControlEvent(const String& mediaControl, const String& cause) {
+  return sendMediaControlEvent(mediaControl, cause.c_str());
+}
+
 #endif
\ No newline at end of file
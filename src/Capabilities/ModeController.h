@@ -2,6 +2,11 @@
 #define _MODECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+#include <map>
+
+FSTR(MODE, setMode);
 
 /**
  * @brief ModeController
@@ -10,7 +15,7 @@
 template <typename T>
 class ModeController {
   public:
-    ModeController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&ModeController<T>::handleModeController, this, std::placeholders::_1)); }
+    ModeController() { static_cast<T &>(*this).template addActionHandler<T, ModeController<T>, &ModeController<T>::handleModeController>({FSTR_MODE_setMode}); }
     /**
      * @brief Callback definition for onSetMode function
      * 
@@ -47,8 +52,10 @@ class ModeController {
     void onSetMode(ModeCallback cb);
     void onSetMode(const String& instance, GenericModeCallback cb);
 
-    bool sendModeEvent(String mode, String cause = "PHYSICAL_INTERACTION");
-    bool sendModeEvent(String instance, String mode, String cause = "PHYSICAL_INTERACTION");
+    bool sendModeEvent(const String& mode, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendModeEvent(const String& instance, const String& mode, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendModeEvent(const String& instance, const String& mode, const String& cause);
+    bool sendModeEvent(const String& mode, const String& cause) = delete;  // could be (instance, mode) as well: pass a String cause as cause.c_str()
 
   protected:
     bool handleModeController(SinricProRequest &request);
@@ -85,16 +92,16 @@ void ModeController<T>::onSetMode(const String& instance, GenericModeCallback cb
  * @brief Send `setMode` event to SinricPro Server indicating the mode has changed
  * 
  * @param mode    String with actual mode device is set to \n `MOVIE`, `MUSIC`, `NIGHT`, `SPORT`, `TV`
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ModeController<T>::sendModeEvent(String mode, String cause) {
+bool ModeController<T>::sendModeEvent(const String& mode, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setMode", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_MODE_setMode, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["mode"] = mode;
   return device.sendEvent(eventMessage);
@@ -105,16 +112,16 @@ bool ModeController<T>::sendModeEvent(String mode, String cause) {
  * 
  * @param instance String instance name
  * @param mode    String with actual mode device is set to \n `MOVIE`, `MUSIC`, `NIGHT`, `SPORT`, `TV`
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ModeController<T>::sendModeEvent(String instance, String mode, String cause) {
+bool ModeController<T>::sendModeEvent(const String& instance, const String& mode, const char* cause) {
   T &device = static_cast<T &>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setMode", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_MODE_setMode, cause);
   eventMessage["payload"]["instanceId"] = instance;
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["mode"] = mode;
@@ -126,7 +133,7 @@ bool ModeController<T>::handleModeController(SinricProRequest &request) {
   T &device = static_cast<T &>(*this);
 
   bool success = false;
-  if (request.action != "setMode") return false;
+  if (request.action != FSTR_MODE_setMode) return false;
   String mode = request.request_value["mode"] | "";
 
   if (request.instance != "") {
@@ -146,4 +153,12 @@ bool ModeController<T>::handleModeController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendModeEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ModeController<T>::sendModeEvent(const String& instance, const String& mode, const String& cause) {
+  return sendModeEvent(instance, mode, cause.c_str());
+}
+
 #endif
\ No newline at end of file
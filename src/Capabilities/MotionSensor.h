@@ -1,6 +1,10 @@
 #ifndef _MOTIONSENSOR_H_
 #define _MOTIONSENSOR_H_
 
+#include "SinricProStrings.h"
+
+FSTR(MOTIONSENSOR, motion);
+
 /**
  * @brief MotionSensor
  * @ingroup Capabilities
@@ -8,26 +12,51 @@
 template <typename T>
 class MotionSensor {
   public:
-    bool sendMotionEvent(bool detected, String cause = "PHYSICAL_INTERACTION");
+    bool sendMotionEvent(bool detected, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendMotionEvent(bool detected, const String& cause);
+    bool postMotionEvent(bool detected, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
 };
 
 /**
  * @brief Sending motion detection state to SinricPro server
  * 
  * @param   detected      `bool` `true` if motion has been detected \n 'false' if no motion has been detected
- * @param   cause         (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return  the success of sending the event
  * @retval  true          event has been sent successfully
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool MotionSensor<T>::sendMotionEvent(bool detected, String cause) {
+bool MotionSensor<T>::sendMotionEvent(bool detected, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("motion", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_MOTIONSENSOR_motion, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["state"] = detected ? "detected" : "notDetected";
   return device.sendEvent(eventMessage);
 }
 
+/**
+ * @brief Queues a `motion` event which SinricPro.handle() sends like sendMotionEvent() does
+ * 
+ * Safe to call from interrupt handlers and other tasks.
+ * @param   detected      `true` if motion has been detected \n `false` if no motion has been detected
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`), must stay valid until the event is sent
+ * @return  `true` event has been queued, `false` the device has not been added to SinricPro or all SINRICPRO_EVENT_INTAKE_SLOTS are in use
+ **/
+template <typename T>
+SINRICPRO_ISR_ATTR bool MotionSensor<T>::postMotionEvent(bool detected, const char* cause) {
+  return static_cast<T&>(*this).postEvent([](SinricProDevice& device, const SinricProPostedEvent& event) {
+    return static_cast<T&>(device).sendMotionEvent(event.state, event.cause);
+  }, cause, detected);
+}
+
+/**
+ * @brief Same as sendMotionEvent() with the cause as `String`
+ **/
+template <typename T>
+bool MotionSensor<T>::sendMotionEvent(bool detected, const String& cause) {
+  return sendMotionEvent(detected, cause.c_str());
+}
+
 #endif
\ No newline at end of file
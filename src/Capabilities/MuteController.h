@@ -2,6 +2,9 @@
 #define _MUTECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(MUTE, setMute);
 
 /**
  * @brief MuteController
@@ -10,7 +13,7 @@
 template <typename T>
 class MuteController {
   public:
-    MuteController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&MuteController<T>::handleMuteController, this, std::placeholders::_1)); }
+    MuteController() { static_cast<T &>(*this).template addActionHandler<T, MuteController<T>, &MuteController<T>::handleMuteController>({FSTR_MUTE_setMute}); }
     /**
      * @brief Callback definition for onMute function
      * 
@@ -28,7 +31,8 @@ class MuteController {
     using MuteCallback = std::function<bool(const String &, bool &)>;
 
     void onMute(MuteCallback cb);
-    bool sendMuteEvent(bool mute, String cause = "PHYSICAL_INTERACTION");
+    bool sendMuteEvent(bool mute, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendMuteEvent(bool mute, const String& cause);
   protected:
     bool handleMuteController(SinricProRequest &request);
 
@@ -50,16 +54,16 @@ void MuteController<T>::onMute(MuteCallback cb) { muteCallback = cb; }
  * @brief Send `setMute` event to SinricPro Server indicating actual mute state
  * 
  * @param mute    `true` = device is muted on \n `false` = device is unmuted
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool MuteController<T>::sendMuteEvent(bool mute, String cause) {
+bool MuteController<T>::sendMuteEvent(bool mute, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setMute", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_MUTE_setMute, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["mute"] = mute;
   return device.sendEvent(eventMessage);
@@ -71,7 +75,7 @@ bool MuteController<T>::handleMuteController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (muteCallback && request.action == "setMute") {
+  if (muteCallback && request.action == FSTR_MUTE_setMute) {
     bool mute = request.request_value["mute"];
     success = muteCallback(device.deviceId, mute);
     request.response_value["mute"] = mute;
@@ -80,4 +84,12 @@ bool MuteController<T>::handleMuteController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendMuteEvent() with the cause as `String`
+ **/
+template <typename T>
+bool MuteController<T>::sendMuteEvent(bool mute, const String& cause) {
+  return sendMuteEvent(mute, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,10 @@
 #define _PERCENTAGECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(PERCENTAGE, setPercentage);
+FSTR(PERCENTAGE, adjustPercentage);
 
 /**
  * @brief PercentageController
@@ -10,7 +14,7 @@
 template <typename T>
 class PercentageController {
   public:
-    PercentageController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&PercentageController<T>::handlePercentageController, this, std::placeholders::_1)); }
+    PercentageController() { static_cast<T &>(*this).template addActionHandler<T, PercentageController<T>, &PercentageController<T>::handlePercentageController>({FSTR_PERCENTAGE_setPercentage, FSTR_PERCENTAGE_adjustPercentage}); }
     /**
      * @brief Callback definition for onSetPercentage function
      * 
@@ -46,7 +50,8 @@ class PercentageController {
     void onSetPercentage(SetPercentageCallback cb);
     void onAdjustPercentage(AdjustPercentageCallback cb);
 
-    bool sendSetPercentageEvent(int percentage, String cause = "PHYSICAL_INTERACTION");
+    bool sendSetPercentageEvent(int percentage, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendSetPercentageEvent(int percentage, const String& cause);
 
   protected:
     bool handlePercentageController(SinricProRequest &request);
@@ -86,10 +91,10 @@ void PercentageController<T>::onAdjustPercentage(AdjustPercentageCallback cb) {
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool PercentageController<T>::sendSetPercentageEvent(int percentage, String cause) {
+bool PercentageController<T>::sendSetPercentageEvent(int percentage, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setPercentage", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_PERCENTAGE_setPercentage, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["percentage"] = percentage;
   return device.sendEvent(eventMessage);
@@ -101,14 +106,14 @@ bool PercentageController<T>::handlePercentageController(SinricProRequest &reque
 
   bool success = false;
 
-  if (percentageCallback && request.action == "setPercentage") {
+  if (percentageCallback && request.action == FSTR_PERCENTAGE_setPercentage) {
     int percentage = request.request_value["percentage"];
     success = percentageCallback(device.deviceId, percentage);
     request.response_value["percentage"] = percentage;
     return success;
   }
 
-  if (adjustPercentageCallback && request.action == "adjustPercentage") {
+  if (adjustPercentageCallback && request.action == FSTR_PERCENTAGE_adjustPercentage) {
     int percentage = request.request_value["percentage"];
     success = adjustPercentageCallback(device.deviceId, percentage);
     request.response_value["percentage"] = percentage;
@@ -117,4 +122,12 @@ bool PercentageController<T>::handlePercentageController(SinricProRequest &reque
   return success;
 }
 
+/**
+ * @brief Same as sendSetPercentageEvent() with the cause as `String`
+ **/
+template <typename T>
+bool PercentageController<T>::sendSetPercentageEvent(int percentage, const String& cause) {
+  return sendSetPercentageEvent(percentage, cause.c_str());
+}
+
 #endif
\ No newline at end of file
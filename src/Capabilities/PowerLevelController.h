@@ -2,6 +2,10 @@
 #define _POWERLEVELCONTROLLER_H_
 
 #include "./SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(POWERLEVEL, setPowerLevel);
+FSTR(POWERLEVEL, adjustPowerLevel);
 
 /**
  * @brief PowerLevelController
@@ -10,7 +14,7 @@
 template <typename T>
 class PowerLevelController {
   public:
-    PowerLevelController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&PowerLevelController<T>::handlePowerLevelController, this, std::placeholders::_1)); }
+    PowerLevelController() { static_cast<T &>(*this).template addActionHandler<T, PowerLevelController<T>, &PowerLevelController<T>::handlePowerLevelController>({FSTR_POWERLEVEL_setPowerLevel, FSTR_POWERLEVEL_adjustPowerLevel}); }
     /**
      * @brief Definition for setPowerLevel callback
      * 
@@ -45,7 +49,8 @@ class PowerLevelController {
 
     void onPowerLevel(SetPowerLevelCallback cb);
     void onAdjustPowerLevel(AdjustPowerLevelCallback cb);
-    bool sendPowerLevelEvent(int powerLevel, String cause = "PHYSICAL_INTERACTION");
+    bool sendPowerLevelEvent(int powerLevel, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendPowerLevelEvent(int powerLevel, const String& cause);
 
   protected:
     bool handlePowerLevelController(SinricProRequest &request);
@@ -88,11 +93,11 @@ void PowerLevelController<T>::onAdjustPowerLevel(AdjustPowerLevelCallback cb)
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool PowerLevelController<T>::sendPowerLevelEvent(int powerLevel, String cause)
+bool PowerLevelController<T>::sendPowerLevelEvent(int powerLevel, const char* cause)
 {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setPowerLevel", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_POWERLEVEL_setPowerLevel, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["powerLevel"] = powerLevel;
   return device.sendEvent(eventMessage);
@@ -104,13 +109,13 @@ bool PowerLevelController<T>::handlePowerLevelController(SinricProRequest &reque
 
   bool success = false;
 
-  if (setPowerLevelCallback && request.action == "setPowerLevel") {
+  if (setPowerLevelCallback && request.action == FSTR_POWERLEVEL_setPowerLevel) {
     int powerLevel = request.request_value["powerLevel"];
     success = setPowerLevelCallback(device.deviceId, powerLevel);
     request.response_value["powerLevel"] = powerLevel;
   }
 
-  if (adjustPowerLevelCallback && request.action == "adjustPowerLevel") {
+  if (adjustPowerLevelCallback && request.action == FSTR_POWERLEVEL_adjustPowerLevel) {
     int powerLevelDelta = request.request_value["powerLevelDelta"];
     success = adjustPowerLevelCallback(device.deviceId, powerLevelDelta);
     request.response_value["powerLevel"] = powerLevelDelta;
@@ -118,4 +123,12 @@ bool PowerLevelController<T>::handlePowerLevelController(SinricProRequest &reque
   return success;
 }
 
+/**
+ * @brief Same as sendPowerLevelEvent() with the cause as `String`
+ **/
+template <typename T>
+bool PowerLevelController<T>::sendPowerLevelEvent(int powerLevel, const String& cause) {
+  return sendPowerLevelEvent(powerLevel, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -1,6 +1,10 @@
 #ifndef _POWERSENSOR_H_
 #define _POWERSENSOR_H_
 
+#include "SinricProStrings.h"
+
+FSTR(POWERSENSOR, powerUsage);
+
 /**
  * @brief PowerSensor
  * @ingroup Capabilities
@@ -8,7 +12,8 @@
 template <typename T>
 class PowerSensor {
 public:
-  bool sendPowerSensorEvent(float voltage, float current, float power = -1.0f, float apparentPower = -1.0f, float reactivePower = -1.0f, float factor = -1.0f, String cause = "PERIODIC_POLL");
+  bool sendPowerSensorEvent(float voltage, float current, float power = -1.0f, float apparentPower = -1.0f, float reactivePower = -1.0f, float factor = -1.0f, const char* cause = FSTR_SINRICPRO_PERIODIC_POLL);
+  bool sendPowerSensorEvent(float voltage, float current, float power, float apparentPower, float reactivePower, float factor, const String& cause);
 
 private:
   unsigned long startTime = 0;
@@ -24,16 +29,16 @@ private:
  * @param   apparentPower `float` (optional) if not provided it is set to -1
  * @param   reactivePower `float` (optional) if not provided it is set to -1
  * @param   factor        `float` (optional) if not provided it is set to -1 \n if apparentPower is provided, factor is calculated automaticly (factor = power / apparentPower)
- * @param   cause         `String` (optional) Reason why event is sent (default = `"PERIODIC_POLL"`)
+ * @param   cause         `const char*` (optional) Reason why event is sent (default = `"PERIODIC_POLL"`)
  * @return  the success of sending the event
  * @retval  true          event has been sent successfully
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool PowerSensor<T>::sendPowerSensorEvent(float voltage, float current, float power, float apparentPower, float reactivePower, float factor, String cause) {
+bool PowerSensor<T>::sendPowerSensorEvent(float voltage, float current, float power, float apparentPower, float reactivePower, float factor, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("powerUsage", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_POWERSENSOR_powerUsage, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   if (power == -1)
     power = voltage * current;
@@ -63,4 +68,12 @@ float PowerSensor<T>::getWattHours(unsigned long currentTimestamp) {
   return 0;
 }
 
+/**
+ * @brief Same as sendPowerSensorEvent() with the cause as `String`
+ **/
+template <typename T>
+bool PowerSensor<T>::sendPowerSensorEvent(float voltage, float current, float power, float apparentPower, float reactivePower, float factor, const String& cause) {
+  return sendPowerSensorEvent(voltage, current, power, apparentPower, reactivePower, factor, cause.c_str());
+}
+
 #endif
\ No newline at end of file
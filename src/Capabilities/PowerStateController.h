@@ -2,6 +2,9 @@
 #define _POWERSTATECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(POWERSTATE, setPowerState);
 
 /**
  * @brief PowerStateController
@@ -10,7 +13,7 @@
 template <typename T>
 class PowerStateController {
   public:
-    PowerStateController() { static_cast<T&>(*this).requestHandlers.push_back(std::bind(&PowerStateController<T>::handlePowerStateController, this, std::placeholders::_1));}
+    PowerStateController() { static_cast<T &>(*this).template addActionHandler<T, PowerStateController<T>, &PowerStateController<T>::handlePowerStateController>({FSTR_POWERSTATE_setPowerState});}
     /**
      * @brief Callback definition for onPowerState function
      * 
@@ -27,7 +30,9 @@ class PowerStateController {
     using PowerStateCallback = std::function<bool(const String &, bool &)>;
 
     void onPowerState(PowerStateCallback cb);
-    bool sendPowerStateEvent(bool state, String cause = "PHYSICAL_INTERACTION");
+    bool sendPowerStateEvent(bool state, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendPowerStateEvent(bool state, const String& cause);
+    bool postPowerStateEvent(bool state, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
 
   protected:
     bool handlePowerStateController(SinricProRequest &request);
@@ -52,16 +57,16 @@ void PowerStateController<T>::onPowerState(PowerStateCallback cb) {
  * @brief Send `setPowerState` event to SinricPro Server indicating actual power state
  * 
  * @param state   `true` = device turned on \n `false` = device turned off
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool PowerStateController<T>::sendPowerStateEvent(bool state, String cause) {
+bool PowerStateController<T>::sendPowerStateEvent(bool state, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setPowerState", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_POWERSTATE_setPowerState, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["state"] = state ? "On" : "Off";
   return device.sendEvent(eventMessage);
@@ -73,7 +78,7 @@ bool PowerStateController<T>::handlePowerStateController(SinricProRequest &reque
 
   bool success = false;
 
-  if (request.action == "setPowerState" && powerStateCallback)  {
+  if (request.action == FSTR_POWERSTATE_setPowerState && powerStateCallback)  {
     bool powerState = request.request_value["state"] == "On" ? true : false;
 //    success = powerStateCallback(device.deviceId, powerState);
     success = powerStateCallback(device.deviceId, powerState);
@@ -83,4 +88,27 @@ bool PowerStateController<T>::handlePowerStateController(SinricProRequest &reque
   return success;
 }
 
+/**
+ * @brief Queues a `setPowerState` event which SinricPro.handle() sends like sendPowerStateEvent() does
+ * 
+ * Safe to call from interrupt handlers and other tasks.
+ * @param   state         `true` = device turned on \n `false` = device turned off
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`), must stay valid until the event is sent
+ * @return  `true` event has been queued, `false` the device has not been added to SinricPro or all SINRICPRO_EVENT_INTAKE_SLOTS are in use
+ **/
+template <typename T>
+SINRICPRO_ISR_ATTR bool PowerStateController<T>::postPowerStateEvent(bool state, const char* cause) {
+  return static_cast<T&>(*this).postEvent([](SinricProDevice& device, const SinricProPostedEvent& event) {
+    return static_cast<T&>(device).sendPowerStateEvent(event.state, event.cause);
+  }, cause, state);
+}
+
+/**
+ * @brief Same as sendPowerStateEvent() with the cause as `String`
+ **/
+template <typename T>
+bool PowerStateController<T>::sendPowerStateEvent(bool state, const String& cause) {
+  return sendPowerStateEvent(state, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,12 @@
 #define _RANGECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+#include <map>
+
+FSTR(RANGE, setRangeValue);
+FSTR(RANGE, adjustRangeValue);
 
 /**
  * @brief RangeController
@@ -10,7 +16,7 @@
 template <typename T>
 class RangeController {
   public:
-    RangeController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&RangeController<T>::handleRangeController, this, std::placeholders::_1)); }
+    RangeController() { static_cast<T &>(*this).template addActionHandler<T, RangeController<T>, &RangeController<T>::handleRangeController>({FSTR_RANGE_setRangeValue, FSTR_RANGE_adjustRangeValue}); }
     /**
      * @brief Callback definition for onRangeValue function
      * 
@@ -83,8 +89,10 @@ class RangeController {
     void onAdjustRangeValue(AdjustRangeValueCallback cb);
     void onAdjustRangeValue(const String& instance, GenericAdjustRangeValueCallback cb);
 
-    bool sendRangeValueEvent(int rangeValue, String cause = "PHYSICAL_INTERACTION");
-    bool sendRangeValueEvent(const String& instance, int rangeValue, String cause = "PHYSICAL_INTERACTION");
+    bool sendRangeValueEvent(int rangeValue, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendRangeValueEvent(int rangeValue, const String& cause);
+    bool sendRangeValueEvent(const String& instance, int rangeValue, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendRangeValueEvent(const String& instance, int rangeValue, const String& cause);
 
   protected:
     bool handleRangeController(SinricProRequest &request);
@@ -140,16 +148,16 @@ void RangeController<T>::onAdjustRangeValue(const String &instance, GenericAdjus
  * @brief Send `rangeValue` event to report curent rangeValue to SinricPro server
  * 
  * @param   rangeValue  Value between 0..3
- * @param   cause       (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param   cause       (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return  the success of sending the even
  * @retval  true        event has been sent successfully
  * @retval  false       event has not been sent, maybe you sent to much events in a short distance of time
  */
 template <typename T>
-bool RangeController<T>::sendRangeValueEvent(int rangeValue, String cause) {
+bool RangeController<T>::sendRangeValueEvent(int rangeValue, const char* cause) {
   T& device = static_cast<T&>(*this);
   
-  DynamicJsonDocument eventMessage = device.prepareEvent("setRangeValue", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_RANGE_setRangeValue, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["rangeValue"] = rangeValue;
   return device.sendEvent(eventMessage);
@@ -160,16 +168,16 @@ bool RangeController<T>::sendRangeValueEvent(int rangeValue, String cause) {
  * 
  * @param   instance    String instance name
  * @param   rangeValue  Value between 0..3
- * @param   cause       (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param   cause       (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return  the success of sending the even
  * @retval  true        event has been sent successfully
  * @retval  false       event has not been sent, maybe you sent to much events in a short distance of time
  */
 template <typename T>
-bool RangeController<T>::sendRangeValueEvent(const String& instance, int rangeValue, String cause){
+bool RangeController<T>::sendRangeValueEvent(const String& instance, int rangeValue, const char* cause){
   T &device = static_cast<T &>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setRangeValue", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_RANGE_setRangeValue, cause);
   eventMessage["payload"]["instanceId"] = instance;
 
   JsonObject event_value = eventMessage["payload"]["value"];
@@ -183,7 +191,7 @@ bool RangeController<T>::handleRangeController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (request.action == "setRangeValue") {
+  if (request.action == FSTR_RANGE_setRangeValue) {
     int rangeValue = request.request_value["rangeValue"] | 0;
     if (request.instance != "") {
       if (genericSetRangeValueCallback.find(request.instance) != genericSetRangeValueCallback.end()) 
@@ -195,7 +203,7 @@ bool RangeController<T>::handleRangeController(SinricProRequest &request) {
     return success;
   }
 
-  if (request.action == "adjustRangeValue") {
+  if (request.action == FSTR_RANGE_adjustRangeValue) {
     int rangeValueDelta = request.request_value["rangeValueDelta"] | 0;
     if (request.instance != "") {
       if (genericAdjustRangeValueCallback.find(request.instance) != genericAdjustRangeValueCallback.end()) 
@@ -212,4 +220,20 @@ bool RangeController<T>::handleRangeController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendRangeValueEvent() with the cause as `String`
+ **/
+template <typename T>
+bool RangeController<T>::sendRangeValueEvent(int rangeValue, const String& cause) {
+  return sendRangeValueEvent(rangeValue, cause.c_str());
+}
+
+/**
+ * @brief Same as sendRangeValueEvent() with the cause as `String`
+ **/
+template <typename T>
+bool RangeController<T>::sendRangeValueEvent(const String& instance, int rangeValue, const String& cause) {
+  return sendRangeValueEvent(instance, rangeValue, cause.c_str());
+}
+
 #endif
\ No newline at end of file
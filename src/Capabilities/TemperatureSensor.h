@@ -2,6 +2,10 @@
 #ifndef _TEMPERATURESENSOR_H_
 #define _TEMPERATURESENSOR_H_
 
+#include "SinricProStrings.h"
+
+FSTR(TEMPERATURESENSOR, currentTemperature);
+
 /**
  * @brief TemperatureSensor
  * @ingroup Capabilities
@@ -9,7 +13,9 @@
 template <typename T>
 class TemperatureSensor {
   public:
-    bool sendTemperatureEvent(float temperature, float humidity = -1, String cause = "PERIODIC_POLL");
+    bool sendTemperatureEvent(float temperature, float humidity = -1, const char* cause = FSTR_SINRICPRO_PERIODIC_POLL);
+    bool sendTemperatureEvent(float temperature, float humidity, const String& cause);
+    bool postTemperatureEvent(float temperature, float humidity = -1, const char* cause = FSTR_SINRICPRO_PERIODIC_POLL);
 };
 
 /**
@@ -17,20 +23,44 @@ class TemperatureSensor {
  * 
  * @param   temperature   `float` actual temperature measured by a sensor
  * @param   humidity      `float` (optional) actual humidity measured by a sensor (default=-1.0f means not supported)
- * @param   cause         (optional) `String` reason why event is sent (default = `"PERIODIC_POLL"`)
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PERIODIC_POLL"`)
  * @return  the success of sending the even
  * @retval  true          event has been sent successfully
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool TemperatureSensor<T>::sendTemperatureEvent(float temperature, float humidity, String cause) {
+bool TemperatureSensor<T>::sendTemperatureEvent(float temperature, float humidity, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("currentTemperature", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_TEMPERATURESENSOR_currentTemperature, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["humidity"] = roundf(humidity * 100) / 100.0;
   event_value["temperature"] = roundf(temperature * 10) / 10.0;
   return device.sendEvent(eventMessage);
 }
 
+/**
+ * @brief Queues a `currentTemperature` event which SinricPro.handle() sends like sendTemperatureEvent() does
+ * 
+ * Safe to call from interrupt handlers and other tasks.
+ * @param   temperature   `float` actual temperature measured by a sensor
+ * @param   humidity      `float` (optional) actual humidity measured by a sensor (default=-1.0f means not supported)
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PERIODIC_POLL"`), must stay valid until the event is sent
+ * @return  `true` event has been queued, `false` the device has not been added to SinricPro or all SINRICPRO_EVENT_INTAKE_SLOTS are in use
+ **/
+template <typename T>
+SINRICPRO_ISR_ATTR bool TemperatureSensor<T>::postTemperatureEvent(float temperature, float humidity, const char* cause) {
+  return static_cast<T&>(*this).postEvent([](SinricProDevice& device, const SinricProPostedEvent& event) {
+    return static_cast<T&>(device).sendTemperatureEvent(event.values[0], event.values[1], event.cause);
+  }, cause, false, temperature, humidity);
+}
+
+/**
+ * @brief Same as sendTemperatureEvent() with the cause as `String`
+ **/
+template <typename T>
+bool TemperatureSensor<T>::sendTemperatureEvent(float temperature, float humidity, const String& cause) {
+  return sendTemperatureEvent(temperature, humidity, cause.c_str());
+}
+
 #endif
\ No newline at end of file
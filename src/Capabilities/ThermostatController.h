@@ -2,6 +2,11 @@
 #define _THERMOSTATCONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(THERMOSTAT, targetTemperature);
+FSTR(THERMOSTAT, adjustTargetTemperature);
+FSTR(THERMOSTAT, setThermostatMode);
 
 /**
  * @brief ThermostatController
@@ -10,7 +15,7 @@
 template <typename T>
 class ThermostatController {
   public:
-    ThermostatController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&ThermostatController<T>::handleThermostatController, this, std::placeholders::_1)); }
+    ThermostatController() { static_cast<T &>(*this).template addActionHandler<T, ThermostatController<T>, &ThermostatController<T>::handleThermostatController>({FSTR_THERMOSTAT_targetTemperature, FSTR_THERMOSTAT_adjustTargetTemperature, FSTR_THERMOSTAT_setThermostatMode}); }
     /**
      * @brief Callback definition for onThermostatMode function
      * 
@@ -63,8 +68,10 @@ class ThermostatController {
     void onTargetTemperature(SetTargetTemperatureCallback cb);
     void onAdjustTargetTemperature(AdjustTargetTemperatureCallback cb);
 
-    bool sendThermostatModeEvent(String thermostatMode, String cause = "PHYSICAL_INTERACTION");
-    bool sendTargetTemperatureEvent(float temperature, String cause = "PHYSICAL_INTERACTION");
+    bool sendThermostatModeEvent(const String& thermostatMode, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendThermostatModeEvent(const String& thermostatMode, const String& cause);
+    bool sendTargetTemperatureEvent(float temperature, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendTargetTemperatureEvent(float temperature, const String& cause);
 
   protected:
     bool handleThermostatController(SinricProRequest &request);
@@ -115,16 +122,16 @@ void ThermostatController<T>::onAdjustTargetTemperature(AdjustTargetTemperatureC
  * @brief Send `thermostatMode` event to report a the new mode the device has been set to
  * 
  * @param   thermostatMode  String with actual mode (`AUTO`, `COOL`, `HEAT`) the device is set to
- * @param   cause           (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param   cause           (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return  the success of sending the even
  * @retval  true            event has been sent successfully
  * @retval  false           event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ThermostatController<T>::sendThermostatModeEvent(String thermostatMode, String cause) {
+bool ThermostatController<T>::sendThermostatModeEvent(const String& thermostatMode, const char* cause) {
   T &device = static_cast<T &>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setThermostatMode", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_THERMOSTAT_setThermostatMode, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["thermostatMode"] = thermostatMode;
   return device.sendEvent(eventMessage);
@@ -134,16 +141,16 @@ bool ThermostatController<T>::sendThermostatModeEvent(String thermostatMode, Str
  * @brief Send `targetTemperature` event to report target temperature change
  * 
  * @param   temperature   Float with actual target temperature the device is set to
- * @param   cause         (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param   cause         (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return  the success of sending the even
  * @retval  true          event has been sent successfully
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ThermostatController<T>::sendTargetTemperatureEvent(float temperature, String cause) {
+bool ThermostatController<T>::sendTargetTemperatureEvent(float temperature, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("targetTemperature", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_THERMOSTAT_targetTemperature, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["temperature"] = roundf(temperature * 10) / 10.0;
   return device.sendEvent(eventMessage);
@@ -155,7 +162,7 @@ bool ThermostatController<T>::handleThermostatController(SinricProRequest &reque
 
   bool success = false;
 
-  if (request.action == "targetTemperature" && targetTemperatureCallback) {
+  if (request.action == FSTR_THERMOSTAT_targetTemperature && targetTemperatureCallback) {
     float temperature;
     if (request.request_value.containsKey("temperature"))  {
       temperature = request.request_value["temperature"];
@@ -167,14 +174,14 @@ bool ThermostatController<T>::handleThermostatController(SinricProRequest &reque
     return success;
   }
 
-  if (request.action == "adjustTargetTemperature" && adjustTargetTemperatureCallback) {
+  if (request.action == FSTR_THERMOSTAT_adjustTargetTemperature && adjustTargetTemperatureCallback) {
     float temperatureDelta = request.request_value["temperature"];
     success = adjustTargetTemperatureCallback(device.deviceId, temperatureDelta);
     request.response_value["temperature"] = temperatureDelta;
     return success;
   }
 
-  if (request.action == "setThermostatMode" && thermostatModeCallback) {
+  if (request.action == FSTR_THERMOSTAT_setThermostatMode && thermostatModeCallback) {
     String thermostatMode = request.request_value["thermostatMode"] | "";
     success = thermostatModeCallback(device.deviceId, thermostatMode);
     request.response_value["thermostatMode"] = thermostatMode;
@@ -184,4 +191,20 @@ bool ThermostatController<T>::handleThermostatController(SinricProRequest &reque
   return success;
 }
 
+/**
+ * @brief Same as sendThermostatModeEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ThermostatController<T>::sendThermostatModeEvent(const String& thermostatMode, const String& cause) {
+  return sendThermostatModeEvent(thermostatMode, cause.c_str());
+}
+
+/**
+ * @brief Same as sendTargetTemperatureEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ThermostatController<T>::sendTargetTemperatureEvent(float temperature, const String& cause) {
+  return sendTargetTemperatureEvent(temperature, cause.c_str());
+}
+
 #endif
\ No newline at end of file
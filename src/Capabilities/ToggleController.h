@@ -2,6 +2,11 @@
 #define _TOGGLECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+#include <map>
+
+FSTR(TOGGLE, setToggleState);
 
 /**
  * @brief ToggleController
@@ -10,7 +15,7 @@
 template <typename T>
 class ToggleController {
 public:
-  ToggleController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&ToggleController<T>::handleToggleController, this, std::placeholders::_1)); }
+  ToggleController() { static_cast<T &>(*this).template addActionHandler<T, ToggleController<T>, &ToggleController<T>::handleToggleController>({FSTR_TOGGLE_setToggleState}); }
   /**
      * @brief Callback definition for onToggleState function
      * 
@@ -28,7 +33,8 @@ public:
   using GenericToggleStateCallback = std::function<bool(const String &, const String&, bool &)>;
 
   void onToggleState(const String& instance, GenericToggleStateCallback cb);
-  bool sendToggleStateEvent(const String &instance, bool state, String cause = "PHYSICAL_INTERACTION");
+  bool sendToggleStateEvent(const String &instance, bool state, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+  bool sendToggleStateEvent(const String &instance, bool state, const String& cause);
 
 protected:
   bool handleToggleController(SinricProRequest &request);
@@ -56,16 +62,16 @@ void ToggleController<T>::onToggleState(const String &instance, GenericToggleSta
  * 
  * @param instance String instance name (custom device)
  * @param state   `true` = state turned on \n `false` = tate turned off
- * @param cause   (optional) `String` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
+ * @param cause   (optional) `const char*` reason why event is sent (default = `"PHYSICAL_INTERACTION"`)
  * @return the success of sending the even
  * @retval true   event has been sent successfully
  * @retval false  event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool ToggleController<T>::sendToggleStateEvent(const String &instance, bool state, String cause) {
+bool ToggleController<T>::sendToggleStateEvent(const String &instance, bool state, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setToggleState", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_TOGGLE_setToggleState, cause);
   eventMessage["payload"]["instanceId"] = instance;
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["state"] = state ? "On" : "Off";
@@ -78,7 +84,7 @@ bool ToggleController<T>::handleToggleController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (request.action == "setToggleState")  {
+  if (request.action == FSTR_TOGGLE_setToggleState)  {
     bool powerState = request.request_value["state"] == "On" ? true : false;
     if (genericToggleStateCallback.find(request.instance) != genericToggleStateCallback.end())
       success = genericToggleStateCallback[request.instance](device.deviceId, request.instance, powerState);
@@ -88,4 +94,12 @@ bool ToggleController<T>::handleToggleController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendToggleStateEvent() with the cause as `String`
+ **/
+template <typename T>
+bool ToggleController<T>::sendToggleStateEvent(const String &instance, bool state, const String& cause) {
+  return sendToggleStateEvent(instance, state, cause.c_str());
+}
+
 #endif
\ No newline at end of file
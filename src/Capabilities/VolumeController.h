@@ -2,6 +2,10 @@
 #define _VOLUMECONTROLLER_H_
 
 #include "SinricProRequest.h"
+#include "SinricProStrings.h"
+
+FSTR(VOLUME, setVolume);
+FSTR(VOLUME, adjustVolume);
 
 /**
  * @brief VolumeController
@@ -10,7 +14,7 @@
 template <typename T>
 class VolumeController {
   public:
-    VolumeController() { static_cast<T &>(*this).requestHandlers.push_back(std::bind(&VolumeController<T>::handleVolumeController, this, std::placeholders::_1)); }
+    VolumeController() { static_cast<T &>(*this).template addActionHandler<T, VolumeController<T>, &VolumeController<T>::handleVolumeController>({FSTR_VOLUME_setVolume, FSTR_VOLUME_adjustVolume}); }
     /**
      * @brief Callback definition for onSetVolume function
      * 
@@ -47,7 +51,8 @@ class VolumeController {
     void onSetVolume(SetVolumeCallback cb);
     void onAdjustVolume(AdjustVolumeCallback cb);
 
-    bool sendVolumeEvent(int volume, String cause = "PHYSICAL_INTERACTION");
+    bool sendVolumeEvent(int volume, const char* cause = FSTR_SINRICPRO_PHYSICAL_INTERACTION);
+    bool sendVolumeEvent(int volume, const String& cause);
 
   protected:
     bool handleVolumeController(SinricProRequest &request);
@@ -87,10 +92,10 @@ void VolumeController<T>::onAdjustVolume(AdjustVolumeCallback cb) { adjustVolume
  * @retval  false         event has not been sent, maybe you sent to much events in a short distance of time
  **/
 template <typename T>
-bool VolumeController<T>::sendVolumeEvent(int volume, String cause) {
+bool VolumeController<T>::sendVolumeEvent(int volume, const char* cause) {
   T& device = static_cast<T&>(*this);
 
-  DynamicJsonDocument eventMessage = device.prepareEvent("setVolume", cause.c_str());
+  SinricProJsonDocument eventMessage = device.prepareEvent(FSTR_VOLUME_setVolume, cause);
   JsonObject event_value = eventMessage["payload"]["value"];
   event_value["volume"] = volume;
   return device.sendEvent(eventMessage);
@@ -102,14 +107,14 @@ bool VolumeController<T>::handleVolumeController(SinricProRequest &request) {
 
   bool success = false;
 
-  if (volumeCallback && request.action == "setVolume") {
+  if (volumeCallback && request.action == FSTR_VOLUME_setVolume) {
     int volume = request.request_value["volume"];
     success = volumeCallback(device.deviceId, volume);
     request.response_value["volume"] = volume;
     return success;
   }
 
-  if (adjustVolumeCallback && request.action == "adjustVolume") {
+  if (adjustVolumeCallback && request.action == FSTR_VOLUME_adjustVolume) {
     int volume = request.request_value["volume"];
     bool volumeDefault = request.request_value["volumeDefault"] | false;
     success = adjustVolumeCallback(device.deviceId, volume, volumeDefault);
@@ -119,4 +124,12 @@ bool VolumeController<T>::handleVolumeController(SinricProRequest &request) {
   return success;
 }
 
+/**
+ * @brief Same as sendVolumeEvent() with the cause as `String`
+ **/
+template <typename T>
+bool VolumeController<T>::sendVolumeEvent(int volume, const String& cause) {
+  return sendVolumeEvent(volume, cause.c_str());
+}
+
 #endif
\ No newline at end of file
@@ -16,6 +16,13 @@
 #include "SinricProMessageid.h"
 #include "SinricProQueue.h"
 #include "SinricProId.h"
+#include "SinricProMetrics.h"
+#include "SinricProHeapTracker.h"
+#include "SinricProStrings.h"
+#include "SinricProDualCore.h"
+#include "SinricProTimers.h"
+
+#include <algorithm>
 
 /**
  * @class SinricProClass
@@ -52,6 +59,17 @@ class SinricProClass : public SinricProInterface {
     void onPong(std::function<void(uint32_t)> cb) { _websocketListener.onPong(cb); }
 
     void restoreDeviceStates(bool flag);
+    void setHandleBudget(size_t messages, unsigned long micros);
+    bool hasPendingWork();
+    unsigned long nextWakeupMs();
+
+    /**
+     * @brief Callback definition for onWakeup function
+     * 
+     * Gets called when work for handle() arrives from outside the task calling handle(), see onWakeup()
+     */
+    typedef void (*WakeupCallback)(void);
+    void onWakeup(WakeupCallback cb);
 
     struct proxy {
       proxy(SinricProClass* ptr, DeviceId deviceId) : ptr(ptr), deviceId(deviceId) {}
@@ -89,6 +107,31 @@ class SinricProClass : public SinricProInterface {
      * @return unsigned long current timestamp (unix epoch time)
      */
     unsigned long getTimestamp() override { return baseTimestamp + (millis()/1000); }
+
+#ifdef SINRICPRO_METRICS
+    /**
+     * @brief Latency histograms and counters, available if SINRICPRO_METRICS is defined
+     * 
+     * @return SinricProMetrics& the metrics collected since start or since the last `getMetrics().reset()`
+     */
+    SinricProMetrics& getMetrics() { return SinricProMetrics::instance(); }
+#endif
+#ifdef SINRICPRO_HEAP_TRACKING
+    /**
+     * @brief Heap allocations per library stage, available if SINRICPRO_HEAP_TRACKING is defined
+     * 
+     * @return SinricProHeapTracker& the heap usage since start or since the last `getHeapTracker().reset()`
+     */
+    SinricProHeapTracker& getHeapTracker() { return SinricProHeapTracker::instance(); }
+#endif
+#ifdef SINRICPRO_CAPTURE
+    /**
+     * @brief Capture of the received websocket and UDP frames, available if SINRICPRO_CAPTURE is defined
+     * 
+     * @return SinricProCapture& call `begin(Print&)` to start capturing
+     */
+    SinricProCapture& getCapture() { return SinricProCapture::instance(); }
+#endif
   protected:
     template <typename DeviceType>
     DeviceType &add(DeviceId deviceId);
@@ -96,18 +139,28 @@ class SinricProClass : public SinricProInterface {
     void add(SinricProDeviceInterface &newDevice);
     void add(SinricProDeviceInterface *newDevice);
 
-    DynamicJsonDocument prepareResponse(JsonDocument &requestMessage);
-    DynamicJsonDocument prepareEvent(DeviceId deviceId, const char *action, const char *cause) override;
-    void sendMessage(JsonDocument &jsonMessage) override;
+    SinricProJsonDocument prepareResponse(JsonDocument &requestMessage);
+    SinricProJsonDocument prepareEvent(DeviceId deviceId, const char *action, const char *cause) override;
+    bool sendMessage(JsonDocument &jsonMessage) override;
+    SinricProEventIntake* getEventIntake() override { return &eventIntake; }
 
   private:
     void handleReceiveQueue();
     void handleSendQueue();
+    bool handleReceivedMessage();
+    bool sendQueuedMessage();
+    bool queueMessage(message_priority_t priority, interface_t interface, JsonDocument& message, SinricProRemote remote = SinricProRemote());
+    void sendPostedEvents();
+#ifdef SINRICPRO_DUAL_CORE
+    bool handleNetwork();
+    void handleVerifiedRequests();
+#endif
+    void updateNetworkTimers(unsigned long now);
 
-    void handleRequest(DynamicJsonDocument& requestMessage, interface_t Interface);
-    void handleResponse(DynamicJsonDocument& responseMessage);
+    void handleRequest(JsonDocument& requestMessage, interface_t Interface, SinricProRemote remote);
+    void handleResponse(JsonDocument& responseMessage);
 
-    DynamicJsonDocument prepareRequest(DeviceId deviceId, const char* action);
+    SinricProJsonDocument prepareRequest(DeviceId deviceId, const char* action);
 
     void connect();
     void disconnect();
@@ -117,36 +170,78 @@ class SinricProClass : public SinricProInterface {
     void onDisconnect() { DEBUG_SINRIC("[SinricPro]: Disconnect\r\n"); }
 
     void extractTimestamp(JsonDocument &message);
+    static message_priority_t messagePriority(JsonDocument &message);
 
     SinricProDeviceInterface* getDevice(DeviceId deviceId);
+    void addDevice(SinricProDeviceInterface* device);
+
+    struct DeviceIndexEntry {
+      DeviceId deviceId;
+      SinricProDeviceInterface* device;
+    };
+    static bool compareDeviceIndex(const DeviceIndexEntry& entry, const DeviceId& deviceId) { return entry.deviceId < deviceId; }
+    std::vector<DeviceIndexEntry>::iterator findDevice(const DeviceId& deviceId);
 
     template <typename DeviceType>
     DeviceType& getDeviceInstance(DeviceId deviceId);
 
     std::vector<SinricProDeviceInterface*> devices;
+    std::vector<DeviceIndexEntry> deviceIndex; // devices sorted by deviceId for binary search
 
     AppKey socketAuthToken;
     AppSecret signingKey;
+    SHA256HMAC signingHmac;   // HMAC keyed with signingKey, copied for every signature
     String serverURL;
 
     websocketListener _websocketListener;
     udpListener _udpListener;
-    SinricProQueue_t receiveQueue;
-    SinricProQueue_t sendQueue;
+    SinricProReceiveQueue_t receiveQueue;
+    SinricProSendQueue_t sendQueue;
+    SinricProJsonPool jsonPool;
+    SinricProEventIntake eventIntake;
+#ifdef SINRICPRO_DUAL_CORE
+    SinricProSpscQueue<SINRICPRO_DUAL_CORE_QUEUE_SIZE> verifiedRequests;  // worker -> loop task
+    SinricProSpscQueue<SINRICPRO_DUAL_CORE_QUEUE_SIZE> outgoingMessages;  // loop task -> worker
+    SinricProJsonPool networkJsonPool;                                    // documents used by the worker
+    SinricProWorker worker;
+    std::atomic<bool> connected { false };
+#endif
 
     unsigned long baseTimestamp = 0;
 
+    size_t handleMessages = SINRICPRO_HANDLE_MESSAGES;
+    unsigned long handleMicros = SINRICPRO_HANDLE_MICROS;
+    bool sendNext = false;    // lane handle() continues with: receive queue (false) or send queue (true)
+
+    SinricProTimers timers;
+    bool timersConnected = false;   // connection state the network timers follow
+    WakeupCallback wakeupCallback = nullptr;
+
     bool _begin = false;
     String responseMessageStr = "";
 };
 
+/**
+ * @brief Returns the first index entry for deviceId or the entry where deviceId would have to be inserted
+ */
+std::vector<SinricProClass::DeviceIndexEntry>::iterator SinricProClass::findDevice(const DeviceId& deviceId) {
+  return std::lower_bound(deviceIndex.begin(), deviceIndex.end(), deviceId, compareDeviceIndex);
+}
+
 SinricProDeviceInterface* SinricProClass::getDevice(DeviceId deviceId) {
-  for (auto& device : devices) {
-    if (deviceId == device->getDeviceId()) return device;
-  }
+  auto entry = findDevice(deviceId);
+  if (entry != deviceIndex.end() && entry->deviceId == deviceId) return entry->device;
   return nullptr;
 }
 
+void SinricProClass::addDevice(SinricProDeviceInterface* device) {
+  devices.push_back(device);
+  DeviceIndexEntry entry { device->getDeviceId(), device };
+  auto position = findDevice(entry.deviceId);
+  while (position != deviceIndex.end() && position->deviceId == entry.deviceId) position++; // keep devices with equal ids in order of adding
+  deviceIndex.insert(position, entry);
+}
+
 template <typename DeviceType>
 DeviceType& SinricProClass::getDeviceInstance(DeviceId deviceId) { 
   DeviceType* tmp_device = (DeviceType*) getDevice(deviceId);
@@ -197,9 +292,19 @@ void SinricProClass::begin(AppKey socketAuthToken, AppSecret signingKey, String
 
   this->socketAuthToken = socketAuthToken;
   this->signingKey = signingKey;
+  char key[APPSECRET_STRLEN+1];
+  signingKey.toChars(key);
+  signingHmac = SHA256HMAC((byte*) key, APPSECRET_STRLEN);
   this->serverURL = serverURL;
   _begin = true;
+  receiveQueue.setOverflowPolicy(SINRICPRO_QUEUE_OVERFLOW, [this]() { handleReceiveQueue(); });
+  sendQueue.setOverflowPolicy(SINRICPRO_QUEUE_OVERFLOW, [this]() { handleSendQueue(); });
   _udpListener.begin(&receiveQueue);
+#ifdef SINRICPRO_DUAL_CORE
+  worker.start([this]() { return handleNetwork(); });
+#else
+  timers.start(TIMER_RECONNECT, millis(), 0); // the first handle() connects
+#endif
 }
 
 template <typename DeviceType>
@@ -213,7 +318,7 @@ DeviceType& SinricProClass::add(DeviceId deviceId) {
   } else {
     DEBUG_SINRIC("[SinricPro:add()]: DeviceId \"%s\" is invalid!! Device will be ignored and will NOT WORK!\r\n", deviceId.toString().c_str());
   }
-  devices.push_back(newDevice);
+  addDevice(newDevice);
   return *newDevice;
 }
 
@@ -221,14 +326,14 @@ __attribute__ ((deprecated("Please use DeviceType& myDevice = SinricPro.add<Devi
 void SinricProClass::add(SinricProDeviceInterface* newDevice) {
   if (!newDevice->getDeviceId().isValid()) return;
   newDevice->begin(this);
-  devices.push_back(newDevice);
+  addDevice(newDevice);
 }
 
 __attribute__ ((deprecated("Please use DeviceType& myDevice = SinricPro.add<DeviceType>(DeviceId);")))
 void SinricProClass::add(SinricProDeviceInterface& newDevice) {
   if (!newDevice.getDeviceId().isValid()) return;
   newDevice.begin(this);
-  devices.push_back(&newDevice);
+  addDevice(&newDevice);
 }
 
 /**
@@ -239,6 +344,13 @@ void SinricProClass::add(SinricProDeviceInterface& newDevice) {
  * This function has to be called as often as possible. So it must be called in your main loop() function! \n
  * 
  * For proper function, begin() must be called with valid values for 'APP_KEY' and 'APP_SECRET' \n
+ * The work done per call can be limited by setHandleBudget(), hasPendingWork() tells if work has been left over. \n
+ * Instead of calling it in a busy loop, the calling task may sleep for nextWakeupMs() between two calls. \n
+ * 
+ * With SINRICPRO_DUAL_CORE defined, begin() starts a worker task on SINRICPRO_WORKER_CORE which connects, receives, verifies,
+ * signs and sends. handle() only calls the device callbacks for the verified requests and sends pending events,
+ * responses and events are handed to the worker. onConnected(), onDisconnected() and onPong() callbacks are called by the worker task.
+ * Events must be sent from the task calling handle() or posted (like postContactEvent()). SINRICPRO_METRICS are recorded by both tasks without locking.
  * @section handle Example-Code
  * @code
  * void loop() {
@@ -258,17 +370,224 @@ void SinricProClass::handle() {
     return;
   }
 
-
+#ifdef SINRICPRO_DUAL_CORE
+  handleVerifiedRequests();
+#else
   if (!isConnected()) connect();
+  {
+    SINRICPRO_HEAP_STAGE(HEAP_STAGE_RECEIVE);
+    _websocketListener.handle();
+    _udpListener.handle();
+  }
+  updateNetworkTimers(millis());
+
+  sendPostedEvents();
+  if (isConnected()) {
+    for (auto& device : devices) device->sendPendingEvents();
+  }
+
+  // one message of the receive queue and one of the send queue in turns until both are empty or the budget is spent
+  unsigned long start = handleMicros ? micros() : 0;
+  size_t handled = 0;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (int lane = 0; lane < 2; lane++) {
+      bool done = sendNext ? sendQueuedMessage() : handleReceivedMessage();
+      sendNext = !sendNext;
+      if (!done) continue;
+      progress = true;
+      handled++;
+      if (handleMessages && handled >= handleMessages) return;
+      if (handleMicros && micros() - start >= handleMicros) return;
+    }
+  }
+#endif
+}
+
+#ifdef SINRICPRO_DUAL_CORE
+/**
+ * @brief handle() in dual core mode: calls the device callbacks for the requests verified by the worker
+ */
+void SinricProClass::handleVerifiedRequests() {
+  sendPostedEvents();
+  if (isConnected()) {
+    for (auto& device : devices) device->sendPendingEvents();
+  }
+
+  unsigned long start = handleMicros ? micros() : 0;
+  size_t handled = 0;
+  while (SinricProSpscRecord* record = verifiedRequests.front()) {
+    {
+      SinricProJsonDocument message = jsonPool.borrow();
+      deserializeJson(message.get(), record->getMessage(), record->getLength());
+      handleRequest(message, record->getInterface(), record->getRemote());
+    }
+    verifiedRequests.pop();
+    handled++;
+    if (handleMessages && handled >= handleMessages) return;
+    if (handleMicros && micros() - start >= handleMicros) return;
+  }
+}
+
+/**
+ * @brief One round of the worker task in dual core mode: network, verification of received messages, signing and sending
+ * @return false if there was nothing to do
+ */
+bool SinricProClass::handleNetwork() {
+  if (!_websocketListener.isConnected()) connect();
   _websocketListener.handle();
   _udpListener.handle();
+  connected = _websocketListener.isConnected();
+
+  bool busy = false;
+  while (handleReceivedMessage()) busy = true;
+  if (busy && wakeupCallback && !verifiedRequests.empty()) wakeupCallback();
+  while (SinricProSpscRecord* record = outgoingMessages.front()) {
+    busy = true;
+    if (!sendQueue.pushUnsigned(record->getPriority(), record->getInterface(), record->getMessage(), record->getLength(), record->getRemote())) {
+      if (sendQueuedMessage()) continue; // sending makes room, the message is tried again
+      DEBUG_SINRIC("[SinricPro.handleNetwork()]: sendQueue is full, message has been dropped\r\n");
+    }
+    outgoingMessages.pop();
+  }
+  while (sendQueuedMessage()) busy = true;
+  return busy;
+}
+#endif
 
-  handleReceiveQueue();
-  handleSendQueue();
+/**
+ * @brief Sends the events posted by SinricProDevice::postEvent() from interrupt handlers and other tasks
+ */
+void SinricProClass::sendPostedEvents() {
+  SinricProPostedEvent event;
+  for (size_t i = 0; i < SINRICPRO_EVENT_INTAKE_SLOTS && eventIntake.take(event); i++) event.send(*event.device, event);
 }
 
-DynamicJsonDocument SinricProClass::prepareRequest(DeviceId deviceId, const char* action) {
-  DynamicJsonDocument requestMessage(1024);
+/**
+ * @brief Limits the work done by one call of handle()
+ * 
+ * handle() takes messages from the receive queue and the send queue in turns and returns as soon as one of the limits is reached,
+ * the next call continues with the other queue. At least one message is handled per call. \n
+ * Without a budget (default, see SINRICPRO_HANDLE_MESSAGES and SINRICPRO_HANDLE_MICROS) handle() empties both queues. \n
+ * Messages are still handled without limit if a full queue blocks (opt-in by SINRICPRO_QUEUE_OVERFLOW QUEUE_BLOCK).
+ * 
+ * @param messages messages received and sent per call at most, `0` = no limit
+ * @param micros microseconds per call at most (checked after each message), `0` = no limit
+ * @section setHandleBudget Example-Code
+ * @code
+ * SinricPro.setHandleBudget(4, 2000);
+ * ...
+ * void loop() {
+ *   SinricPro.handle();
+ *   if (!SinricPro.hasPendingWork()) doOtherWork();
+ * }
+ * @endcode
+ **/
+void SinricProClass::setHandleBudget(size_t messages, unsigned long micros) {
+  handleMessages = messages;
+  handleMicros = micros;
+}
+
+/**
+ * @brief Returns whether received messages wait to be handled or messages wait to be sent
+ * 
+ * Messages to send count only while they can be sent (connected and the server time is known), events posted from interrupt handlers or other tasks count always.
+ * With SINRICPRO_DUAL_CORE defined, only requests verified by the worker and waiting for handle() count.
+ * @return `true` if the next call of handle() has queued work to do
+ **/
+bool SinricProClass::hasPendingWork() {
+  if (eventIntake.hasEvent()) return true;
+#ifdef SINRICPRO_DUAL_CORE
+  return !verifiedRequests.empty();
+#else
+  if (receiveQueue.size() > 0) return true;
+  return isConnected() && baseTimestamp && sendQueue.size() > 0;
+#endif
+}
+
+/**
+ * @brief Time in milliseconds the task calling handle() may sleep before it has to call handle() again
+ * 
+ * The next of these deadlines: queued work (hasPendingWork(), 0), the next poll of the websocket and UDP for received
+ * messages (SINRICPRO_NETWORK_POLL_INTERVAL), the websocket heartbeat while connected, the next reconnect attempt while
+ * disconnected and the moment the rate limits allow a pending coalesced event (see SinricProDevice::setEventCoalescing()). \n
+ * With SINRICPRO_DUAL_CORE defined, the worker task does the network, only queued work and pending coalesced events count.
+ * onWakeup() tells when the sleep has to end earlier.
+ * @return `0` if handle() has work to do now, `SINRICPRO_NO_DEADLINE` if begin() has not been called or failed
+ * @section nextWakeupMs Example-Code
+ * @code
+ * void loop() {
+ *   SinricPro.handle();
+ *   delay(std::min(SinricPro.nextWakeupMs(), 1000ul)); // with automatic light sleep enabled the ESP sleeps here
+ * }
+ * @endcode
+ **/
+unsigned long SinricProClass::nextWakeupMs() {
+  if (!_begin) return SINRICPRO_NO_DEADLINE;
+  if (hasPendingWork()) return 0;
+  unsigned long now = millis();
+  unsigned long eventWait = SINRICPRO_NO_DEADLINE;
+  if (isConnected()) {
+    for (auto& device : devices) eventWait = std::min(eventWait, device->timeUntilPendingEvent());
+  }
+  if (eventWait == SINRICPRO_NO_DEADLINE) timers.stop(TIMER_EVENTS);
+  else timers.start(TIMER_EVENTS, now, eventWait);
+  return timers.timeUntilNext(now);
+}
+
+/**
+ * @brief Set callback function which ends a sleep before nextWakeupMs() has passed
+ * 
+ * Gets called when an event has been posted (like postContactEvent()) and, with SINRICPRO_DUAL_CORE defined, when the worker
+ * has received a request. It's called from interrupt handlers and from other tasks, so it must be safe to call from there
+ * (placed in IRAM, FromISR functions of FreeRTOS inside an interrupt handler). Set it before begin() and before events are posted.
+ * @param cb Function pointer to a `WakeupCallback` function
+ * @section onWakeup Example-Code
+ * @code
+ * TaskHandle_t loopTask = xTaskGetCurrentTaskHandle();  // in setup()
+ * 
+ * SinricPro.onWakeup([]() { xTaskNotifyGive(loopTask); }); // requests received by the worker, events posted by other tasks
+ * 
+ * void loop() {
+ *   SinricPro.handle();
+ *   unsigned long sleep = SinricPro.nextWakeupMs();
+ *   ulTaskNotifyTake(pdTRUE, sleep == SINRICPRO_NO_DEADLINE ? portMAX_DELAY : pdMS_TO_TICKS(sleep));
+ * }
+ * @endcode
+ **/
+void SinricProClass::onWakeup(WakeupCallback cb) {
+  wakeupCallback = cb;
+  eventIntake.onPost(cb);
+}
+
+/**
+ * @brief Follows the deadlines of the network after handle() has polled the websocket and UDP
+ * 
+ * The WebSockets library only works in its loop(): it pings WEBSOCKET_PING_INTERVAL ms after connecting and after its last
+ * ping, and tries to reconnect every WEBSOCKET_RECONNECT_INTERVAL ms while disconnected.
+ */
+void SinricProClass::updateNetworkTimers(unsigned long now) {
+  timers.start(TIMER_NETWORK, now, SINRICPRO_NETWORK_POLL_INTERVAL);
+  bool connected = _websocketListener.isConnected();
+  if (connected != timersConnected) {
+    timersConnected = connected;
+    if (connected) {
+      timers.stop(TIMER_RECONNECT);
+      timers.start(TIMER_HEARTBEAT, now, WEBSOCKET_PING_INTERVAL);
+    } else {
+      timers.stop(TIMER_HEARTBEAT);
+      timers.start(TIMER_RECONNECT, now, WEBSOCKET_RECONNECT_INTERVAL);
+    }
+    return;
+  }
+  if (timers.isDue(TIMER_HEARTBEAT, now)) timers.start(TIMER_HEARTBEAT, now, WEBSOCKET_PING_INTERVAL);
+  if (timers.isDue(TIMER_RECONNECT, now)) timers.start(TIMER_RECONNECT, now, WEBSOCKET_RECONNECT_INTERVAL);
+}
+
+SinricProJsonDocument SinricProClass::prepareRequest(DeviceId deviceId, const char* action) {
+  SinricProJsonDocument request = jsonPool.borrow();
+  JsonDocument& requestMessage = request.get();
   JsonObject header = requestMessage.createNestedObject("header");
   header["payloadVersion"] = 2;
   header["signatureVersion"] = 1;
@@ -276,14 +595,16 @@ DynamicJsonDocument SinricProClass::prepareRequest(DeviceId deviceId, const char
   JsonObject payload = requestMessage.createNestedObject("payload");
   payload["action"] = action;
   payload["createdAt"] = 0;
-  payload["deviceId"] = deviceId.toString();
+  char deviceIdStr[DEVICEID_STRLEN+1];
+  deviceId.toChars(deviceIdStr);
+  payload["deviceId"] = deviceIdStr; // char* is copied into the document
   payload["replyToken"] = MessageID().getID();
   payload["type"] = "request";
   payload.createNestedObject("value");
-  return requestMessage;
+  return request;
 }
 
-void SinricProClass::handleResponse(DynamicJsonDocument& responseMessage) {
+void SinricProClass::handleResponse(JsonDocument& responseMessage) {
   (void) responseMessage;
   DEBUG_SINRIC("[SinricPro.handleResponse()]:\r\n");
 
@@ -293,31 +614,37 @@ void SinricProClass::handleResponse(DynamicJsonDocument& responseMessage) {
   #endif
 }
 
-void SinricProClass::handleRequest(DynamicJsonDocument& requestMessage, interface_t Interface) {
+void SinricProClass::handleRequest(JsonDocument& requestMessage, interface_t Interface, SinricProRemote remote) {
   DEBUG_SINRIC("[SinricPro.handleRequest()]: handling request\r\n");
   #ifndef NODEBUG_SINRIC
           serializeJsonPretty(requestMessage, DEBUG_ESP_PORT);
   #endif
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_REQUEST);
 
-  DynamicJsonDocument responseMessage = prepareResponse(requestMessage);
+  SinricProJsonDocument response = prepareResponse(requestMessage);
+  JsonDocument& responseMessage = response.get();
 
   // handle devices
   bool success = false;
-  const char* deviceId = requestMessage["payload"]["deviceId"];
-  String action = requestMessage["payload"]["action"] | "";
-  String instance = requestMessage["payload"]["instanceId"] | "";
+  DeviceId deviceId = requestMessage["payload"]["deviceId"] | "";
+  const char* action = requestMessage["payload"]["action"] | "";
+  const char* instance = requestMessage["payload"]["instanceId"] | "";
   JsonObject request_value = requestMessage["payload"]["value"];
   JsonObject response_value = responseMessage["payload"]["value"];
 
-  for (auto& device : devices) {
-    if (device->getDeviceId() == deviceId && success == false) {
+  for (auto entry = findDevice(deviceId); entry != deviceIndex.end() && entry->deviceId == deviceId; entry++) {
+    SinricProDeviceInterface* device = entry->device;
+    if (success == false) {
+      SINRICPRO_HEAP_STAGE(HEAP_STAGE_CALLBACK);
       SinricProRequest request {
         action,
         instance,
         request_value,
         response_value
       };
+      SINRICPRO_METRICS_START(callbackStart);
       success = device->handleRequest(request);
+      SINRICPRO_METRICS_CALLBACK(action, callbackStart);
       responseMessage["payload"]["success"] = success;
       if (!success) {
         if (responseMessageStr.length() > 0){
@@ -330,83 +657,121 @@ void SinricProClass::handleRequest(DynamicJsonDocument& requestMessage, interfac
     }
   }
 
-  String responseString;
-  serializeJson(responseMessage, responseString);
-  sendQueue.push(new SinricProMessage(Interface, responseString.c_str()));
+  SINRICPRO_METRICS_START(responseStart);
+  if (!queueMessage(PRIORITY_RESPONSE, Interface, responseMessage, remote)) DEBUG_SINRIC("[SinricPro.handleRequest()]: sendQueue is full, response has been dropped\r\n");
+  SINRICPRO_METRICS_RECORD(responseBuild, responseStart);
 }
 
 void SinricProClass::handleReceiveQueue() {
-  if (receiveQueue.size() == 0) return;
+  while (handleReceivedMessage());
+}
 
-  DEBUG_SINRIC("[SinricPro.handleReceiveQueue()]: %i message(s) in receiveQueue\r\n", receiveQueue.size());
-  while (receiveQueue.size() > 0) {
-    SinricProMessage* rawMessage = receiveQueue.front();
-    receiveQueue.pop();
-    DynamicJsonDocument jsonMessage(1024);
-    deserializeJson(jsonMessage, rawMessage->getMessage());
+/**
+ * @brief Verifies and dispatches the first message of the receive queue
+ * @return false if the receive queue is empty
+ */
+bool SinricProClass::handleReceivedMessage() {
+  if (receiveQueue.size() == 0) return false;
+  SINRICPRO_METRICS_MAX(receiveQueueHighWater, receiveQueue.size());
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_PARSE);
+
+  DEBUG_SINRIC("[SinricPro.handleReceivedMessage()]: %i message(s) in receiveQueue\r\n", receiveQueue.size());
+  SinricProMessage* rawMessage = receiveQueue.front();
+#ifdef SINRICPRO_DUAL_CORE
+  SinricProJsonDocument message = networkJsonPool.borrow();
+#else
+  SinricProJsonDocument message = jsonPool.borrow();
+#endif
+  JsonDocument& jsonMessage = message.get();
+  deserializeJson(jsonMessage, rawMessage->getMessage());
 
-    bool sigMatch = false;
+  bool sigMatch = false;
 
-    if (strncmp(rawMessage->getMessage(), "{\"timestamp\":", 13) == 0 && strlen(rawMessage->getMessage()) <= 26) {
-      sigMatch=true; // timestamp message has no signature...ignore sigMatch for this!
-    } else {
-      sigMatch = verifyMessage(signingKey.toString(), jsonMessage);
-    }
+  if (strncmp(rawMessage->getMessage(), "{\"timestamp\":", 13) == 0 && strlen(rawMessage->getMessage()) <= 26) {
+    sigMatch=true; // timestamp message has no signature...ignore sigMatch for this!
+  } else {
+    SINRICPRO_METRICS_START(verifyStart);
+    sigMatch = verifyMessage(signingHmac, jsonMessage);
+    SINRICPRO_METRICS_RECORD(signatureVerify, verifyStart);
+  }
 
-    String messageType = jsonMessage["payload"]["type"];
+  const char* messageType = jsonMessage["payload"]["type"] | "";
 
-    if (sigMatch) { // signature is valid process message
-      DEBUG_SINRIC("[SinricPro.handleReceiveQueue()]: Signature is valid. Processing message...\r\n");
-      extractTimestamp(jsonMessage);
-      if (messageType == "response") handleResponse(jsonMessage);
-      if (messageType == "request") handleRequest(jsonMessage, rawMessage->getInterface());
-    } else {
-      DEBUG_SINRIC("[SinricPro.handleReceiveQueue()]: Signature is invalid! Sending messsage to [dev/null] ;)\r\n");
+  if (sigMatch) { // signature is valid process message
+    DEBUG_SINRIC("[SinricPro.handleReceivedMessage()]: Signature is valid. Processing message...\r\n");
+    SINRICPRO_METRICS_RECORD(receiveToDispatch, rawMessage->getQueuedAt());
+    extractTimestamp(jsonMessage);
+    if (strcmp(messageType, "response") == 0) handleResponse(jsonMessage);
+#ifdef SINRICPRO_DUAL_CORE
+    if (strcmp(messageType, "request") == 0 && !verifiedRequests.push(rawMessage->getInterface(), PRIORITY_RESPONSE, rawMessage->getMessage(), rawMessage->getLength(), rawMessage->getRemote())) {
+      DEBUG_SINRIC("[SinricPro.handleReceivedMessage()]: queue of verified requests is full, request has been dropped\r\n");
     }
-    delete rawMessage;
+#else
+    if (strcmp(messageType, "request") == 0) handleRequest(jsonMessage, rawMessage->getInterface(), rawMessage->getRemote());
+#endif
+  } else {
+    DEBUG_SINRIC("[SinricPro.handleReceivedMessage()]: Signature is invalid! Sending messsage to [dev/null] ;)\r\n");
+    SINRICPRO_METRICS_COUNT(signatureFailures);
   }
+  receiveQueue.pop();
+  return true;
 }
 
 void SinricProClass::handleSendQueue() {
-  if (!isConnected()) return;
-  if (!baseTimestamp) return;
-  while (sendQueue.size() > 0) {
-    DEBUG_SINRIC("[SinricPro:handleSendQueue()]: %i message(s) in sendQueue\r\n", sendQueue.size());
-    DEBUG_SINRIC("[SinricPro:handleSendQueue()]: Sending message...\r\n");
-
-    SinricProMessage* rawMessage = sendQueue.front(); sendQueue.pop();
-
-    DynamicJsonDocument jsonMessage(1024);
-    deserializeJson(jsonMessage, rawMessage->getMessage());
-    jsonMessage["payload"]["createdAt"] = getTimestamp();
-    signMessage(signingKey.toString(), jsonMessage);
-
-    String messageStr;
-
-    serializeJson(jsonMessage, messageStr);
-    #ifndef NODEBUG_SINRIC
-            serializeJsonPretty(jsonMessage, DEBUG_ESP_PORT);
-            Serial.println();
-    #endif
-
-    switch (rawMessage->getInterface()) {
-      case IF_WEBSOCKET: DEBUG_SINRIC("[SinricPro:handleSendQueue]: Sending to websocket\r\n"); _websocketListener.sendMessage(messageStr); break;
-      case IF_UDP:       DEBUG_SINRIC("[SinricPro:handleSendQueue]: Sending to UDP\r\n");_udpListener.sendMessage(messageStr); break;
-      default:           break;
-    }
-    delete rawMessage;
-    DEBUG_SINRIC("[SinricPro:handleSendQueue()]: message sent.\r\n");
+  while (sendQueuedMessage());
+}
+
+/**
+ * @brief Signs and sends the first message of the send queue
+ * @return false if the send queue is empty or messages can't be sent yet (not connected or server time unknown)
+ */
+bool SinricProClass::sendQueuedMessage() {
+  if (!isConnected()) return false;
+  if (!baseTimestamp) return false;
+  if (sendQueue.size() == 0) return false;
+  SINRICPRO_METRICS_MAX(sendQueueHighWater, sendQueue.size());
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_SEND);
+  DEBUG_SINRIC("[SinricPro:sendQueuedMessage()]: %i message(s) in sendQueue\r\n", sendQueue.size());
+  DEBUG_SINRIC("[SinricPro:sendQueuedMessage()]: Sending message...\r\n");
+
+  SinricProMessage* rawMessage = sendQueue.front();
+
+  SINRICPRO_METRICS_START(signStart);
+  bool isSigned = rawMessage->isSignable()
+                ? rawMessage->setCreatedAt(getTimestamp()) && signMessage(signingHmac, *rawMessage)
+                : strstr(rawMessage->getMessage(), "\"signature\":") != nullptr; // queued with its signature already
+  SINRICPRO_METRICS_RECORD(sign, signStart);
+  if (!isSigned) {
+    DEBUG_SINRIC("[SinricPro:sendQueuedMessage()]: message can't be signed, dropped: %s\r\n", rawMessage->getMessage());
+    SINRICPRO_METRICS_COUNT(unsignedMessages);
+    sendQueue.pop();
+    return true;
   }
+
+  DEBUG_SINRIC("%s\r\n", rawMessage->getMessage());
+
+  switch (rawMessage->getInterface()) {
+    case IF_WEBSOCKET: DEBUG_SINRIC("[SinricPro:sendQueuedMessage]: Sending to websocket\r\n"); _websocketListener.sendMessage(rawMessage->getMessage(), rawMessage->getLength()); break;
+    case IF_UDP:       DEBUG_SINRIC("[SinricPro:sendQueuedMessage]: Sending to UDP\r\n");_udpListener.sendMessage(rawMessage->getMessage(), rawMessage->getLength(), rawMessage->getRemote()); break;
+    default:           break;
+  }
+  SINRICPRO_METRICS_RECORD(sendQueueDwell, rawMessage->getQueuedAt());
+  sendQueue.pop();
+  DEBUG_SINRIC("[SinricPro:sendQueuedMessage()]: message sent.\r\n");
+  return true;
 }
 
 void SinricProClass::connect() {
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_CONNECT);
   String deviceList;
   int i = 0;
   for (auto& device : devices) {
     DeviceId deviceId = device->getDeviceId();
     if (deviceId.isValid()) {
       if (i>0) deviceList += ';';
-      deviceList += deviceId.toString();
+      char deviceIdStr[DEVICEID_STRLEN+1];
+      deviceId.toChars(deviceIdStr);
+      deviceList += deviceIdStr;
       i++;
     }
   }
@@ -421,13 +786,20 @@ void SinricProClass::connect() {
 
 
 void SinricProClass::stop() {
+#ifdef SINRICPRO_DUAL_CORE
+  worker.stop();
+#endif
   _begin = false;
   DEBUG_SINRIC("[SinricPro:stop()\r\n");
   _websocketListener.stop();
 }
 
 bool SinricProClass::isConnected() {
+#ifdef SINRICPRO_DUAL_CORE
+  return connected;
+#else
   return _websocketListener.isConnected();
+#endif
 };
 
 /**
@@ -483,16 +855,39 @@ void SinricProClass::extractTimestamp(JsonDocument &message) {
   }
 }
 
+/**
+ * @brief Queues an outgoing message, in dual core mode it's handed to the worker which queues it for sending
+ */
+bool SinricProClass::queueMessage(message_priority_t priority, interface_t interface, JsonDocument& message, SinricProRemote remote) {
+#ifdef SINRICPRO_DUAL_CORE
+  return outgoingMessages.push(interface, priority, measureJson(message), [&message](char* buffer, size_t capacity) {
+    return serializeJson(message, buffer, capacity + 1);
+  }, remote);
+#else
+  return sendQueue.push(priority, interface, message, remote);
+#endif
+}
+
+/**
+ * @brief Send queue lane of an outgoing message, by its type and the cause of an event
+ */
+message_priority_t SinricProClass::messagePriority(JsonDocument &message) {
+  JsonObject payload = message["payload"];
+  if (strcmp(payload["type"] | "", "response") == 0) return PRIORITY_RESPONSE;
+  if (strcmp(payload["cause"]["type"] | "", FSTR_SINRICPRO_PERIODIC_POLL) == 0) return PRIORITY_TELEMETRY;
+  return PRIORITY_EVENT;
+}
 
-void SinricProClass::sendMessage(JsonDocument& jsonMessage) {
+
+bool SinricProClass::sendMessage(JsonDocument& jsonMessage) {
   if (!isConnected()) {
     DEBUG_SINRIC("[SinricPro:sendMessage()]: device is offline, message has been dropped\r\n");
-    return;
+    return false;
   }
   DEBUG_SINRIC("[SinricPro:sendMessage()]: pushing message into sendQueue\r\n");
-  String messageString;
-  serializeJson(jsonMessage, messageString);
-  sendQueue.push(new SinricProMessage(IF_WEBSOCKET, messageString.c_str()));
+  bool queued = queueMessage(messagePriority(jsonMessage), IF_WEBSOCKET, jsonMessage);
+  if (!queued) DEBUG_SINRIC("[SinricPro:sendMessage()]: sendQueue is full, message has been dropped\r\n");
+  return queued;
 }
 
 /**
@@ -508,8 +903,9 @@ void SinricProClass::restoreDeviceStates(bool flag) {
   _websocketListener.setRestoreDeviceStates(flag);
 }
 
-DynamicJsonDocument SinricProClass::prepareResponse(JsonDocument& requestMessage) {
-  DynamicJsonDocument responseMessage(1024);
+SinricProJsonDocument SinricProClass::prepareResponse(JsonDocument& requestMessage) {
+  SinricProJsonDocument response = jsonPool.borrow();
+  JsonDocument& responseMessage = response.get();
   JsonObject header = responseMessage.createNestedObject("header");
   header["payloadVersion"] = 2;
   header["signatureVersion"] = 1;
@@ -525,12 +921,13 @@ DynamicJsonDocument SinricProClass::prepareResponse(JsonDocument& requestMessage
   payload["success"] = false;
   payload["type"] = "response";
   payload.createNestedObject("value");
-  return responseMessage;
+  return response;
 }
 
 
-DynamicJsonDocument SinricProClass::prepareEvent(DeviceId deviceId, const char* action, const char* cause) {
-  DynamicJsonDocument eventMessage(1024);
+SinricProJsonDocument SinricProClass::prepareEvent(DeviceId deviceId, const char* action, const char* cause) {
+  SinricProJsonDocument event = jsonPool.borrow();
+  JsonDocument& eventMessage = event.get();
   JsonObject header = eventMessage.createNestedObject("header");
   header["payloadVersion"] = 2;
   header["signatureVersion"] = 1;
@@ -540,11 +937,13 @@ DynamicJsonDocument SinricProClass::prepareEvent(DeviceId deviceId, const char*
   payload["cause"].createNestedObject("type");
   payload["cause"]["type"] = cause;
   payload["createdAt"] = 0;
-  payload["deviceId"] = deviceId.toString();
+  char deviceIdStr[DEVICEID_STRLEN+1];
+  deviceId.toChars(deviceIdStr);
+  payload["deviceId"] = deviceIdStr; // char* is copied into the document
   payload["replyToken"] = MessageID().getID();
   payload["type"] = "event";
   payload.createNestedObject("value");
-  return eventMessage;
+  return event;
 }
 
 #ifndef NOSINRIC_INSTANCE
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_CAPTURE_H_
+#define _SINRICPRO_CAPTURE_H_
+
+/*
+ * Traffic capture is compiled in by defining SINRICPRO_CAPTURE before including SinricPro.h (or as build flag).
+ * Without it SINRICPRO_CAPTURE_FRAME() expands to nothing.
+ */
+
+#ifdef SINRICPRO_CAPTURE
+
+#include "SinricProQueue.h"
+
+/*
+ * Capture format, all numbers are unsigned LEB128 varints:
+ *   header  "SPCAP" version(1 byte)
+ *   record  delta(time since the previous record or since begin() in microseconds) interface length payload(length bytes)
+ */
+#define SINRICPRO_CAPTURE_MAGIC   "SPCAP"
+#define SINRICPRO_CAPTURE_VERSION 1
+
+/**
+ * @class SinricProCapture
+ * @brief Writes every frame received by websocket and UDP with its arrival time and interface to a compact binary log
+ *
+ * Websocket frames are captured before they enter the receive queue, so frames dropped by a full queue are captured too.
+ * UDP packets are read straight into the receive queue and are captured only if they fit.
+ * Time deltas are taken from micros(), gaps longer than 71 minutes between two frames are not represented correctly.
+ * @section getCapture Example-Code
+ * @code
+ * File capture = LittleFS.open("/capture.bin", "w");
+ * SinricPro.getCapture().begin(capture);
+ * // ...
+ * SinricPro.getCapture().end();
+ * capture.close();
+ * @endcode
+ **/
+class SinricProCapture {
+public:
+  SinricProCapture() : _out(nullptr), _last(0), _records(0) {}
+  void begin(Print &out);
+  void end() { _out = nullptr; }
+  bool isCapturing() const { return _out != nullptr; }
+  uint32_t records() const { return _records; }
+  void record(interface_t interface, const uint8_t *payload, size_t length);
+
+  static SinricProCapture &instance();
+private:
+  void writeVarint(uint32_t value);
+
+  Print        *_out;
+  unsigned long _last;
+  uint32_t      _records;
+};
+
+SinricProCapture &SinricProCapture::instance() {
+  static SinricProCapture capture;
+  return capture;
+}
+
+/**
+ * @brief Writes the header to `out` and captures all following frames into it until end() is called
+ */
+void SinricProCapture::begin(Print &out) {
+  _out = &out;
+  _last = micros();
+  _records = 0;
+  _out->write((const uint8_t *) SINRICPRO_CAPTURE_MAGIC, strlen(SINRICPRO_CAPTURE_MAGIC));
+  _out->write((uint8_t) SINRICPRO_CAPTURE_VERSION);
+}
+
+void SinricProCapture::writeVarint(uint32_t value) {
+  uint8_t buffer[5];
+  size_t length = 0;
+  do {
+    buffer[length] = value & 0x7F;
+    value >>= 7;
+    if (value) buffer[length] |= 0x80;
+    length++;
+  } while (value);
+  _out->write(buffer, length);
+}
+
+void SinricProCapture::record(interface_t interface, const uint8_t *payload, size_t length) {
+  if (!_out) return;
+  unsigned long now = micros();
+  writeVarint(now - _last);
+  writeVarint(interface);
+  writeVarint(length);
+  _out->write(payload, length);
+  _last = now;
+  _records++;
+}
+
+/**
+ * @brief A frame read from a capture, `payload` points into the capture's buffer
+ */
+struct SinricProCaptureRecord {
+  uint64_t       time;        // microseconds since the capture has been started
+  interface_t    interface;
+  const uint8_t *payload;
+  size_t         length;
+};
+
+/**
+ * @class SinricProCaptureReader
+ * @brief Reads the frames of a capture held in memory
+ **/
+class SinricProCaptureReader {
+public:
+  SinricProCaptureReader(const uint8_t *data, size_t size);
+  bool isValid() const { return _valid; }
+  bool next(SinricProCaptureRecord &record);
+private:
+  bool readVarint(uint32_t &value);
+
+  const uint8_t *_data;
+  size_t         _size;
+  size_t         _pos;
+  uint64_t       _time;
+  bool           _valid;
+};
+
+SinricProCaptureReader::SinricProCaptureReader(const uint8_t *data, size_t size) : _data(data), _size(size), _pos(0), _time(0), _valid(false) {
+  size_t magicLength = strlen(SINRICPRO_CAPTURE_MAGIC);
+  if (size <= magicLength || memcmp(data, SINRICPRO_CAPTURE_MAGIC, magicLength) || data[magicLength] != SINRICPRO_CAPTURE_VERSION) return;
+  _pos = magicLength + 1;
+  _valid = true;
+}
+
+bool SinricProCaptureReader::readVarint(uint32_t &value) {
+  value = 0;
+  for (uint8_t shift = 0; shift < 35 && _pos < _size; shift += 7) {
+    uint8_t byte = _data[_pos++];
+    value |= (uint32_t) (byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Reads the next frame
+ * @return false at the end of the capture, or if the capture is truncated or invalid (isValid() returns false then)
+ */
+bool SinricProCaptureReader::next(SinricProCaptureRecord &record) {
+  if (!_valid || _pos == _size) return false;
+  uint32_t delta, interface, length;
+  if (!readVarint(delta) || !readVarint(interface) || !readVarint(length) || length > _size - _pos) {
+    _valid = false;
+    return false;
+  }
+  _time += delta;
+  record.time = _time;
+  record.interface = (interface_t) interface;
+  record.payload = _data + _pos;
+  record.length = length;
+  _pos += length;
+  return true;
+}
+
+#define SINRICPRO_CAPTURE_FRAME(interface, payload, length) SinricProCapture::instance().record(interface, (const uint8_t *) (payload), length)
+
+#else
+
+#define SINRICPRO_CAPTURE_FRAME(interface, payload, length)
+
+#endif
+
+#endif
@@ -42,6 +42,9 @@
 // UDP Configuration
 #define UDP_MULTICAST_IP IPAddress(224,9,9,9)
 #define UDP_MULTICAST_PORT 3333
+#ifndef UDP_PACKETS_PER_HANDLE
+#define UDP_PACKETS_PER_HANDLE (SINRICPRO_RECEIVE_QUEUE_SIZE / SINRICPRO_QUEUE_RECORD_SIZE)  // packets read into the receive queue per SinricPro.handle() at most: as many as it holds, 8 (4 on ESP8266)
+#endif
 
 // WebSocket Configuration
 #ifdef DEBUG_WIFI_ISSUE
@@ -51,10 +54,124 @@
 #endif
 #define WEBSOCKET_PING_TIMEOUT 10000
 #define WEBSOCKET_RETRY_COUNT 2
+#ifndef WEBSOCKET_RECONNECT_INTERVAL
+#define WEBSOCKET_RECONNECT_INTERVAL 500  // the WebSockets library's default
+#endif
 
-// LeakyBucket Configuration
+// Event Rate Limit Configuration
+// per action of a device: BUCKET_SIZE events in a row, one more every DROP_OUT_TIME ms, at least DROP_IN_TIME ms apart
 #define BUCKET_SIZE 10
 #define DROP_OUT_TIME 60000
 #define DROP_IN_TIME 1000u
+// per device and for all devices together: burst of events, one more every ..._REFILL ms (burst 0 = no limit)
+#ifndef EVENT_LIMIT_DEVICE_BURST
+#define EVENT_LIMIT_DEVICE_BURST 0
+#endif
+#ifndef EVENT_LIMIT_DEVICE_REFILL
+#define EVENT_LIMIT_DEVICE_REFILL 1000
+#endif
+#ifndef EVENT_LIMIT_GLOBAL_BURST
+#define EVENT_LIMIT_GLOBAL_BURST 0
+#endif
+#ifndef EVENT_LIMIT_GLOBAL_REFILL
+#define EVENT_LIMIT_GLOBAL_REFILL 1000
+#endif
+#ifndef EVENT_LIMIT_ACTIONS_PER_DEVICE
+#define EVENT_LIMIT_ACTIONS_PER_DEVICE 8  // action buckets per device held without allocating, further actions get their bucket allocated
+#endif
+
+// Event intake Configuration: events posted from interrupt handlers or other tasks wait here until handle() sends them
+#ifndef SINRICPRO_EVENT_INTAKE_SLOTS
+#define SINRICPRO_EVENT_INTAKE_SLOTS 16  // power of 2
+#endif
+
+// Queue Configuration (bytes, each queued message takes its length + 16 bytes, + 20 bytes with SINRICPRO_METRICS, messages received by UDP and their responses 8 bytes more)
+#ifndef SINRICPRO_QUEUE_RECORD_SIZE
+#define SINRICPRO_QUEUE_RECORD_SIZE 512  // a queued message of the largest size expected: a request, or a signed response or event
+#endif
+// both queues are static arrays, smaller on ESP8266 and sized in whole messages there: 4 requests received and 2 responses, 2 events and 1 telemetry event waiting
+#ifndef SINRICPRO_RECEIVE_QUEUE_SIZE
+#if defined(ESP8266)
+#define SINRICPRO_RECEIVE_QUEUE_SIZE (4 * SINRICPRO_QUEUE_RECORD_SIZE)
+#else
+#define SINRICPRO_RECEIVE_QUEUE_SIZE 4096
+#endif
+#endif
+// the send queue is split into lanes: responses, events (interaction, alerts) and telemetry (events caused by PERIODIC_POLL)
+#if defined(ESP8266) && !defined(SINRICPRO_SEND_QUEUE_SIZE)
+#ifndef SINRICPRO_SEND_QUEUE_RESPONSE_SIZE
+#define SINRICPRO_SEND_QUEUE_RESPONSE_SIZE (2 * SINRICPRO_QUEUE_RECORD_SIZE)
+#endif
+#ifndef SINRICPRO_SEND_QUEUE_EVENT_SIZE
+#define SINRICPRO_SEND_QUEUE_EVENT_SIZE (2 * SINRICPRO_QUEUE_RECORD_SIZE)
+#endif
+#ifndef SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE
+#define SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE (1 * SINRICPRO_QUEUE_RECORD_SIZE)
+#endif
+#define SINRICPRO_SEND_QUEUE_SIZE (SINRICPRO_SEND_QUEUE_RESPONSE_SIZE + SINRICPRO_SEND_QUEUE_EVENT_SIZE + SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE)
+#endif
+#ifndef SINRICPRO_SEND_QUEUE_SIZE
+#define SINRICPRO_SEND_QUEUE_SIZE 4096
+#endif
+#ifndef SINRICPRO_SEND_QUEUE_RESPONSE_SIZE
+#define SINRICPRO_SEND_QUEUE_RESPONSE_SIZE (SINRICPRO_SEND_QUEUE_SIZE / 2)
+#endif
+#ifndef SINRICPRO_SEND_QUEUE_EVENT_SIZE
+#define SINRICPRO_SEND_QUEUE_EVENT_SIZE (SINRICPRO_SEND_QUEUE_SIZE / 4)
+#endif
+#ifndef SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE
+#define SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE (SINRICPRO_SEND_QUEUE_SIZE - SINRICPRO_SEND_QUEUE_RESPONSE_SIZE - SINRICPRO_SEND_QUEUE_EVENT_SIZE)
+#endif
+#ifndef SINRICPRO_SEND_STARVATION_LIMIT
+#define SINRICPRO_SEND_STARVATION_LIMIT 8  // a waiting lane is sent from at the latest after this many messages of other lanes (0 = strict priority)
+#endif
+// a full queue drops the new message; QUEUE_BLOCK handles the queued messages first, which runs callbacks from inside the receiving code
+#ifndef SINRICPRO_QUEUE_OVERFLOW
+#define SINRICPRO_QUEUE_OVERFLOW QUEUE_DROP_NEWEST
+#endif
+
+// handle() Configuration (0 = no limit): messages received and sent per SinricPro.handle() at most, and the time for them
+#ifndef SINRICPRO_HANDLE_MESSAGES
+#define SINRICPRO_HANDLE_MESSAGES 0
+#endif
+#ifndef SINRICPRO_HANDLE_MICROS
+#define SINRICPRO_HANDLE_MICROS 0
+#endif
+
+// Sleep Configuration: SinricPro.nextWakeupMs() is at most this long, the loop task polls the websocket and UDP for received messages
+#ifndef SINRICPRO_NETWORK_POLL_INTERVAL
+#define SINRICPRO_NETWORK_POLL_INTERVAL 100
+#endif
+
+// Dual core Configuration (only used with SINRICPRO_DUAL_CORE defined)
+#ifndef SINRICPRO_DUAL_CORE_QUEUE_SIZE
+#define SINRICPRO_DUAL_CORE_QUEUE_SIZE 4096   // bytes of each queue between the cores: verified requests and outgoing messages
+#endif
+#ifndef SINRICPRO_WORKER_CORE
+#define SINRICPRO_WORKER_CORE 0               // the Arduino loop task runs on core 1
+#endif
+#ifndef SINRICPRO_WORKER_STACK_SIZE
+#define SINRICPRO_WORKER_STACK_SIZE 8192
+#endif
+#ifndef SINRICPRO_WORKER_PRIORITY
+#define SINRICPRO_WORKER_PRIORITY 1
+#endif
+
+// JSON Configuration (request, response and one event can be handled at the same time without allocating,
+// the pool allocates its documents on first use and keeps them: SINRICPRO_JSON_POOL_SIZE * SINRICPRO_JSON_DOCUMENT_SIZE bytes of heap)
+#ifndef SINRICPRO_JSON_DOCUMENT_SIZE
+#define SINRICPRO_JSON_DOCUMENT_SIZE 1024
+#endif
+#ifndef SINRICPRO_JSON_POOL_SIZE
+#define SINRICPRO_JSON_POOL_SIZE 3
+#endif
+
+// Metrics Configuration (only used with SINRICPRO_METRICS defined)
+#ifndef SINRICPRO_METRICS_BUCKETS
+#define SINRICPRO_METRICS_BUCKETS 20  // histogram buckets: 0 us, 1 us, 2..3 us, 4..7 us ... 262 ms and longer
+#endif
+#ifndef SINRICPRO_METRICS_ACTIONS
+#define SINRICPRO_METRICS_ACTIONS 8   // actions with their own callback histogram
+#endif
 
 #endif
@@ -10,10 +10,53 @@
 
 #include "SinricProRequest.h"
 #include "SinricProDeviceInterface.h"
-#include "LeakyBucket.h"
+#include "SinricProRateLimiter.h"
+#include "SinricProMetrics.h"
+#include "SinricProHeapTracker.h"
 #include "SinricProId.h"
+#include "SinricProTimers.h"
 
-#include <map>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+
+class SinricProDevice;
+
+/**
+ * @class SinricProActionTable
+ * @brief Maps request actions to the capability handling them
+ * 
+ * There is one table per device type. Capabilities add their actions while the first device of a type is constructed.
+ **/
+class SinricProActionTable {
+public:
+  typedef bool (*ActionHandler)(SinricProDevice &device, SinricProRequest &request);
+  void add(const char *action, ActionHandler handler);
+  bool handleRequest(SinricProDevice &device, SinricProRequest &request) const;
+private:
+  struct Entry {
+    const char *action;
+    ActionHandler handler;
+  };
+  static bool compareAction(const Entry &entry, const char *action) { return strcmp(entry.action, action) < 0; }
+  std::vector<Entry> entries; // sorted by action, entries with equal actions in order of adding
+};
+
+void SinricProActionTable::add(const char *action, ActionHandler handler) {
+  auto entry = std::lower_bound(entries.begin(), entries.end(), action, compareAction);
+  for (; entry != entries.end() && strcmp(entry->action, action) == 0; entry++) {
+    if (entry->handler == handler) return; // already added by a previous device of the same type
+  }
+  entries.insert(entry, Entry { action, handler });
+}
+
+bool SinricProActionTable::handleRequest(SinricProDevice &device, SinricProRequest &request) const {
+  const char *action = request.action.c_str();
+  for (auto entry = std::lower_bound(entries.begin(), entries.end(), action, compareAction); entry != entries.end() && strcmp(entry->action, action) == 0; entry++) {
+    if (entry->handler(device, request)) return true;
+  }
+  return false;
+}
 
 /**
  * @class SinricProDevice
@@ -29,33 +72,63 @@ public:
   bool operator==(const DeviceId& other);
 
   virtual DeviceId getDeviceId();
+  void setEventCoalescing(const char *action, bool enabled = true);
+  unsigned long timeUntilNextEvent(const char *action);
 protected:
   unsigned long getTimestamp();
   virtual bool sendEvent(JsonDocument &event);
-  virtual DynamicJsonDocument prepareEvent(const char *action, const char *cause);
+  bool postEvent(SinricProPostedEvent::SendFunction send, const char *cause, bool state = false, float value = 0.0f, float value2 = 0.0f);
+  virtual SinricProJsonDocument prepareEvent(const char *action, const char *cause);
 
   virtual ~SinricProDevice();
   virtual String getProductType();
   virtual void begin(SinricProInterface *eventSender);
+  virtual void sendPendingEvents();
+  virtual unsigned long timeUntilPendingEvent();
   bool handleRequest(SinricProRequest &request);
+
+  template <typename DeviceType, typename Capability, bool (Capability::*handler)(SinricProRequest &)>
+  void addActionHandler(std::initializer_list<const char *> actions);
+
   DeviceId deviceId;
-  std::vector<SinricProRequestHandler> requestHandlers;
+  std::vector<SinricProRequestHandler> requestHandlers; // handlers for any action, tried after the action table
 
-private : SinricProInterface *eventSender;
-  std::map<String, LeakyBucket_t> eventFilter;
+private :
+  template <typename DeviceType>
+  static SinricProActionTable &deviceTypeActionTable();
+  template <typename DeviceType, typename Capability, bool (Capability::*handler)(SinricProRequest &)>
+  static bool callActionHandler(SinricProDevice &device, SinricProRequest &request);
+
+  struct CoalescedEvent {
+    uint8_t actionId;
+    DynamicJsonDocument *pendingEvent; // latest event which has not been sent yet, kept allocated to be reused
+    bool isPending;
+  };
+  CoalescedEvent *findCoalescedEvent(uint8_t actionId);
+
+  SinricProActionTable *actionTable;
+  SinricProInterface *eventSender;
+  SinricProEventIntake *eventIntake;
+  SinricProEventLimiter eventLimiter;
+  std::vector<CoalescedEvent> coalescedEvents;
   String productType;
 };
 
 SinricProDevice::SinricProDevice(const DeviceId &deviceId, const String &productType) : 
   deviceId(deviceId),
+  actionTable(nullptr),
   eventSender(nullptr),
+  eventIntake(nullptr),
   productType(productType) {
 }
 
-SinricProDevice::~SinricProDevice() {}
+SinricProDevice::~SinricProDevice() {
+  for (auto& coalescedEvent : coalescedEvents) delete coalescedEvent.pendingEvent;
+}
 
 void SinricProDevice::begin(SinricProInterface* eventSender) {
   this->eventSender = eventSender;
+  this->eventIntake = eventSender->getEventIntake();
 }
 
 DeviceId SinricProDevice::getDeviceId() {
@@ -66,38 +139,141 @@ bool SinricProDevice::operator==(const DeviceId &other) {
   return other == deviceId; 
 }
 
-DynamicJsonDocument SinricProDevice::prepareEvent(const char* action, const char* cause) {
+SinricProJsonDocument SinricProDevice::prepareEvent(const char* action, const char* cause) {
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_EVENT);
   if (eventSender) return eventSender->prepareEvent(deviceId, action, cause);
   DEBUG_SINRIC("[SinricProDevice:prepareEvent()]: Device \"%s\" isn't configured correctly! The \'%s\' event will be ignored.\r\n", deviceId.toString().c_str(), action);
-  return DynamicJsonDocument(1024);
+  return SinricProJsonDocument();
 }
 
 
+/**
+ * @brief Queues an event to be sent by SinricPro.handle(), may be called from interrupt handlers and other tasks
+ * 
+ * handle() calls `send` with the posted event, which sends it like the send...Event() functions do. Rate limits apply then.
+ * @return `false` if the device hasn't been added to SinricPro or all SINRICPRO_EVENT_INTAKE_SLOTS slots are in use
+ */
+SINRICPRO_ISR_ATTR bool SinricProDevice::postEvent(SinricProPostedEvent::SendFunction send, const char *cause, bool state, float value, float value2) {
+  if (!eventIntake) return false;
+  SinricProPostedEvent event { this, send, cause, state, { value, value2 } };
+  return eventIntake->post(event);
+}
+
 bool SinricProDevice::sendEvent(JsonDocument& event) {
   if (!eventSender) return false;
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_EVENT);
   if (!eventSender->isConnected()) {
     DEBUG_SINRIC("[SinricProDevice::sendEvent]: The event could not be sent. No connection to the SinricPro server.\r\n");
     return false;
   }
-  String eventName = event["payload"]["action"] | ""; // get event name
+  // rate limits are used to prevent flooding the server
+  const char* eventName = event["payload"]["action"] | "";
+  uint8_t actionId = SinricProEventLimiter::actionId(eventName);
+  CoalescedEvent* coalescedEvent = findCoalescedEvent(actionId);
 
-  LeakyBucket_t bucket; // leaky bucket algorithm is used to prevent flooding the server
+  unsigned long now = millis();
+  if (eventLimiter.allows(actionId, now, coalescedEvent == nullptr)) { // coalesced events don't cause the flooding warning
+    if (!eventSender->sendMessage(event)) return false; // send queue is full: the event doesn't count against the limits
+    eventLimiter.take(actionId, now);
+    if (coalescedEvent) coalescedEvent->isPending = false; // a newer value has been sent
+    return true;
+  }
 
-  // get leaky bucket for event from eventFilter
-  if (eventFilter.find(eventName) == eventFilter.end()) {  // if there is no bucket ...
-    eventFilter[eventName] = bucket;                       // ...add a new bucket
-  } else {  
-    bucket = eventFilter[eventName];                       // else get bucket
+  if (!coalescedEvent) {
+    SINRICPRO_METRICS_COUNT(rateLimitedEvents);
+    return false;
   }
 
-  if (bucket.addDrop()) {                                  // if we can add a new drop
-    eventSender->sendMessage(event);                       // send event
-    eventFilter[eventName] = bucket;                       // update bucket on eventFilter
-    return true;
+  // keep the event to be sent by sendPendingEvents(), replacing an older pending event
+  // set() links const char* values instead of copying them: the cause may be a temporary string, so it's copied as char*
+  const char* cause = event["payload"]["cause"]["type"] | "";
+  size_t size = event.memoryUsage() + strlen(cause) + 1;
+  if (!coalescedEvent->pendingEvent || coalescedEvent->pendingEvent->capacity() < size) {
+    delete coalescedEvent->pendingEvent;
+    coalescedEvent->pendingEvent = new DynamicJsonDocument(size);
   }
+  coalescedEvent->pendingEvent->clear();
+  coalescedEvent->pendingEvent->set(event);
+  (*coalescedEvent->pendingEvent)["payload"]["cause"]["type"] = (char*) cause;
+  coalescedEvent->isPending = true;
+  DEBUG_SINRIC("[SinricProDevice::sendEvent]: \"%s\" event is pending\r\n", eventName);
+  return true;
+}
 
-  eventFilter[eventName] = bucket;                        // update bucket on eventFilter
-  return false;
+/**
+ * @brief Enable / disable coalescing of events
+ * 
+ * By default events which are sent too fast are dropped by the rate limiter. \n
+ * With coalescing enabled for an action, an event which can't be sent yet is kept and sent as soon as the rate limiter allows it. 
+ * A newer event replaces the pending one, so only the latest value is sent. This is useful for sensors which report values in a fast loop. \n
+ * The `send...Event` functions return `true` if the event has been kept to be sent later.
+ * 
+ * @param action  the event action, e.g. `"currentTemperature"` or `"powerUsage"`
+ * @param enabled `true` to enable (default), `false` to disable coalescing
+ * @section setEventCoalescing Example-Code
+ * @code
+ * SinricProTemperaturesensor &mySensor = SinricPro[TEMP_SENSOR_ID];
+ * mySensor.setEventCoalescing("currentTemperature");
+ * @endcode
+ **/
+void SinricProDevice::setEventCoalescing(const char* action, bool enabled) {
+  uint8_t actionId = SinricProEventLimiter::actionId(action);
+  for (auto coalescedEvent = coalescedEvents.begin(); coalescedEvent != coalescedEvents.end(); coalescedEvent++) {
+    if (coalescedEvent->actionId != actionId) continue;
+    if (!enabled) {
+      delete coalescedEvent->pendingEvent;
+      coalescedEvents.erase(coalescedEvent);
+    }
+    return;
+  }
+  if (enabled) coalescedEvents.push_back(CoalescedEvent { actionId, nullptr, false });
+}
+
+/**
+ * @brief Time in milliseconds until an event for the action will be allowed by the rate limits
+ * 
+ * @param action  the event action, e.g. `"currentTemperature"`
+ * @return 0 if an event can be sent now
+ **/
+unsigned long SinricProDevice::timeUntilNextEvent(const char* action) {
+  return eventLimiter.timeUntilNextEvent(SinricProEventLimiter::actionId(action), millis());
+}
+
+SinricProDevice::CoalescedEvent* SinricProDevice::findCoalescedEvent(uint8_t actionId) {
+  for (auto& coalescedEvent : coalescedEvents) {
+    if (coalescedEvent.actionId == actionId) return &coalescedEvent;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Sends pending coalesced events the rate limiter allows now, called by SinricProClass::handle()
+ */
+void SinricProDevice::sendPendingEvents() {
+  if (coalescedEvents.empty()) return;
+  SINRICPRO_HEAP_STAGE(HEAP_STAGE_EVENT);
+  unsigned long now = millis();
+  for (auto& coalescedEvent : coalescedEvents) {
+    if (!coalescedEvent.isPending || !eventLimiter.allows(coalescedEvent.actionId, now, false)) continue;
+    DEBUG_SINRIC("[SinricProDevice::sendPendingEvents]: sending pending event\r\n");
+    if (!eventSender->sendMessage(*coalescedEvent.pendingEvent)) continue; // send queue is full: stays pending for the next handle()
+    eventLimiter.take(coalescedEvent.actionId, now);
+    coalescedEvent.isPending = false;
+  }
+}
+
+/**
+ * @brief Time in milliseconds until sendPendingEvents() can send a pending coalesced event, SINRICPRO_NO_DEADLINE if none is pending
+ */
+unsigned long SinricProDevice::timeUntilPendingEvent() {
+  unsigned long next = SINRICPRO_NO_DEADLINE;
+  unsigned long now = millis();
+  for (auto& coalescedEvent : coalescedEvents) {
+    if (!coalescedEvent.isPending) continue;
+    unsigned long wait = eventLimiter.timeUntilNextEvent(coalescedEvent.actionId, now);
+    if (wait < next) next = wait;
+  }
+  return next;
 }
 
 unsigned long SinricProDevice::getTimestamp() {
@@ -109,7 +285,33 @@ String SinricProDevice::getProductType()  {
   return String("sinric.device.type.")+productType; 
 }
 
+/**
+ * @brief Registers a capability handler for the given actions in the action table of DeviceType
+ * 
+ * Called by the capability constructors:
+ * @code
+ * static_cast<T &>(*this).template addActionHandler<T, RangeController<T>, &RangeController<T>::handleRangeController>({"setRangeValue", "adjustRangeValue"});
+ * @endcode
+ **/
+template <typename DeviceType, typename Capability, bool (Capability::*handler)(SinricProRequest &)>
+void SinricProDevice::addActionHandler(std::initializer_list<const char *> actions) {
+  actionTable = &deviceTypeActionTable<DeviceType>();
+  for (auto action : actions) actionTable->add(action, &SinricProDevice::callActionHandler<DeviceType, Capability, handler>);
+}
+
+template <typename DeviceType>
+SinricProActionTable &SinricProDevice::deviceTypeActionTable() {
+  static SinricProActionTable table;
+  return table;
+}
+
+template <typename DeviceType, typename Capability, bool (Capability::*handler)(SinricProRequest &)>
+bool SinricProDevice::callActionHandler(SinricProDevice &device, SinricProRequest &request) {
+  return (static_cast<DeviceType &>(device).*handler)(request);
+}
+
 bool SinricProDevice::handleRequest(SinricProRequest &request) {
+  if (actionTable && actionTable->handleRequest(*this, request)) return true;
   for (auto& requestHandler : requestHandlers) {
     if (requestHandler(request)) return true;
   }
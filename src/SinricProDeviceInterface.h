@@ -12,9 +12,11 @@ class SinricProDeviceInterface {
     virtual DeviceId getDeviceId() = 0;
     virtual String getProductType() = 0;
     virtual void begin(SinricProInterface* eventSender) = 0;
+    virtual void sendPendingEvents() = 0;
+    virtual unsigned long timeUntilPendingEvent() = 0;
 //    virtual bool sendEvent(JsonDocument& event) = 0;
 //    virtual DynamicJsonDocument prepareEvent(const char* action, const char* cause) = 0;
-    virtual unsigned long getTimestamp();
+    virtual unsigned long getTimestamp() = 0;
 };
 
 #endif
\ No newline at end of file
@@ -9,7 +9,7 @@
 #define _SINRICDIMSWITCH_H_
 
 #include "SinricProDevice.h"
-#include "Capabilities/PowerstateController.h"
+#include "Capabilities/PowerStateController.h"
 #include "Capabilities/PowerLevelController.h"
 
 /**
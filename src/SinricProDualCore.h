@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_DUALCORE_H_
+#define _SINRICPRO_DUALCORE_H_
+
+/*
+ * The dual core mode is compiled in by defining SINRICPRO_DUAL_CORE before including SinricPro.h (or as build flag).
+ * A worker task on SINRICPRO_WORKER_CORE does the network, verifies received messages and signs outgoing messages,
+ * SinricPro.handle() on the loop task only calls the device callbacks. See SinricProClass::handle().
+ */
+
+#ifdef SINRICPRO_DUAL_CORE
+
+#if defined(ESP8266)
+#error "SINRICPRO_DUAL_CORE needs an ESP32"
+#endif
+#ifdef SINRICPRO_HEAP_TRACKING
+#error "SINRICPRO_HEAP_TRACKING attributes allocations to the stages of one task and can't be used with SINRICPRO_DUAL_CORE"
+#endif
+
+#include <atomic>
+#include <functional>
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+#include "SinricProQueue.h"
+
+/**
+ * @brief A message stored in a SinricProSpscQueue, the message text follows this header (for IF_UDP after the sender of the message)
+ */
+struct SinricProSpscRecord {
+  uint16_t size;        // bytes used in the ring including this header, 0 marks where the producer wrapped around
+  uint8_t  interface;
+  uint8_t  priority;
+  uint16_t length;
+
+  const char* getMessage() const { return reinterpret_cast<const char*>(this + 1) + SinricProRemote::sizeFor(getInterface()); }
+  size_t getLength() const { return length; }
+  interface_t getInterface() const { return (interface_t) interface; }
+  message_priority_t getPriority() const { return (message_priority_t) priority; }
+  SinricProRemote getRemote() const;
+  char* text() { return reinterpret_cast<char*>(this + 1) + SinricProRemote::sizeFor(getInterface()); }
+};
+
+// the 6 byte header leaves the sender unaligned, so it is copied bytewise
+SinricProRemote SinricProSpscRecord::getRemote() const {
+  SinricProRemote remote = SinricProRemote();
+  if (getInterface() == IF_UDP) memcpy(&remote, this + 1, sizeof(remote));
+  return remote;
+}
+
+/**
+ * @brief Lock-free queue of messages between exactly one producer task and one consumer task
+ *
+ * Messages are stored one after another in a ring buffer of `SIZE` bytes like in SinricProQueue.
+ * The producer owns `_tail` and the consumer owns `_head`. A message becomes visible to the consumer when `_tail` is
+ * published after it has been written completely. A full queue drops the new message.
+ *
+ * @tparam SIZE size of the ring buffer in bytes, a multiple of 4
+ */
+template <size_t SIZE>
+class SinricProSpscQueue {
+  static_assert(SIZE % 4 == 0 && SIZE <= 0xFFFF, "SIZE must be a multiple of 4 and less than 64 KB");
+public:
+  SinricProSpscQueue() : _head(0), _tail(0), _dropped(0) {}
+
+  // producer
+  template <typename Writer>
+  bool push(interface_t interface, message_priority_t priority, size_t capacity, Writer write, SinricProRemote remote = SinricProRemote());
+  bool push(interface_t interface, message_priority_t priority, const char* message, size_t length, SinricProRemote remote = SinricProRemote());
+  size_t getDropped() const { return _dropped; }
+
+  // consumer
+  SinricProSpscRecord* front();
+  void pop();
+  bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+private:
+  SinricProSpscRecord* at(size_t offset) { return reinterpret_cast<SinricProSpscRecord*>(_ring + offset); }
+
+  alignas(4) uint8_t _ring[SIZE];
+  std::atomic<size_t> _head;  // offset of the oldest message, written by the consumer
+  std::atomic<size_t> _tail;  // offset behind the newest message, written by the producer
+  size_t _dropped;            // written by the producer
+};
+
+/**
+ * @brief Lets `write` write a message of up to `capacity` bytes straight into the queue
+ *
+ * @param write `size_t write(char* buffer, size_t capacity)` returns the length of the message written, the message is discarded if it returns 0
+ * @return false if the message didn't fit into the queue or `write` returned 0
+ */
+template <size_t SIZE>
+template <typename Writer>
+bool SinricProSpscQueue<SIZE>::push(interface_t interface, message_priority_t priority, size_t capacity, Writer write, SinricProRemote remote) {
+  size_t recordSize = (sizeof(SinricProSpscRecord) + SinricProRemote::sizeFor(interface) + capacity + 1 + 3) & ~(size_t) 3;
+  size_t tail = _tail.load(std::memory_order_relaxed);
+  size_t head = _head.load(std::memory_order_acquire);
+  size_t offset;
+  bool wrap = false;
+  // the tail must not reach the head, that would look like an empty queue
+  if (tail >= head) {                 // used: [head, tail), free: [tail, SIZE) and [0, head)
+    if (SIZE - tail > recordSize || (SIZE - tail == recordSize && head > 0)) {
+      offset = tail;
+    } else if (head > recordSize) {
+      offset = 0;
+      wrap = true;
+    } else {
+      _dropped++;
+      return false;
+    }
+  } else {                            // used: [head, SIZE) and [0, tail), free: [tail, head)
+    if (head - tail <= recordSize) {
+      _dropped++;
+      return false;
+    }
+    offset = tail;
+  }
+
+  SinricProSpscRecord* record = at(offset);
+  record->interface = interface;  // before text(), which depends on it
+  if (interface == IF_UDP) memcpy(record + 1, &remote, sizeof(remote));
+  size_t length = write(record->text(), capacity);
+  if (length == 0 || length > capacity) return false;
+  record->text()[length] = 0;
+  record->size = recordSize;
+  record->priority = priority;
+  record->length = length;
+  if (wrap) at(tail)->size = 0;       // tail < SIZE and a multiple of 4, so the marker fits
+  _tail.store((offset + recordSize) % SIZE, std::memory_order_release);
+  return true;
+}
+
+template <size_t SIZE>
+bool SinricProSpscQueue<SIZE>::push(interface_t interface, message_priority_t priority, const char* message, size_t length, SinricProRemote remote) {
+  return push(interface, priority, length, [message, length](char* buffer, size_t) {
+    memcpy(buffer, message, length);
+    return length;
+  }, remote);
+}
+
+template <size_t SIZE>
+SinricProSpscRecord* SinricProSpscQueue<SIZE>::front() {
+  size_t head = _head.load(std::memory_order_relaxed);
+  if (head == _tail.load(std::memory_order_acquire)) return nullptr;
+  if (at(head)->size == 0) {          // producer wrapped around here
+    head = 0;
+    _head.store(head, std::memory_order_release);
+  }
+  return at(head);
+}
+
+template <size_t SIZE>
+void SinricProSpscQueue<SIZE>::pop() {
+  SinricProSpscRecord* record = front();
+  if (!record) return;
+  _head.store((_head.load(std::memory_order_relaxed) + record->size) % SIZE, std::memory_order_release);
+}
+
+/**
+ * @brief Runs a function over and over in its own task: a FreeRTOS task pinned to SINRICPRO_WORKER_CORE on ESP32, a std::thread on the host
+ */
+class SinricProWorker {
+public:
+  typedef std::function<bool(void)> WorkFunction;  // returns false if there was nothing to do
+
+  SinricProWorker() : _running(false) {}
+  ~SinricProWorker() { stop(); }
+  void start(WorkFunction work);
+  void stop();
+  bool isRunning() const { return _running; }
+private:
+  void run();
+
+  WorkFunction      _work;
+  std::atomic<bool> _running;
+#if defined(ESP32)
+  std::atomic<bool> _finished;
+#else
+  std::thread       _thread;
+#endif
+};
+
+void SinricProWorker::start(WorkFunction work) {
+  if (_running) return;
+  _work = work;
+  _running = true;
+#if defined(ESP32)
+  _finished = false;
+#if CONFIG_FREERTOS_UNICORE
+  const BaseType_t core = tskNO_AFFINITY;
+#else
+  const BaseType_t core = SINRICPRO_WORKER_CORE;
+#endif
+  xTaskCreatePinnedToCore([](void* worker) {
+    static_cast<SinricProWorker*>(worker)->run();
+    vTaskDelete(nullptr);
+  }, "SinricPro", SINRICPRO_WORKER_STACK_SIZE, this, SINRICPRO_WORKER_PRIORITY, nullptr, core);
+#else
+  _thread = std::thread(&SinricProWorker::run, this);
+#endif
+}
+
+/**
+ * @brief Returns after the current run of the work function has finished
+ */
+void SinricProWorker::stop() {
+  if (!_running) return;
+  _running = false;
+#if defined(ESP32)
+  while (!_finished) vTaskDelay(1);
+#else
+  _thread.join();
+#endif
+}
+
+void SinricProWorker::run() {
+  while (_running) {
+    if (_work()) continue;
+#if defined(ESP32)
+    vTaskDelay(1);  // nothing to do, let lower priority tasks on this core run
+#else
+    std::this_thread::yield();
+#endif
+  }
+#if defined(ESP32)
+  _finished = true;
+#endif
+}
+
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_EVENTINTAKE_H_
+#define _SINRICPRO_EVENTINTAKE_H_
+
+#include <atomic>
+
+#include "SinricProConfig.h"
+
+// functions called from interrupt handlers must be placed in IRAM
+#if defined(ESP8266) || defined(ESP32)
+#define SINRICPRO_ISR_ATTR IRAM_ATTR
+#else
+#define SINRICPRO_ISR_ATTR
+#endif
+
+class SinricProDevice;
+
+/**
+ * @brief An event posted from an interrupt handler or another task, sent by SinricPro.handle()
+ */
+struct SinricProPostedEvent {
+  typedef bool (*SendFunction)(SinricProDevice &device, const SinricProPostedEvent &event);
+
+  SinricProDevice *device;
+  SendFunction     send;       // calls the device's send...Event() with the values of this event
+  const char      *cause;
+  bool             state;
+  float            values[2];
+};
+
+/**
+ * @class SinricProEventIntake
+ * @brief Bounded lock-free queue of posted events with any number of producers and one consumer
+ *
+ * Every slot carries a sequence number telling whose turn it is: a producer claims the next position with a
+ * compare-and-swap and publishes the event by setting the slot's sequence, the consumer frees the slot the same way.
+ * post() neither blocks, nor waits for another producer, nor allocates, so it can be called from interrupt handlers
+ * and from any task. An event posted while all SINRICPRO_EVENT_INTAKE_SLOTS slots are in use is dropped.
+ **/
+class SinricProEventIntake {
+  static_assert((SINRICPRO_EVENT_INTAKE_SLOTS & (SINRICPRO_EVENT_INTAKE_SLOTS - 1)) == 0, "SINRICPRO_EVENT_INTAKE_SLOTS must be a power of 2");
+public:
+  typedef void (*WakeupFunction)(void);
+
+  SinricProEventIntake();
+  void onPost(WakeupFunction wakeup) { _wakeup = wakeup; }
+  bool post(const SinricProPostedEvent &event);
+  bool take(SinricProPostedEvent &event);
+  bool hasEvent() const;
+  uint32_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence;
+    SinricProPostedEvent  event;
+  };
+
+  Slot                  _slots[SINRICPRO_EVENT_INTAKE_SLOTS];
+  std::atomic<uint32_t> _enqueue;   // next position to claim by a producer
+  uint32_t              _dequeue;   // next position to take, used by the consumer only
+  std::atomic<uint32_t> _dropped;
+  WakeupFunction        _wakeup;    // called after an event has been posted
+};
+
+SinricProEventIntake::SinricProEventIntake() : _enqueue(0), _dequeue(0), _dropped(0), _wakeup(nullptr) {
+  for (uint32_t i = 0; i < SINRICPRO_EVENT_INTAKE_SLOTS; i++) _slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Queues an event, may be called from interrupt handlers and any task
+ * @return false if all slots are in use and the event has been dropped
+ */
+SINRICPRO_ISR_ATTR bool SinricProEventIntake::post(const SinricProPostedEvent &event) {
+  uint32_t position = _enqueue.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &_slots[position & (SINRICPRO_EVENT_INTAKE_SLOTS - 1)];
+    int32_t turn = (int32_t) (slot->sequence.load(std::memory_order_acquire) - position);
+    if (turn == 0) {
+      if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+    } else if (turn < 0) {        // the slot still holds an event which has not been taken: full
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {                      // another producer claimed this position meanwhile
+      position = _enqueue.load(std::memory_order_relaxed);
+    }
+  }
+  slot->event = event;
+  slot->sequence.store(position + 1, std::memory_order_release);
+  if (_wakeup) _wakeup();
+  return true;
+}
+
+/**
+ * @brief Takes the oldest event, called by the consumer only
+ * @return false if there is no event (or the oldest event is still being written by an interrupted producer)
+ */
+bool SinricProEventIntake::take(SinricProPostedEvent &event) {
+  Slot &slot = _slots[_dequeue & (SINRICPRO_EVENT_INTAKE_SLOTS - 1)];
+  if ((int32_t) (slot.sequence.load(std::memory_order_acquire) - (_dequeue + 1)) < 0) return false;
+  event = slot.event;
+  slot.sequence.store(_dequeue + SINRICPRO_EVENT_INTAKE_SLOTS, std::memory_order_release);
+  _dequeue++;
+  return true;
+}
+
+/**
+ * @brief Returns whether take() would return an event, called by the consumer only
+ */
+bool SinricProEventIntake::hasEvent() const {
+  const Slot &slot = _slots[_dequeue & (SINRICPRO_EVENT_INTAKE_SLOTS - 1)];
+  return (int32_t) (slot.sequence.load(std::memory_order_acquire) - (_dequeue + 1)) >= 0;
+}
+
+#endif
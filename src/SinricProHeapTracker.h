@@ -0,0 +1,209 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_HEAPTRACKER_H_
+#define _SINRICPRO_HEAPTRACKER_H_
+
+/*
+ * Heap accounting is compiled in by defining SINRICPRO_HEAP_TRACKING before including SinricPro.h (or as build flag).
+ * Without it SINRICPRO_HEAP_STAGE() expands to nothing.
+ */
+
+#ifdef SINRICPRO_HEAP_TRACKING
+
+#if defined ESP32
+  #include <esp_heap_caps.h>
+#endif
+
+typedef enum {
+  HEAP_STAGE_CONNECT = 0,   // connecting to the server
+  HEAP_STAGE_RECEIVE,       // websocket and UDP, receiving and queueing messages
+  HEAP_STAGE_PARSE,         // parsing and verifying received messages
+  HEAP_STAGE_REQUEST,       // building and queueing responses
+  HEAP_STAGE_CALLBACK,      // capabilities and user callbacks handling a request
+  HEAP_STAGE_EVENT,         // building, rate limiting and queueing events
+  HEAP_STAGE_SEND,          // signing and sending queued messages
+  HEAP_STAGE_COUNT
+} heap_stage_t;
+
+/**
+ * @brief Heap state at one point in time, filled by the heap probe
+ *
+ * A probe fills what the platform can tell, everything else stays 0.
+ */
+struct SinricProHeapSnapshot {
+  uint32_t allocations;      // allocations made since start
+  uint32_t bytes;            // bytes requested by these allocations
+  uint32_t freeHeap;
+  uint32_t largestFreeBlock;
+};
+
+typedef void (*SinricProHeapProbe)(SinricProHeapSnapshot &snapshot);
+
+/**
+ * @class SinricProHeapTracker
+ * @brief Attributes heap allocations and heap growth to the stages of the library
+ *
+ * Stages are entered and left by SINRICPRO_HEAP_STAGE() and may nest (e.g. an event sent from a callback),
+ * the heap change is always added to the innermost stage only.
+ * On ESP8266 and ESP32 the default probe reads the free heap and the largest free block, so `retained` and
+ * fragmentation are measured. Counting single allocations needs a probe hooked into the allocator, see setProbe().
+ * @section getHeapTracker Example-Code
+ * @code
+ * SinricPro.getHeapTracker().printTo(Serial);
+ * @endcode
+ **/
+class SinricProHeapTracker {
+public:
+  struct StageStats {
+    uint32_t calls;
+    uint32_t allocations;
+    uint32_t bytes;
+    int32_t  retained;       // bytes the free heap shrank by, negative if memory was freed
+  };
+
+  SinricProHeapTracker();
+  void setProbe(SinricProHeapProbe probe);
+  const StageStats &getStage(heap_stage_t stage) const { return stages[stage]; }
+  StageStats total() const;
+  SinricProHeapSnapshot snapshot() const;
+  void reset();
+  void printTo(Print &out) const;
+
+  void enter(heap_stage_t stage);
+  void leave();
+
+  static SinricProHeapTracker &instance();
+  static const char *stageName(heap_stage_t stage);
+  static void defaultProbe(SinricProHeapSnapshot &snapshot);
+private:
+  void account(const SinricProHeapSnapshot &now);
+
+  StageStats stages[HEAP_STAGE_COUNT];
+  heap_stage_t stack[4];
+  uint8_t depth;
+  uint8_t ignoredDepth;      // stages nested deeper than the stack, accounted to the innermost tracked stage
+  SinricProHeapSnapshot last;
+  SinricProHeapProbe probe;
+};
+
+SinricProHeapTracker::SinricProHeapTracker() : depth(0), ignoredDepth(0), probe(defaultProbe) {
+  reset();
+}
+
+SinricProHeapTracker &SinricProHeapTracker::instance() {
+  static SinricProHeapTracker tracker;
+  return tracker;
+}
+
+void SinricProHeapTracker::defaultProbe(SinricProHeapSnapshot &snapshot) {
+#if defined ESP8266
+  snapshot.freeHeap = ESP.getFreeHeap();
+  snapshot.largestFreeBlock = ESP.getMaxFreeBlockSize();
+#elif defined ESP32
+  snapshot.freeHeap = ESP.getFreeHeap();
+  snapshot.largestFreeBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+#else
+  (void) snapshot;
+#endif
+}
+
+/**
+ * @brief Replace the function reading the heap state, e.g. by one counting allocations in a malloc wrapper
+ */
+void SinricProHeapTracker::setProbe(SinricProHeapProbe probe) {
+  this->probe = probe ? probe : defaultProbe;
+  last = snapshot();
+}
+
+SinricProHeapSnapshot SinricProHeapTracker::snapshot() const {
+  SinricProHeapSnapshot snapshot = {0, 0, 0, 0};
+  probe(snapshot);
+  return snapshot;
+}
+
+void SinricProHeapTracker::reset() {
+  for (auto &stage : stages) stage = StageStats { 0, 0, 0, 0 };
+  last = snapshot();
+}
+
+SinricProHeapTracker::StageStats SinricProHeapTracker::total() const {
+  StageStats sum = { 0, 0, 0, 0 };
+  for (auto &stage : stages) {
+    sum.calls += stage.calls;
+    sum.allocations += stage.allocations;
+    sum.bytes += stage.bytes;
+    sum.retained += stage.retained;
+  }
+  return sum;
+}
+
+void SinricProHeapTracker::account(const SinricProHeapSnapshot &now) {
+  if (depth) {
+    StageStats &stage = stages[stack[depth - 1]];
+    stage.allocations += now.allocations - last.allocations;
+    stage.bytes += now.bytes - last.bytes;
+    stage.retained += (int32_t) (last.freeHeap - now.freeHeap);
+  }
+  last = now;
+}
+
+void SinricProHeapTracker::enter(heap_stage_t stage) {
+  account(snapshot());
+  stages[stage].calls++;
+  if (depth < sizeof(stack) / sizeof(stack[0])) {
+    stack[depth++] = stage;
+  } else {
+    ignoredDepth++;
+  }
+}
+
+void SinricProHeapTracker::leave() {
+  account(snapshot());
+  if (ignoredDepth) {
+    ignoredDepth--;
+  } else if (depth) {
+    depth--;
+  }
+}
+
+const char *SinricProHeapTracker::stageName(heap_stage_t stage) {
+  static const char *names[HEAP_STAGE_COUNT] = { "connect", "receive", "parse", "request", "callback", "event", "send" };
+  return stage < HEAP_STAGE_COUNT ? names[stage] : "";
+}
+
+/**
+ * @brief Prints calls, allocations, bytes and retained bytes per stage and the current heap state
+ */
+void SinricProHeapTracker::printTo(Print &out) const {
+  for (int i = 0; i < HEAP_STAGE_COUNT; i++) {
+    const StageStats &stage = stages[i];
+    out.printf("%-10s calls=%lu allocations=%lu bytes=%lu retained=%ld\r\n", stageName((heap_stage_t) i), (unsigned long) stage.calls,
+               (unsigned long) stage.allocations, (unsigned long) stage.bytes, (long) stage.retained);
+  }
+  SinricProHeapSnapshot now = snapshot();
+  out.printf("free heap %lu, largest free block %lu\r\n", (unsigned long) now.freeHeap, (unsigned long) now.largestFreeBlock);
+}
+
+/**
+ * @brief Accounts the heap changes until the end of the enclosing block to a stage
+ */
+class SinricProHeapStage {
+public:
+  SinricProHeapStage(heap_stage_t stage) { SinricProHeapTracker::instance().enter(stage); }
+  ~SinricProHeapStage() { SinricProHeapTracker::instance().leave(); }
+};
+
+#define SINRICPRO_HEAP_STAGE(stage) SinricProHeapStage heapStage(stage)
+
+#else
+
+#define SINRICPRO_HEAP_STAGE(stage)
+
+#endif
+
+#endif
@@ -1,32 +1,122 @@
 #ifndef _SINRICID_H_
 #define _SINRICID_H_
 
+/**
+ * @brief Hex digit value of the ASCII characters 0..127, 0xFF for characters which are no hex digits
+ **/
+constexpr uint8_t SINRICPRO_HEX_VALUES[128] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+     0,    1,    2,    3,    4,    5,    6,    7,    8,    9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // '0'..'9'
+  0xFF,   10,   11,   12,   13,   14,   15, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 'A'..'F'
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF,   10,   11,   12,   13,   14,   15, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 'a'..'f'
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const char SINRICPRO_HEX_DIGITS[] = "0123456789abcdef";
+
+/**
+ * @brief Reads an id string into `data`
+ *
+ * The string holds the bytes from `data[size-1]` down to `data[0]`, two hex digits each, in groups separated by '-'.
+ * @param groups bytes per group, ending with 0
+ * @return `false` if the string doesn't match the format exactly, `data` is set to zero then
+ **/
+bool idFromHex(const char* str, uint8_t* data, size_t size, const uint8_t* groups) {
+  uint8_t* out = data + size;
+  bool valid = true;
+  for (const uint8_t* group = groups; valid && *group; group++) {
+    if (group != groups && *str++ != '-') valid = false;
+    for (uint8_t i = 0; valid && i < *group; i++) {
+      uint8_t high = (uint8_t) *str++;
+      if (high & 0x80 || (high = SINRICPRO_HEX_VALUES[high]) == 0xFF) { valid = false; break; } // stops at the terminator
+      uint8_t low = (uint8_t) *str++;
+      if (low & 0x80 || (low = SINRICPRO_HEX_VALUES[low]) == 0xFF) { valid = false; break; }
+      *--out = high << 4 | low;
+    }
+  }
+  if (valid && *str == '\0') return true;
+  memset(data, 0, size);
+  return false;
+}
+
+/**
+ * @brief Writes `data` as id string into `str`, the format is the one read by idFromHex()
+ *
+ * `str` must hold two characters per byte, one per separator and the terminating '\0'.
+ **/
+void idToHex(const uint8_t* data, size_t size, const uint8_t* groups, char* str) {
+  const uint8_t* in = data + size;
+  for (const uint8_t* group = groups; *group; group++) {
+    if (group != groups) *str++ = '-';
+    for (uint8_t i = 0; i < *group; i++) {
+      uint8_t value = *--in;
+      str[0] = SINRICPRO_HEX_DIGITS[value >> 4];
+      str[1] = SINRICPRO_HEX_DIGITS[value & 0x0F];
+      str += 2;
+    }
+  }
+  *str = '\0';
+}
+
+// compile time versions of idFromHex() for the id literals, see operator"" _deviceid
+
+constexpr uint8_t idHexValue(char c) {
+  return ((uint8_t) c & 0x80) ? 0xFF : SINRICPRO_HEX_VALUES[(uint8_t) c];
+}
+
+constexpr bool idHexDigitsAreValid(const char* str, size_t count) {
+  return count == 0 || (idHexValue(*str) != 0xFF && idHexDigitsAreValid(str + 1, count - 1));
+}
+
+constexpr bool idHexIsValid(const char* str, size_t length, const uint8_t* groups) {
+  return length >= 2u * *groups && idHexDigitsAreValid(str, 2 * *groups) &&
+         (groups[1] == 0 ? length == 2u * *groups
+                         : length > 2u * *groups && str[2 * *groups] == '-' && idHexIsValid(str + 2 * *groups + 1, length - 2 * *groups - 1, groups + 1));
+}
+
+// position of the hex digits of the index-th byte, counted from the start of the string
+constexpr size_t idHexOffset(const uint8_t* groups, size_t index, size_t offset = 0) {
+  return index < *groups ? offset + 2 * index : idHexOffset(groups + 1, index - *groups, offset + 2 * *groups + 1);
+}
+
+constexpr uint8_t idHexByte(const char* str, const uint8_t* groups, size_t index) {
+  return (uint8_t) (idHexValue(str[idHexOffset(groups, index)]) << 4 | idHexValue(str[idHexOffset(groups, index) + 1]));
+}
+
+template <size_t... I> struct SinricProIndexList {};
+template <size_t N, size_t... I> struct SinricProMakeIndexList : SinricProMakeIndexList<N - 1, N - 1, I...> {};
+template <size_t... I> struct SinricProMakeIndexList<0, I...> { typedef SinricProIndexList<I...> type; };
+
 #define DEVICEID_BINLEN 12 // 12 bytes long
 #define DEVICEID_STRLEN 24 // string needs to hold 24 characters
 
 struct DeviceId_Bin_t {
-  DeviceId_Bin_t() : _data{} {}
+  constexpr DeviceId_Bin_t() : _data{} {}
+  template <size_t... I>
+  constexpr DeviceId_Bin_t(const char* str, SinricProIndexList<I...>) : _data{ idHexByte(str, groups, DEVICEID_BINLEN - 1 - I)... } {} // str must be valid
   void fromString(const char * other);
   String toString() const;
+  void toChars(char * buffer) const;
   uint8_t _data[DEVICEID_BINLEN];
+  static constexpr uint8_t groups[] = { 12, 0 };
 };
 
+constexpr uint8_t DeviceId_Bin_t::groups[];
+
 void DeviceId_Bin_t::fromString(const char* other) {
-  char tmp;
-  bool _isValid = (sscanf(other,"%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%c",
-    &_data[11], &_data[10], &_data[9], &_data[8], &_data[7],  &_data[6],  &_data[5], &_data[4],
-    &_data[3],  &_data[2],  &_data[1], &_data[0],
-    &tmp
-  ) == sizeof(_data)) && (strlen(other) == DEVICEID_STRLEN);
-  if (!_isValid) memset((void*) &_data, 0, sizeof(_data));
+  idFromHex(other, _data, sizeof(_data), groups);
+}
+
+void DeviceId_Bin_t::toChars(char* buffer) const {
+  idToHex(_data, sizeof(_data), groups, buffer);
 }
 
 String DeviceId_Bin_t::toString() const {
   char temp[DEVICEID_STRLEN+1];
-  sprintf(temp, "%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x",
-    _data[11], _data[10], _data[9], _data[8], _data[7],  _data[6],  _data[5], _data[4],
-    _data[3],  _data[2],  _data[1], _data[0]
-  );
+  toChars(temp);
   return String(temp);
 }
 
@@ -35,28 +125,29 @@ String DeviceId_Bin_t::toString() const {
 #define APPKEY_STRLEN 36
 
 struct AppKey_Bin_t {
-  AppKey_Bin_t() : _data{} {}
+  constexpr AppKey_Bin_t() : _data{} {}
+  template <size_t... I>
+  constexpr AppKey_Bin_t(const char* str, SinricProIndexList<I...>) : _data{ idHexByte(str, groups, APPKEY_BINLEN - 1 - I)... } {} // str must be valid
   void fromString(const char * other);
   String toString() const;
+  void toChars(char * buffer) const;
   uint8_t _data[APPKEY_BINLEN];
+  static constexpr uint8_t groups[] = { 4, 2, 2, 2, 6, 0 };
 };
 
+constexpr uint8_t AppKey_Bin_t::groups[];
+
 void AppKey_Bin_t::fromString(const char* other) {
-  char tmp;
-  bool _isValid = (sscanf(other,"%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%c",
-    &_data[15], &_data[14], &_data[13], &_data[12], &_data[11], &_data[10], &_data[9],  &_data[8],
-    &_data[7],  &_data[6],  &_data[5],  &_data[4],  &_data[3],  &_data[2],  &_data[1],  &_data[0],
-    &tmp
-  ) == sizeof(_data)) && (strlen(other) == APPKEY_STRLEN);
-  if (!_isValid) memset((void*) &_data, 0, sizeof(_data));
+  idFromHex(other, _data, sizeof(_data), groups);
+}
+
+void AppKey_Bin_t::toChars(char* buffer) const {
+  idToHex(_data, sizeof(_data), groups, buffer);
 }
 
 String AppKey_Bin_t::toString() const {
   char temp[APPKEY_STRLEN+1];
-  sprintf(temp, "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-    _data[15], _data[14], _data[13], _data[12], _data[11], _data[10], _data[9],  _data[8],
-    _data[7],  _data[6],  _data[5],  _data[4],  _data[3],  _data[2],  _data[1],  _data[0]
-  );
+  toChars(temp);
   return String(temp);
 }
 
@@ -64,49 +155,46 @@ String AppKey_Bin_t::toString() const {
 #define APPSECRET_STRLEN 73
 
 struct AppSecret_Bin_t {
-  AppSecret_Bin_t() : _data{} {}
+  constexpr AppSecret_Bin_t() : _data{} {}
+  template <size_t... I>
+  constexpr AppSecret_Bin_t(const char* str, SinricProIndexList<I...>) : _data{ idHexByte(str, groups, APPSECRET_BINLEN - 1 - I)... } {} // str must be valid
   void fromString(const char * other);
   String toString() const;
+  void toChars(char * buffer) const;
   uint8_t _data[APPSECRET_BINLEN];
+  static constexpr uint8_t groups[] = { 4, 2, 2, 2, 6, 4, 2, 2, 2, 6, 0 };
 };
 
+constexpr uint8_t AppSecret_Bin_t::groups[];
+
 void AppSecret_Bin_t::fromString(const char* other) {
-  char tmp;
-  bool _isValid = (sscanf(other, "%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx%c",
-    &_data[31], &_data[30], &_data[29], &_data[28], &_data[27], &_data[26], &_data[25], &_data[24],
-    &_data[23], &_data[22], &_data[21], &_data[20], &_data[19], &_data[18], &_data[17], &_data[16],
-    &_data[15], &_data[14], &_data[13], &_data[12], &_data[11], &_data[10], &_data[ 9], &_data[ 8],
-    &_data[ 7], &_data[ 6], &_data[ 5], &_data[ 4], &_data[ 3], &_data[ 2], &_data[ 1], &_data[ 0],
-    &tmp
-  ) == sizeof(_data)) && (strlen(other) == APPSECRET_STRLEN);
-  if (!_isValid) memset((void*) &_data, 0, sizeof(_data));
+  idFromHex(other, _data, sizeof(_data), groups);
+}
+
+void AppSecret_Bin_t::toChars(char* buffer) const {
+  idToHex(_data, sizeof(_data), groups, buffer);
 }
 
 String AppSecret_Bin_t::toString() const {
   char temp[APPSECRET_STRLEN+1];
-  sprintf(temp, "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x-%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-    _data[31], _data[30], _data[29], _data[28], _data[27], _data[26], _data[25], _data[24],
-    _data[23], _data[22], _data[21], _data[20], _data[19], _data[18], _data[17], _data[16],
-    _data[15], _data[14], _data[13], _data[12], _data[11], _data[10], _data[ 9], _data[ 8],
-    _data[ 7], _data[ 6], _data[ 5], _data[ 4], _data[ 3], _data[ 2], _data[ 1], _data[ 0]
-  );
+  toChars(temp);
   return String(temp);
 }
 
 template <class T>
 class SinricProId {
   public:
-    SinricProId() : _data() {};
+    constexpr SinricProId() : _data() {};
     SinricProId(const char* other) { _data.fromString(other); }
     SinricProId(const String &other) { _data.fromString(other.c_str()); }
-    SinricProId(const SinricProId &other) { copy(other); }
-    SinricProId(const T &other) { copy(other); }
+    constexpr SinricProId(const SinricProId &other) : _data(other._data) {}
+    constexpr SinricProId(const T &other) : _data(other) {}
     SinricProId(const uint8_t other[], size_t size) { copy(other, size); }
 
     SinricProId operator=(const SinricProId &other) { copy(other); return *this; }
     SinricProId operator=(const char* other) { fromString(other); return *this; }
     SinricProId operator=(const String &other) { fromString(other.c_str()); return *this; }
-    SinricProId operator=(const T &other) { copy(other); }
+    SinricProId operator=(const T &other) { copy(other); return *this; }
 
     bool operator==(const SinricProId &other) const { return compare(other); }
     bool operator==(const char* other) const { return compare((SinricProId) other); }
@@ -117,18 +205,21 @@ class SinricProId {
     bool operator!=(const char* other) const { return !compare(other); }
     bool operator!=(const String &other) const { return !compare(other); }
     bool operator!=(const T &other) const { return !compare(other); }
+
+    bool operator<(const SinricProId &other) const { return memcmp(_data._data, other._data._data, sizeof(_data._data)) < 0; }
     
     operator bool() const { return isValid(); }
     operator String() const { return _data.toString(); }
     
     String toString() const { return _data.toString(); };
+    void toChars(char* buffer) const { _data.toChars(buffer); } // buffer must hold ..._STRLEN+1 characters, e.g. DEVICEID_STRLEN+1
     const char* c_str() const { static String str = _data.toString(); return str.c_str(); }
     bool isValid() const { return !compare(SinricProId<T>()); }
   
   private:
     void fromString(const char * other) { _data.fromString(other); }
     void copy(const SinricProId &other) { memcpy(_data._data, other._data._data, sizeof(_data._data)); }    
-    void copy(const T &other) { memcpy(_data, other, sizeof(_data)); }
+    void copy(const T &other) { _data = other; }
     void copy(const uint8_t other[], size_t size) { memcpy(_data._data, other, min(sizeof(_data._data), size)); }
     bool compare(const SinricProId &other) const { return memcmp(_data._data, other._data._data, sizeof(_data._data)) == 0;}
     T _data;
@@ -138,4 +229,43 @@ typedef SinricProId<DeviceId_Bin_t> DeviceId;
 typedef SinricProId<AppKey_Bin_t> AppKey;
 typedef SinricProId<AppSecret_Bin_t> AppSecret;
 
+// not constexpr: using a malformed id literal in a constant expression fails to compile with a call to this function
+void idLiteralIsMalformed() {}
+
+/**
+ * @brief Device id literal, converted and checked at compile time when used in a constant expression
+ *
+ * Only the 12 binary bytes of a `constexpr DeviceId` end up in the program, there's no parsing at runtime.
+ * A malformed id fails to compile with "call to non-'constexpr' function 'void idLiteralIsMalformed()'".
+ * Used in other places, a malformed literal gives an invalid DeviceId, as a malformed string does.
+ * @section _deviceid Example-Code
+ * @code
+ * constexpr DeviceId SWITCH_ID = "5dc1564130xxxxxxxxxxxxxx"_deviceid;
+ * SinricProSwitch &mySwitch = SinricPro[SWITCH_ID];
+ * @endcode
+ **/
+constexpr DeviceId operator"" _deviceid(const char* str, size_t length) {
+  return idHexIsValid(str, length, DeviceId_Bin_t::groups) ? DeviceId(DeviceId_Bin_t(str, SinricProMakeIndexList<DEVICEID_BINLEN>::type())) : (idLiteralIsMalformed(), DeviceId());
+}
+
+/**
+ * @brief App key literal, see operator"" _deviceid
+ * @code
+ * constexpr AppKey APP_KEY = "de0bxxxx-1x3x-4x3x-ax2x-5dabxxxxxxxx"_appkey;
+ * @endcode
+ **/
+constexpr AppKey operator"" _appkey(const char* str, size_t length) {
+  return idHexIsValid(str, length, AppKey_Bin_t::groups) ? AppKey(AppKey_Bin_t(str, SinricProMakeIndexList<APPKEY_BINLEN>::type())) : (idLiteralIsMalformed(), AppKey());
+}
+
+/**
+ * @brief App secret literal, see operator"" _deviceid
+ * @code
+ * constexpr AppSecret APP_SECRET = "5f36xxxx-x3x7-4x3x-xexe-e86724a9xxxx-4c4axxxx-3x3x-x5xe-x9x3-333d65xxxxxx"_appsecret;
+ * @endcode
+ **/
+constexpr AppSecret operator"" _appsecret(const char* str, size_t length) {
+  return idHexIsValid(str, length, AppSecret_Bin_t::groups) ? AppSecret(AppSecret_Bin_t(str, SinricProMakeIndexList<APPSECRET_BINLEN>::type())) : (idLiteralIsMalformed(), AppSecret());
+}
+
 #endif
\ No newline at end of file
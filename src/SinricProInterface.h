@@ -11,14 +11,17 @@
 #include "ArduinoJson.h"
 #include "SinricProQueue.h"
 #include "SinricProId.h"
+#include "SinricProJsonPool.h"
+#include "SinricProEventIntake.h"
 
 class SinricProInterface {
   friend class SinricProDevice;
   protected:
-    virtual void sendMessage(JsonDocument& jsonEvent);
-    virtual DynamicJsonDocument prepareEvent(DeviceId deviceId, const char* action, const char* cause);
-    virtual unsigned long getTimestamp(); 
-    virtual bool isConnected();
+    virtual bool sendMessage(JsonDocument& jsonEvent) = 0;  // false if the message could not be queued
+    virtual SinricProJsonDocument prepareEvent(DeviceId deviceId, const char* action, const char* cause) = 0;
+    virtual unsigned long getTimestamp() = 0;
+    virtual bool isConnected() = 0;
+    virtual SinricProEventIntake* getEventIntake() { return nullptr; }
 };
 
 
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_JSONPOOL_H_
+#define _SINRICPRO_JSONPOOL_H_
+
+#include <utility>
+#include <ArduinoJson.h>
+#include "SinricProConfig.h"
+#include "SinricProDebug.h"
+
+class SinricProJsonPool;
+
+/**
+ * @class SinricProJsonDocument
+ * @brief A JsonDocument lent out by a SinricProJsonPool
+ *
+ * The document goes back to its pool when the SinricProJsonDocument goes out of scope.
+ * It can be used like a JsonDocument: `eventMessage["payload"]["value"]` and `sendEvent(eventMessage)` work as before.
+ **/
+class SinricProJsonDocument {
+  friend class SinricProJsonPool;
+public:
+  SinricProJsonDocument();
+  SinricProJsonDocument(SinricProJsonDocument &&other);
+  ~SinricProJsonDocument();
+
+  JsonDocument &get() { return *_document; }
+  operator JsonDocument &() { return *_document; }
+  JsonDocument *operator->() { return _document; }
+
+  template <typename TKey>
+  auto operator[](const TKey &key) -> decltype(std::declval<JsonDocument &>()[key]) { return (*_document)[key]; }
+private:
+  SinricProJsonDocument(SinricProJsonPool *pool, DynamicJsonDocument *document) : _pool(pool), _document(document) {}
+  SinricProJsonDocument(const SinricProJsonDocument &) = delete;
+  SinricProJsonDocument &operator=(const SinricProJsonDocument &) = delete;
+
+  SinricProJsonPool *_pool;       // nullptr if the document isn't part of a pool
+  DynamicJsonDocument *_document;
+};
+
+/**
+ * @class SinricProJsonPool
+ * @brief Keeps a few JsonDocuments allocated to be reused for every message
+ *
+ * Each document is allocated once, when it's needed for the first time, and is kept for the lifetime of the pool.
+ * This keeps the heap from being fragmented by a new 1 KB document for each message.
+ * If all documents are in use (e.g. an event sent from inside a callback) a temporary document is allocated.
+ **/
+class SinricProJsonPool {
+  friend class SinricProJsonDocument;
+public:
+  SinricProJsonPool();
+  ~SinricProJsonPool();
+  SinricProJsonDocument borrow();
+private:
+  void giveBack(DynamicJsonDocument *document);
+
+  DynamicJsonDocument *documents[SINRICPRO_JSON_POOL_SIZE];
+  bool inUse[SINRICPRO_JSON_POOL_SIZE];
+};
+
+SinricProJsonDocument::SinricProJsonDocument() : _pool(nullptr), _document(new DynamicJsonDocument(SINRICPRO_JSON_DOCUMENT_SIZE)) {}
+
+SinricProJsonDocument::SinricProJsonDocument(SinricProJsonDocument &&other) : _pool(other._pool), _document(other._document) {
+  other._pool = nullptr;
+  other._document = nullptr;
+}
+
+SinricProJsonDocument::~SinricProJsonDocument() {
+  if (_pool) {
+    _pool->giveBack(_document);
+  } else {
+    delete _document;
+  }
+}
+
+SinricProJsonPool::SinricProJsonPool() {
+  for (size_t i = 0; i < SINRICPRO_JSON_POOL_SIZE; i++) {
+    documents[i] = nullptr;
+    inUse[i] = false;
+  }
+}
+
+SinricProJsonPool::~SinricProJsonPool() {
+  for (size_t i = 0; i < SINRICPRO_JSON_POOL_SIZE; i++) delete documents[i];
+}
+
+/**
+ * @brief Lend out an empty document
+ */
+SinricProJsonDocument SinricProJsonPool::borrow() {
+  for (size_t i = 0; i < SINRICPRO_JSON_POOL_SIZE; i++) {
+    if (inUse[i]) continue;
+    if (!documents[i]) documents[i] = new DynamicJsonDocument(SINRICPRO_JSON_DOCUMENT_SIZE);
+    inUse[i] = true;
+    documents[i]->clear();
+    return SinricProJsonDocument(this, documents[i]);
+  }
+  DEBUG_SINRIC("[SinricProJsonPool:borrow()]: all documents are in use, allocating a temporary document\r\n");
+  return SinricProJsonDocument();
+}
+
+void SinricProJsonPool::giveBack(DynamicJsonDocument *document) {
+  for (size_t i = 0; i < SINRICPRO_JSON_POOL_SIZE; i++) {
+    if (documents[i] == document) inUse[i] = false;
+  }
+}
+
+#endif
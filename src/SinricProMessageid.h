@@ -8,27 +8,57 @@
 #ifndef __MESSAGEID_H__
 #define __MESSAGEID_H__
 
+#if defined ESP32
+  #include <esp_system.h>
+#endif
+
+#include "SinricProId.h"
+
+#define MESSAGEID_BINLEN 16
+#define MESSAGEID_STRLEN 36
+
+/**
+ * @brief Random UUID (version 4), used as replyToken of events and requests
+ *
+ * The random bytes are taken from the hardware random number generator on ESP8266 and ESP32
+ * and formatted into a fixed buffer, so creating a MessageID doesn't allocate memory.
+ **/
 class MessageID {
 public:
   MessageID();
-  const String& getID() { return _id; }
+  char* getID() { return _id; } // not const, so ArduinoJson copies it into the document
+  static void fillRandom(uint8_t* buffer, size_t length);
 private:
-  String _id;
+  char _id[MESSAGEID_STRLEN+1];
 };
 
 MessageID::MessageID() {
-  _id = "";
-  for (byte i=0; i<16; i++) {
-    byte rnd = random(255);
-    if (i==4) _id += "-";
-    if (i==6) { _id += "-"; rnd = 0x40 | (0x0F & rnd); } // 0100xxxx to set version 4
-    if (i==8) { _id += "-"; rnd = 0x80 | (0x3F & rnd); } // 10xxxxxx to set reserved bits
-    if (i==10) _id += "-";
-    byte high_nibble = rnd >> 4;
-    byte low_nibble = rnd & 0x0f;
-    _id += "0123456789abcdef"[high_nibble];
-    _id += "0123456789abcdef"[low_nibble];
+  static const uint8_t groups[] = { 4, 2, 2, 2, 6, 0 };
+  uint8_t bytes[MESSAGEID_BINLEN];
+  fillRandom(bytes, sizeof(bytes));
+  // idToHex() writes the bytes from the last to the first
+  bytes[9] = 0x40 | (0x0F & bytes[9]); // 0100xxxx to set version 4
+  bytes[7] = 0x80 | (0x3F & bytes[7]); // 10xxxxxx to set reserved bits
+  idToHex(bytes, sizeof(bytes), groups, _id);
+}
+
+/**
+ * @brief Fills `buffer` with random bytes, from the hardware random number generator on ESP8266 and ESP32
+ **/
+void MessageID::fillRandom(uint8_t* buffer, size_t length) {
+#if defined ESP8266
+  while (length) {
+    uint32_t rnd = RANDOM_REG32;
+    size_t count = min(length, sizeof(rnd));
+    memcpy(buffer, &rnd, count);
+    buffer += count;
+    length -= count;
   }
+#elif defined ESP32
+  esp_fill_random(buffer, length);
+#else
+  for (size_t i = 0; i < length; i++) buffer[i] = random(256);
+#endif
 }
 
 #endif // __MESSAGEID_H__
@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_METRICS_H_
+#define _SINRICPRO_METRICS_H_
+
+/*
+ * Runtime metrics are compiled in by defining SINRICPRO_METRICS before including SinricPro.h (or as build flag).
+ * Without it the SINRICPRO_METRICS_... macros expand to nothing, so metrics cost neither time nor memory.
+ */
+
+#ifdef SINRICPRO_METRICS
+
+#include <atomic>
+#include "SinricProConfig.h"
+#include "SinricProRateLimiter.h"
+
+/**
+ * @class SinricProCounter
+ * @brief Counter written by the task calling SinricPro.handle(), readable from any task or core without locking
+ **/
+class SinricProCounter {
+public:
+  SinricProCounter() : _value(0) {}
+  void add(uint32_t n = 1) { _value.store(_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+  void max(uint32_t value) { if (value > _value.load(std::memory_order_relaxed)) _value.store(value, std::memory_order_relaxed); }
+  uint32_t get() const { return _value.load(std::memory_order_relaxed); }
+  void reset() { _value.store(0, std::memory_order_relaxed); }
+private:
+  std::atomic<uint32_t> _value; // single writer: plain loads and stores, no read-modify-write instructions needed
+};
+
+/**
+ * @class SinricProHistogram
+ * @brief Fixed size histogram of durations in microseconds
+ *
+ * Bucket 0 counts 0 µs, bucket i counts durations from 2^(i-1) to 2^i-1 µs, the last bucket counts everything longer.
+ **/
+class SinricProHistogram {
+public:
+  void record(uint32_t micros);
+  uint32_t count() const { return _count.get(); }
+  uint32_t max() const { return _max.get(); }
+  uint32_t bucket(size_t index) const { return _buckets[index].get(); }
+  uint32_t percentile(uint8_t percent) const;
+  void reset();
+
+  static size_t bucketIndex(uint32_t micros);
+  static uint32_t bucketLimit(size_t index);
+private:
+  SinricProCounter _buckets[SINRICPRO_METRICS_BUCKETS];
+  SinricProCounter _count;
+  SinricProCounter _max;
+};
+
+size_t SinricProHistogram::bucketIndex(uint32_t micros) {
+  size_t index = micros ? 32 - __builtin_clz(micros) : 0;
+  return index < SINRICPRO_METRICS_BUCKETS ? index : SINRICPRO_METRICS_BUCKETS - 1;
+}
+
+/**
+ * @brief Longest duration counted by a bucket, UINT32_MAX for the last bucket
+ */
+uint32_t SinricProHistogram::bucketLimit(size_t index) {
+  if (index >= SINRICPRO_METRICS_BUCKETS - 1) return UINT32_MAX;
+  return (1ul << index) - 1;
+}
+
+void SinricProHistogram::record(uint32_t micros) {
+  _buckets[bucketIndex(micros)].add();
+  _count.add();
+  _max.max(micros);
+}
+
+/**
+ * @brief Upper limit of the bucket holding the given percentile, limited to the longest recorded duration
+ * @param percent 1..100, e.g. 50 for the median or 99
+ * @return 0 if nothing has been recorded
+ */
+uint32_t SinricProHistogram::percentile(uint8_t percent) const {
+  uint32_t total = count();
+  if (total == 0) return 0;
+  uint32_t rank = (uint32_t) (((uint64_t) total * percent + 99) / 100);
+  uint32_t seen = 0;
+  for (size_t i = 0; i < SINRICPRO_METRICS_BUCKETS; i++) {
+    seen += bucket(i);
+    if (seen >= rank) return bucketLimit(i) < max() ? bucketLimit(i) : max();
+  }
+  return max();
+}
+
+void SinricProHistogram::reset() {
+  for (auto& bucket : _buckets) bucket.reset();
+  _count.reset();
+  _max.reset();
+}
+
+/**
+ * @class SinricProMetrics
+ * @brief Latency histograms and counters of the message pipeline, returned by SinricPro.getMetrics()
+ *
+ * All durations are in microseconds. Values are written by SinricPro.handle() only and may be read at any time,
+ * a reader may see a histogram in the middle of an update (e.g. count already incremented, bucket not yet).
+ * @section getMetrics Example-Code
+ * @code
+ * SinricProMetrics &metrics = SinricPro.getMetrics();
+ * Serial.printf("setPowerState p99: %lu us\r\n", metrics.getCallbackTime("setPowerState")->percentile(99));
+ * metrics.printTo(Serial);
+ * @endcode
+ **/
+class SinricProMetrics {
+public:
+  SinricProHistogram receiveToDispatch;   // from receiving a message to the start of its handling
+  SinricProHistogram signatureVerify;     // verifying the signature of a received message
+  SinricProHistogram responseBuild;       // from the return of the callback until the response is queued
+  SinricProHistogram sign;                // stamping and signing an outgoing message
+  SinricProHistogram sendQueueDwell;      // from queueing an outgoing message until it's sent
+  SinricProCounter   rateLimitedEvents;   // events dropped by the rate limits
+  SinricProCounter   signatureFailures;   // received messages with an invalid signature
+  SinricProCounter   unsignedMessages;    // outgoing messages dropped because they could not be signed
+  SinricProCounter   receiveQueueHighWater; // most messages waiting in the receive queue at once
+  SinricProCounter   sendQueueHighWater;    // most messages waiting in the send queue at once
+
+  SinricProMetrics();
+  SinricProHistogram &callbackTime(const char *action);
+  const SinricProHistogram *getCallbackTime(const char *action) const;
+  void reset();
+  void printTo(Print &out) const;
+
+  static SinricProMetrics &instance();
+private:
+  struct ActionMetrics {
+    uint8_t actionId;
+    SinricProHistogram callback;          // handling a request including the user callback
+  };
+  ActionMetrics actions[SINRICPRO_METRICS_ACTIONS];
+  std::atomic<uint8_t> actionCount;
+};
+
+SinricProMetrics::SinricProMetrics() : actionCount(0) {}
+
+SinricProMetrics &SinricProMetrics::instance() {
+  static SinricProMetrics metrics;
+  return metrics;
+}
+
+/**
+ * @brief Callback histogram of an action, the first SINRICPRO_METRICS_ACTIONS actions get their own, further actions share the last one
+ */
+SinricProHistogram &SinricProMetrics::callbackTime(const char *action) {
+  uint8_t actionId = SinricProEventLimiter::actionId(action);
+  uint8_t count = actionCount.load(std::memory_order_relaxed);
+  for (uint8_t i = 0; i < count; i++) {
+    if (actions[i].actionId == actionId) return actions[i].callback;
+  }
+  if (count == SINRICPRO_METRICS_ACTIONS) return actions[count - 1].callback;
+  actions[count].actionId = actionId;
+  actionCount.store(count + 1, std::memory_order_release); // readers see the slot only after its id has been set
+  return actions[count].callback;
+}
+
+/**
+ * @brief Callback histogram of an action, `nullptr` if no request for this action has been handled yet
+ */
+const SinricProHistogram *SinricProMetrics::getCallbackTime(const char *action) const {
+  uint8_t count = actionCount.load(std::memory_order_acquire);
+  for (uint8_t i = 0; i < count; i++) {
+    if (strcmp(SinricProEventLimiter::actionName(actions[i].actionId), action) == 0) return &actions[i].callback;
+  }
+  return nullptr;
+}
+
+void SinricProMetrics::reset() {
+  receiveToDispatch.reset();
+  signatureVerify.reset();
+  responseBuild.reset();
+  sign.reset();
+  sendQueueDwell.reset();
+  rateLimitedEvents.reset();
+  signatureFailures.reset();
+  unsignedMessages.reset();
+  receiveQueueHighWater.reset();
+  sendQueueHighWater.reset();
+  for (auto &action : actions) action.callback.reset();
+}
+
+/**
+ * @brief Prints count, median, 99th percentile and maximum of each histogram and all counters
+ */
+void SinricProMetrics::printTo(Print &out) const {
+  auto printHistogram = [&out](const char *name, const SinricProHistogram &histogram) {
+    out.printf("%-24s n=%lu p50=%lu p99=%lu max=%lu us\r\n", name, (unsigned long) histogram.count(), (unsigned long) histogram.percentile(50),
+               (unsigned long) histogram.percentile(99), (unsigned long) histogram.max());
+  };
+  printHistogram("receive to dispatch", receiveToDispatch);
+  printHistogram("signature verify", signatureVerify);
+  for (uint8_t i = 0; i < actionCount.load(std::memory_order_acquire); i++) printHistogram(SinricProEventLimiter::actionName(actions[i].actionId), actions[i].callback);
+  printHistogram("response build", responseBuild);
+  printHistogram("sign", sign);
+  printHistogram("send queue dwell", sendQueueDwell);
+  out.printf("rate limited events %lu, signature failures %lu, unsigned messages %lu, queue high water receive %lu send %lu\r\n", (unsigned long) rateLimitedEvents.get(),
+             (unsigned long) signatureFailures.get(), (unsigned long) unsignedMessages.get(), (unsigned long) receiveQueueHighWater.get(), (unsigned long) sendQueueHighWater.get());
+}
+
+#define SINRICPRO_METRICS_START(start)              unsigned long start = micros()
+#define SINRICPRO_METRICS_RECORD(histogram, start)  SinricProMetrics::instance().histogram.record(micros() - (start))
+#define SINRICPRO_METRICS_CALLBACK(action, start)   SinricProMetrics::instance().callbackTime(action).record(micros() - (start))
+#define SINRICPRO_METRICS_COUNT(counter)            SinricProMetrics::instance().counter.add()
+#define SINRICPRO_METRICS_MAX(counter, value)       SinricProMetrics::instance().counter.max(value)
+
+#else
+
+#define SINRICPRO_METRICS_START(start)
+#define SINRICPRO_METRICS_RECORD(histogram, start)
+#define SINRICPRO_METRICS_CALLBACK(action, start)
+#define SINRICPRO_METRICS_COUNT(counter)
+#define SINRICPRO_METRICS_MAX(counter, value)
+
+#endif
+
+#endif
@@ -9,7 +9,7 @@
 #define _SINRICPOWERSENSOR_H_
 
 #include "SinricProDevice.h"
-#include "Capabilities/PowerSensorEventSource.h"
+#include "Capabilities/PowerSensor.h"
 
 /**
  * @class SinricProPowerSensor
@@ -8,7 +8,12 @@
 #ifndef __SINRICPRO_QUEUE_H__
 #define __SINRICPRO_QUEUE_H__
 
-#include <queue>
+#include <functional>
+#include <ArduinoJson.h>
+#include "SinricProConfig.h"
+
+#define MESSAGE_TIMESTAMP_RESERVE 20 // room for createdAt to grow from placeholder "0" to the current timestamp
+#define MESSAGE_SIGNATURE_RESERVE 69 // room for ,"signature":{"HMAC":"<44 base64 chars>"}}
 
 typedef enum {
   IF_UNKNOWN    = 0,
@@ -16,35 +21,525 @@ typedef enum {
   IF_UDP        = 2
 } interface_t;
 
+/**
+ * @brief Sender of a message received by UDP, the response is sent back there (unused for IF_WEBSOCKET)
+ */
+struct SinricProRemote {
+  uint32_t ip;
+  uint16_t port;
+
+  // bytes a queued record spends on its sender: only records of messages received by UDP store one, between header and text
+  static constexpr size_t sizeFor(interface_t interface) { return interface == IF_UDP ? sizeof(SinricProRemote) : 0; }
+};
+
+/**
+ * @brief What SinricProQueue::push() does when a message doesn't fit into the queue
+ */
+typedef enum {
+  QUEUE_DROP_NEWEST = 0,  // the new message is dropped
+  QUEUE_DROP_OLDEST = 1,  // the oldest messages are dropped until the new message fits
+  QUEUE_BLOCK       = 2   // the queue is drained by its consumer first, if this doesn't make room the new message is dropped
+} queue_overflow_t;
+
+/**
+ * @brief A message stored in a SinricProQueue
+ *
+ * The message text follows this header directly in the queue's arena, for IF_UDP after the sender of the message.
+ * A message is valid until it is popped from its queue.
+ */
 class SinricProMessage {
+  template <size_t> friend class SinricProQueue;
 public:
-  SinricProMessage(interface_t interface, const char* message);
-  ~SinricProMessage();
   const char* getMessage() const;
+  size_t getLength() const;
   interface_t getInterface() const;
+  SinricProRemote getRemote() const;
+
+  bool isSignable() const;
+  bool setCreatedAt(unsigned long timestamp);
+  const char* getPayload() const;
+  size_t getPayloadLength() const;
+  bool setSignature(const char* signature);
+#ifdef SINRICPRO_METRICS
+  unsigned long getQueuedAt() const { return _queuedAt; }
+#endif
 private:
-  interface_t _interface;
-  char* _message;
+  char* text() { return reinterpret_cast<char*>(this + 1) + SinricProRemote::sizeFor(getInterface()); }
+  void init(interface_t interface, size_t capacity, SinricProRemote remote);
+  void fromString(const char* message, size_t length);
+  void fromUnsigned(const char* message, size_t length);
+  void fromJson(JsonDocument& jsonMessage);
+  void findPayload();
+
+  uint16_t _size;            // bytes used in the arena including this header, 0 marks where the queue wrapped around
+  uint8_t  _interface;
+  uint8_t  _createdAtLength; // length of payload.createdAt value
+  uint16_t _length;
+  uint16_t _capacity;
+  uint16_t _payload;         // offset of payload object, 0 if message can't be signed
+  uint16_t _createdAt;       // offset of payload.createdAt value
+#ifdef SINRICPRO_METRICS
+  uint32_t _queuedAt;        // micros() when the message was queued
+#endif
 };
 
-SinricProMessage::SinricProMessage(interface_t interface, const char* message) : 
-  _interface(interface) { 
-  _message = strdup(message); 
+void SinricProMessage::init(interface_t interface, size_t capacity, SinricProRemote remote) {
+  _interface = interface;
+  if (interface == IF_UDP) *reinterpret_cast<SinricProRemote*>(this + 1) = remote;
+  _createdAtLength = 0;
+  _length = 0;
+  _capacity = capacity;
+  _payload = 0;
+  _createdAt = 0;
+#ifdef SINRICPRO_METRICS
+  _queuedAt = micros();
+#endif
+  text()[0] = 0;
 };
 
-SinricProMessage::~SinricProMessage() { 
-  if (_message) free(_message); 
+void SinricProMessage::fromString(const char* message, size_t length) {
+  memcpy(text(), message, length);
+  text()[length] = 0;
+  _length = length;
 };
 
-const char* SinricProMessage::getMessage() const { 
-  return _message; 
+/**
+ * @brief Serializes an outgoing message once, ready to be signed in place
+ *
+ * The message is serialized into a buffer with enough spare room to patch `payload.createdAt`
+ * and to append the signature when the message gets sent. This way the message must not be parsed again.
+ * Requires a message containing a `header` object followed by a `payload` object which contains `createdAt`
+ * and no `signature` object (like messages created by prepareEvent() and prepareResponse()).
+ */
+void SinricProMessage::fromJson(JsonDocument& jsonMessage) {
+  _length = serializeJson(jsonMessage, text(), _capacity + 1);
+  if (!jsonMessage.containsKey("signature")) findPayload();
+};
+
+/**
+ * @brief Copies an outgoing message serialized by serializeJson() elsewhere, ready to be signed in place like fromJson()
+ */
+void SinricProMessage::fromUnsigned(const char* message, size_t length) {
+  fromString(message, length);
+  if (!strstr(text(), "\"signature\":")) findPayload();
 };
 
-interface_t SinricProMessage::getInterface() const { 
-  return _interface; 
+// locates payload and payload.createdAt, the message can't be signed if one is missing
+void SinricProMessage::findPayload() {
+  char* message = text();
+  if (_length < 2 || message[_length-1] != '}' || message[_length-2] != '}') return;
+  const char* payload = strstr(message, "\"payload\":{");
+  if (!payload) return;
+  const char* createdAt = strstr(payload, "\"createdAt\":");
+  if (!createdAt) return;
+
+  _payload = payload + 10 - message;
+  _createdAt = createdAt + 12 - message;
+  _createdAtLength = strspn(message + _createdAt, "0123456789");
+};
+
+const char* SinricProMessage::getMessage() const {
+  return reinterpret_cast<const char*>(this + 1) + SinricProRemote::sizeFor(getInterface());
+};
+
+/**
+ * @brief Sender of a message received by UDP, where its response goes to (empty for other interfaces)
+ */
+SinricProRemote SinricProMessage::getRemote() const {
+  return getInterface() == IF_UDP ? *reinterpret_cast<const SinricProRemote*>(this + 1) : SinricProRemote();
 };
 
+size_t SinricProMessage::getLength() const {
+  return _length;
+};
+
+interface_t SinricProMessage::getInterface() const {
+  return (interface_t) _interface;
+};
+
+bool SinricProMessage::isSignable() const {
+  return _payload != 0;
+};
+
+/**
+ * @brief Replaces the value of `payload.createdAt` in place
+ */
+bool SinricProMessage::setCreatedAt(unsigned long timestamp) {
+  if (!isSignable()) return false;
+  char digits[MESSAGE_TIMESTAMP_RESERVE + 1];
+  size_t newLength = snprintf(digits, sizeof(digits), "%lu", timestamp);
+  if (_length - _createdAtLength + newLength > (size_t) _capacity - MESSAGE_SIGNATURE_RESERVE) return false;
+
+  char* value = text() + _createdAt;
+  memmove(value + newLength, value + _createdAtLength, _length - _createdAt - _createdAtLength + 1);
+  memcpy(value, digits, newLength);
+  _length = _length - _createdAtLength + newLength;
+  _createdAtLength = newLength;
+  return true;
+};
+
+const char* SinricProMessage::getPayload() const {
+  return isSignable() ? getMessage() + _payload : nullptr;
+};
+
+size_t SinricProMessage::getPayloadLength() const {
+  return isSignable() ? _length - 1 - _payload : 0;
+};
+
+/**
+ * @brief Appends the signature object to the message
+ *
+ * After this the message is complete and can't be changed anymore.
+ */
+bool SinricProMessage::setSignature(const char* signature) {
+  if (!isSignable()) return false;
+  size_t length = _length - 1 + snprintf(nullptr, 0, ",\"signature\":{\"HMAC\":\"%s\"}}", signature);
+  if (length > _capacity) return false;
+  sprintf(text() + _length - 1, ",\"signature\":{\"HMAC\":\"%s\"}}", signature);
+  _length = length;
+  _payload = 0;
+  return true;
+};
+
+
+/**
+ * @brief Fixed size FIFO queue of messages
+ *
+ * Messages are stored one after another in a ring buffer of `SIZE` bytes which is part of the queue object,
+ * so queuing a message does not allocate memory. A message always occupies one contiguous block of the arena.
+ *
+ * @tparam SIZE size of the arena in bytes
+ */
+template <size_t SIZE>
+class SinricProQueue {
+public:
+  typedef std::function<void(void)> DrainCallback;
+
+  SinricProQueue();
+
+  bool push(interface_t interface, const char* message, size_t length);
+  bool push(interface_t interface, JsonDocument& jsonMessage, SinricProRemote remote = SinricProRemote());
+  bool pushUnsigned(interface_t interface, const char* message, size_t length, SinricProRemote remote = SinricProRemote());
+  template <typename Reader>
+  bool push(interface_t interface, size_t length, Reader read, SinricProRemote remote = SinricProRemote());
+  SinricProMessage* front();
+  void pop();
+
+  size_t size() const { return _count; }
+  bool empty() const { return _count == 0; }
+  size_t getDropped() const { return _dropped; }
+
+  void setOverflowPolicy(queue_overflow_t policy, DrainCallback drain = nullptr);
+private:
+  SinricProMessage* reserve(interface_t interface, size_t capacity, SinricProRemote remote = SinricProRemote());
+  SinricProMessage* allocate(size_t recordSize);
+  void unreserve(SinricProMessage* message);
+  SinricProMessage* at(size_t offset) { return reinterpret_cast<SinricProMessage*>(_arena + offset); }
+
+  alignas(4) uint8_t _arena[SIZE];
+  size_t _head;   // offset of the oldest message
+  size_t _tail;   // offset behind the newest message
+  size_t _count;
+  size_t _dropped;
+  queue_overflow_t _policy;
+  DrainCallback _drain;
+  bool _draining;
+};
+
+template <size_t SIZE>
+SinricProQueue<SIZE>::SinricProQueue() : _head(0), _tail(0), _count(0), _dropped(0), _policy(QUEUE_DROP_NEWEST), _drain(nullptr), _draining(false) {}
+
+/**
+ * @brief Set what happens if a message doesn't fit into the queue
+ *
+ * @param policy `QUEUE_DROP_NEWEST`, `QUEUE_DROP_OLDEST` or `QUEUE_BLOCK`
+ * @param drain  for `QUEUE_BLOCK`: function which consumes the queued messages
+ */
+template <size_t SIZE>
+void SinricProQueue<SIZE>::setOverflowPolicy(queue_overflow_t policy, DrainCallback drain) {
+  _policy = policy;
+  _drain = drain;
+}
+
+template <size_t SIZE>
+bool SinricProQueue<SIZE>::push(interface_t interface, const char* message, size_t length) {
+  SinricProMessage* newMessage = reserve(interface, length);
+  if (!newMessage) return false;
+  newMessage->fromString(message, length);
+  return true;
+}
+
+template <size_t SIZE>
+bool SinricProQueue<SIZE>::push(interface_t interface, JsonDocument& jsonMessage, SinricProRemote remote) {
+  SinricProMessage* newMessage = reserve(interface, measureJson(jsonMessage) + MESSAGE_TIMESTAMP_RESERVE + MESSAGE_SIGNATURE_RESERVE, remote);
+  if (!newMessage) return false;
+  newMessage->fromJson(jsonMessage);
+  return true;
+}
+
+/**
+ * @brief Queues an outgoing message which has been serialized without signature, to be signed in place like a message pushed as JsonDocument
+ */
+template <size_t SIZE>
+bool SinricProQueue<SIZE>::pushUnsigned(interface_t interface, const char* message, size_t length, SinricProRemote remote) {
+  SinricProMessage* newMessage = reserve(interface, length + MESSAGE_TIMESTAMP_RESERVE + MESSAGE_SIGNATURE_RESERVE, remote);
+  if (!newMessage) return false;
+  newMessage->fromUnsigned(message, length);
+  return true;
+}
+
+/**
+ * @brief Reserves room for a message of `length` bytes and lets `read` write the message straight into the queue
+ *
+ * @param read  `size_t read(char* buffer, size_t length)` writes up to `length` bytes to `buffer` and returns the number of bytes written,
+ *              the message is discarded if it returns 0
+ * @param remote sender of a message received by UDP
+ * @return false if the message didn't fit into the queue (`read` is not called then) or `read` returned 0
+ */
+template <size_t SIZE>
+template <typename Reader>
+bool SinricProQueue<SIZE>::push(interface_t interface, size_t length, Reader read, SinricProRemote remote) {
+  SinricProMessage* newMessage = reserve(interface, length, remote);
+  if (!newMessage) return false;
+  size_t n = read(newMessage->text(), length);
+  if (n == 0 || n > length) {
+    unreserve(newMessage);
+    return false;
+  }
+  newMessage->text()[n] = 0;
+  newMessage->_length = n;
+  return true;
+}
+
+template <size_t SIZE>
+SinricProMessage* SinricProQueue<SIZE>::front() {
+  if (_count == 0) return nullptr;
+  return at(_head);
+}
+
+template <size_t SIZE>
+void SinricProQueue<SIZE>::pop() {
+  if (_count == 0) return;
+  _head += at(_head)->_size;
+  if (--_count == 0) {
+    _head = _tail = 0;
+  } else if (SIZE - _head < sizeof(SinricProMessage) || at(_head)->_size == 0) {
+    _head = 0; // writer wrapped around here
+  }
+}
+
+template <size_t SIZE>
+SinricProMessage* SinricProQueue<SIZE>::reserve(interface_t interface, size_t capacity, SinricProRemote remote) {
+  size_t recordSize = (sizeof(SinricProMessage) + SinricProRemote::sizeFor(interface) + capacity + 1 + 3) & ~(size_t) 3;
+  SinricProMessage* message = nullptr;
+
+  if (recordSize <= SIZE && recordSize <= 0xFFFF) {
+    message = allocate(recordSize);
+    while (!message && _policy == QUEUE_DROP_OLDEST && _count) {
+      pop();
+      _dropped++;
+      message = allocate(recordSize);
+    }
+    if (!message && _policy == QUEUE_BLOCK && _drain && !_draining && _count) {
+      _draining = true;
+      _drain();
+      _draining = false;
+      message = allocate(recordSize);
+    }
+  }
+
+  if (!message) {
+    _dropped++;
+    return nullptr;
+  }
+  message->init(interface, capacity, remote);
+  return message;
+}
+
+template <size_t SIZE>
+SinricProMessage* SinricProQueue<SIZE>::allocate(size_t recordSize) {
+  if (_count && _head == _tail) return nullptr; // full
+  size_t offset;
+  if (_tail >= _head) {                 // used: [_head, _tail), free: [_tail, SIZE) and [0, _head)
+    if (SIZE - _tail >= recordSize) {
+      offset = _tail;
+    } else if (_head >= recordSize) {
+      if (SIZE - _tail >= sizeof(SinricProMessage)) at(_tail)->_size = 0;
+      offset = 0;
+    } else {
+      return nullptr;
+    }
+  } else {                              // used: [_head, SIZE) and [0, _tail), free: [_tail, _head)
+    if (_head - _tail < recordSize) return nullptr;
+    offset = _tail;
+  }
+  _tail = offset + recordSize;
+  _count++;
+  SinricProMessage* message = at(offset);
+  message->_size = recordSize;
+  return message;
+}
+
+// removes the newest message again, right after reserve()
+template <size_t SIZE>
+void SinricProQueue<SIZE>::unreserve(SinricProMessage* message) {
+  _tail = reinterpret_cast<uint8_t*>(message) - _arena; // a wrap around marker left behind is skipped by pop()
+  if (--_count == 0) _head = _tail = 0;
+}
+
+/**
+ * @brief Lanes of SinricProPriorityQueue, highest priority first
+ */
+typedef enum {
+  PRIORITY_RESPONSE  = 0,  // responses to requests
+  PRIORITY_EVENT     = 1,  // events caused by an interaction (doorbell, motion, contact, lock...)
+  PRIORITY_TELEMETRY = 2,  // events caused by PERIODIC_POLL (temperature, power, air quality...)
+  PRIORITY_COUNT     = 3
+} message_priority_t;
+
+/**
+ * @brief Queue of outgoing messages with a SinricProQueue per message_priority_t
+ *
+ * front() returns the oldest message of the highest priority lane holding messages. To keep a lane from starving,
+ * a lane that has waited while `starvationLimit` messages of other lanes have been popped is served next.
+ * A message returned by front() is the message removed by the following pop().
+ *
+ * @tparam RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE size of each lane's arena in bytes
+ */
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+class SinricProPriorityQueue {
+public:
+  typedef std::function<void(void)> DrainCallback;
+
+  SinricProPriorityQueue();
+
+  bool push(message_priority_t priority, interface_t interface, const char* message, size_t length);
+  bool push(message_priority_t priority, interface_t interface, JsonDocument& jsonMessage, SinricProRemote remote = SinricProRemote());
+  bool pushUnsigned(message_priority_t priority, interface_t interface, const char* message, size_t length, SinricProRemote remote = SinricProRemote());
+  SinricProMessage* front();
+  void pop();
+
+  size_t size() const { return _responses.size() + _events.size() + _telemetry.size(); }
+  size_t size(message_priority_t priority) const;
+  bool empty() const { return size() == 0; }
+  size_t getDropped() const { return _responses.getDropped() + _events.getDropped() + _telemetry.getDropped(); }
+
+  void setOverflowPolicy(queue_overflow_t policy, DrainCallback drain = nullptr);
+  void setStarvationLimit(uint8_t starvationLimit) { _starvationLimit = starvationLimit; }
+private:
+  int select();
+  SinricProMessage* front(int lane);
+
+  SinricProQueue<RESPONSE_SIZE>  _responses;
+  SinricProQueue<EVENT_SIZE>     _events;
+  SinricProQueue<TELEMETRY_SIZE> _telemetry;
+  uint8_t _waited[PRIORITY_COUNT];  // messages popped from other lanes while this lane held messages
+  uint8_t _starvationLimit;
+  int     _current;                 // lane selected by front(), -1 if none
+};
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::SinricProPriorityQueue() : _waited{0, 0, 0}, _starvationLimit(SINRICPRO_SEND_STARVATION_LIMIT), _current(-1) {}
+
+/**
+ * @brief Sets the policy of every lane, `drain` is called for the lane which is full
+ */
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+void SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::setOverflowPolicy(queue_overflow_t policy, DrainCallback drain) {
+  _responses.setOverflowPolicy(policy, drain);
+  _events.setOverflowPolicy(policy, drain);
+  _telemetry.setOverflowPolicy(policy, drain);
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+bool SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::push(message_priority_t priority, interface_t interface, const char* message, size_t length) {
+  switch (priority) {
+    case PRIORITY_RESPONSE: return _responses.push(interface, message, length);
+    case PRIORITY_EVENT:    return _events.push(interface, message, length);
+    default:                return _telemetry.push(interface, message, length);
+  }
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+bool SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::push(message_priority_t priority, interface_t interface, JsonDocument& jsonMessage, SinricProRemote remote) {
+  switch (priority) {
+    case PRIORITY_RESPONSE: return _responses.push(interface, jsonMessage, remote);
+    case PRIORITY_EVENT:    return _events.push(interface, jsonMessage, remote);
+    default:                return _telemetry.push(interface, jsonMessage, remote);
+  }
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+bool SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::pushUnsigned(message_priority_t priority, interface_t interface, const char* message, size_t length, SinricProRemote remote) {
+  switch (priority) {
+    case PRIORITY_RESPONSE: return _responses.pushUnsigned(interface, message, length, remote);
+    case PRIORITY_EVENT:    return _events.pushUnsigned(interface, message, length, remote);
+    default:                return _telemetry.pushUnsigned(interface, message, length, remote);
+  }
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+size_t SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::size(message_priority_t priority) const {
+  switch (priority) {
+    case PRIORITY_RESPONSE:  return _responses.size();
+    case PRIORITY_EVENT:     return _events.size();
+    case PRIORITY_TELEMETRY: return _telemetry.size();
+    default:                 return 0;
+  }
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+SinricProMessage* SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::front(int lane) {
+  switch (lane) {
+    case PRIORITY_RESPONSE:  return _responses.front();
+    case PRIORITY_EVENT:     return _events.front();
+    case PRIORITY_TELEMETRY: return _telemetry.front();
+    default:                 return nullptr;
+  }
+}
+
+// a starving lane first, otherwise the highest priority lane holding messages
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+int SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::select() {
+  int lane = -1;
+  for (int i = 0; i < PRIORITY_COUNT; i++) {
+    if (!size((message_priority_t) i)) continue;
+    if (_starvationLimit && _waited[i] >= _starvationLimit) return i;
+    if (lane < 0) lane = i;
+  }
+  return lane;
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+SinricProMessage* SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::front() {
+  if (_current < 0 || !size((message_priority_t) _current)) _current = select();
+  return front(_current);
+}
+
+template <size_t RESPONSE_SIZE, size_t EVENT_SIZE, size_t TELEMETRY_SIZE>
+void SinricProPriorityQueue<RESPONSE_SIZE, EVENT_SIZE, TELEMETRY_SIZE>::pop() {
+  if (_current < 0 || !size((message_priority_t) _current)) _current = select();
+  if (_current < 0) return;
+  switch (_current) {
+    case PRIORITY_RESPONSE:  _responses.pop(); break;
+    case PRIORITY_EVENT:     _events.pop(); break;
+    default:                 _telemetry.pop(); break;
+  }
+  for (int i = 0; i < PRIORITY_COUNT; i++) {
+    if (i == _current || !size((message_priority_t) i)) {
+      _waited[i] = 0;
+    } else if (_waited[i] < 0xFF) {
+      _waited[i]++;
+    }
+  }
+  _current = -1;
+}
+
+static_assert(SINRICPRO_RECEIVE_QUEUE_SIZE >= UDP_PACKETS_PER_HANDLE * SINRICPRO_QUEUE_RECORD_SIZE, "the receive queue must hold the UDP_PACKETS_PER_HANDLE packets read per handle()");
+static_assert(SINRICPRO_SEND_QUEUE_RESPONSE_SIZE >= SINRICPRO_QUEUE_RECORD_SIZE && SINRICPRO_SEND_QUEUE_EVENT_SIZE >= SINRICPRO_QUEUE_RECORD_SIZE && SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE >= SINRICPRO_QUEUE_RECORD_SIZE,
+              "every send queue lane must hold a message of SINRICPRO_QUEUE_RECORD_SIZE");
 
-typedef std::queue<SinricProMessage*> SinricProQueue_t;
+typedef SinricProQueue<SINRICPRO_RECEIVE_QUEUE_SIZE> SinricProReceiveQueue_t;
+typedef SinricProPriorityQueue<SINRICPRO_SEND_QUEUE_RESPONSE_SIZE, SINRICPRO_SEND_QUEUE_EVENT_SIZE, SINRICPRO_SEND_QUEUE_TELEMETRY_SIZE> SinricProSendQueue_t;
 
 #endif
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_RATELIMITER_H_
+#define _SINRICPRO_RATELIMITER_H_
+
+#include <vector>
+#include "SinricProConfig.h"
+#include "SinricProDebug.h"
+
+/**
+ * @class SinricProTokenBucket
+ * @brief Allows a burst of events, then one more event each time the refill interval has passed
+ *
+ * All times are `millis()` values. Only differences of them are used, so the bucket keeps working when `millis()` rolls over.
+ **/
+class SinricProTokenBucket {
+public:
+  SinricProTokenBucket(uint16_t burst = 0, unsigned long refillInterval = 0, unsigned long minInterval = 0);
+  unsigned long timeUntilAvailable(unsigned long now);
+  void take(unsigned long now);
+  bool isEmpty() const { return _burst && _tokens == 0; }
+private:
+  void refill(unsigned long now);
+
+  uint16_t _burst;                // 0: no limit
+  uint16_t _tokens;
+  bool _hasTaken;
+  unsigned long _refillInterval;
+  unsigned long _minInterval;     // minimum time between two events
+  unsigned long _lastRefill;
+  unsigned long _lastTake;
+};
+
+SinricProTokenBucket::SinricProTokenBucket(uint16_t burst, unsigned long refillInterval, unsigned long minInterval) :
+  _burst(burst),
+  _tokens(burst),
+  _hasTaken(false),
+  _refillInterval(refillInterval ? refillInterval : 1),
+  _minInterval(minInterval),
+  _lastRefill(0),
+  _lastTake(0) {
+}
+
+void SinricProTokenBucket::refill(unsigned long now) {
+  if (_tokens < _burst) {
+    unsigned long tokens = (now - _lastRefill) / _refillInterval;
+    if (tokens >= (unsigned long) (_burst - _tokens)) {
+      _tokens = _burst;
+    } else if (tokens) {
+      _tokens += tokens;
+      _lastRefill += tokens * _refillInterval;
+    }
+  }
+  if (_tokens == _burst) _lastRefill = now; // refilling starts when the first token is taken from a full bucket
+}
+
+/**
+ * @brief Time in milliseconds until take() is allowed, 0 if it is allowed now
+ */
+unsigned long SinricProTokenBucket::timeUntilAvailable(unsigned long now) {
+  if (!_burst) return 0;
+  refill(now);
+  unsigned long wait = 0;
+  if (_tokens == 0) wait = _refillInterval - (now - _lastRefill);
+  if (_hasTaken && now - _lastTake < _minInterval) {
+    unsigned long intervalWait = _minInterval - (now - _lastTake);
+    if (intervalWait > wait) wait = intervalWait;
+  }
+  return wait;
+}
+
+void SinricProTokenBucket::take(unsigned long now) {
+  if (!_burst || !_tokens) return;
+  _tokens--;
+  _lastTake = now;
+  _hasTaken = true;
+}
+
+/**
+ * @class SinricProEventLimiter
+ * @brief Rate limits the events of one device
+ *
+ * An event is allowed if the bucket of its action, the bucket of the device and the bucket shared by all devices allow it.
+ * The buckets of the first EVENT_LIMIT_ACTIONS_PER_DEVICE actions are kept in a fixed array, so limiting events does not allocate memory.
+ * A device sending more actions gets the buckets of the further actions allocated, so every action keeps its own bucket.
+ **/
+class SinricProEventLimiter {
+public:
+  SinricProEventLimiter();
+  unsigned long timeUntilNextEvent(uint8_t actionId, unsigned long now);
+  bool tryTake(uint8_t actionId, unsigned long now, bool warn = true);
+  bool allows(uint8_t actionId, unsigned long now, bool warn = true);
+  void take(uint8_t actionId, unsigned long now);
+
+  static uint8_t actionId(const char *action);
+  static const char *actionName(uint8_t actionId);
+private:
+  struct ActionLimit {
+    uint8_t actionId;
+    bool warned;
+    SinricProTokenBucket bucket;
+  };
+  ActionLimit &actionLimit(uint8_t actionId);
+  ActionLimit *findActionLimit(uint8_t actionId);
+  static SinricProTokenBucket &globalBucket();
+  static std::vector<const char *> &actionNames();
+
+  ActionLimit actionLimits[EVENT_LIMIT_ACTIONS_PER_DEVICE];
+  uint8_t actionCount;
+  std::vector<ActionLimit> moreActionLimits; // actions beyond EVENT_LIMIT_ACTIONS_PER_DEVICE
+  SinricProTokenBucket deviceBucket;
+};
+
+SinricProEventLimiter::SinricProEventLimiter() : actionCount(0), deviceBucket(EVENT_LIMIT_DEVICE_BURST, EVENT_LIMIT_DEVICE_REFILL) {}
+
+/**
+ * @brief Returns a small id for an action name, the same name always gets the same id
+ *
+ * Names are shared by all devices, so each action name is copied only once.
+ */
+uint8_t SinricProEventLimiter::actionId(const char *action) {
+  std::vector<const char *> &actions = actionNames();
+  for (size_t id = 0; id < actions.size(); id++) {
+    if (strcmp(actions[id], action) == 0) return id;
+  }
+  if (actions.size() == 0xFF) return 0xFF; // any further action shares the last id
+  actions.push_back(strdup(action));
+  return actions.size() - 1;
+}
+
+const char *SinricProEventLimiter::actionName(uint8_t actionId) {
+  std::vector<const char *> &actions = actionNames();
+  return actionId < actions.size() ? actions[actionId] : "";
+}
+
+std::vector<const char *> &SinricProEventLimiter::actionNames() {
+  static std::vector<const char *> actions;
+  return actions;
+}
+
+SinricProTokenBucket &SinricProEventLimiter::globalBucket() {
+  static SinricProTokenBucket bucket(EVENT_LIMIT_GLOBAL_BURST, EVENT_LIMIT_GLOBAL_REFILL);
+  return bucket;
+}
+
+/**
+ * @brief The bucket of an action, `nullptr` if the device has not sent this action yet
+ */
+SinricProEventLimiter::ActionLimit *SinricProEventLimiter::findActionLimit(uint8_t actionId) {
+  for (uint8_t i = 0; i < actionCount; i++) {
+    if (actionLimits[i].actionId == actionId) return &actionLimits[i];
+  }
+  for (auto &limit : moreActionLimits) {
+    if (limit.actionId == actionId) return &limit;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief The bucket of an action, a full bucket is added the first time the device sends this action
+ */
+SinricProEventLimiter::ActionLimit &SinricProEventLimiter::actionLimit(uint8_t actionId) {
+  ActionLimit *found = findActionLimit(actionId);
+  if (found) return *found;
+  ActionLimit newLimit { actionId, false, SinricProTokenBucket(BUCKET_SIZE, DROP_OUT_TIME, DROP_IN_TIME) };
+  if (actionCount < EVENT_LIMIT_ACTIONS_PER_DEVICE) return actionLimits[actionCount++] = newLimit;
+  DEBUG_SINRIC("[SinricProEventLimiter]: more than %d actions, allocating the bucket of \"%s\"\r\n", EVENT_LIMIT_ACTIONS_PER_DEVICE, actionName(actionId));
+  moreActionLimits.push_back(newLimit);
+  return moreActionLimits.back();
+}
+
+/**
+ * @brief Time in milliseconds until an event for this action is allowed, 0 if it is allowed now
+ *
+ * Only asks the buckets, an action the device has not sent yet does not get a bucket by this.
+ */
+unsigned long SinricProEventLimiter::timeUntilNextEvent(uint8_t actionId, unsigned long now) {
+  ActionLimit *limit = findActionLimit(actionId);
+  unsigned long wait = limit ? limit->bucket.timeUntilAvailable(now) : 0; // a new bucket is full
+  unsigned long deviceWait = deviceBucket.timeUntilAvailable(now);
+  unsigned long globalWait = globalBucket().timeUntilAvailable(now);
+  if (deviceWait > wait) wait = deviceWait;
+  if (globalWait > wait) wait = globalWait;
+  return wait;
+}
+
+/**
+ * @brief Counts an event if all limits allow it
+ * @param warn print a warning the first time the action is blocked because too many events were sent
+ * @return `true` if the event may be sent
+ */
+bool SinricProEventLimiter::tryTake(uint8_t actionId, unsigned long now, bool warn) {
+  if (!allows(actionId, now, warn)) return false;
+  take(actionId, now);
+  return true;
+}
+
+/**
+ * @brief Tells if all limits allow an event now without counting it, take() counts it once it has been sent
+ * @param warn print a warning the first time the action is blocked because too many events were sent
+ */
+bool SinricProEventLimiter::allows(uint8_t actionId, unsigned long now, bool warn) {
+  ActionLimit &limit = actionLimit(actionId);
+  if (limit.bucket.timeUntilAvailable(now) || deviceBucket.timeUntilAvailable(now) || globalBucket().timeUntilAvailable(now)) {
+    if (warn && !limit.warned && limit.bucket.isEmpty()) {
+      Serial.printf("[SinricPro]: WARNING: YOU SENT TOO MUCH EVENTS IN A SHORT PERIOD OF TIME!\r\n - PLEASE CHECK YOUR CODE AND SEND EVENTS ONLY IF DEVICE STATE HAS CHANGED!\r\n");
+      Serial.printf("[SinricPro]: EVENTS ARE BLOCKED FOR %lu SECONDS!\r\n", limit.bucket.timeUntilAvailable(now) / 1000);
+      limit.warned = true;
+    }
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Counts an event sent after allows() returned `true`
+ */
+void SinricProEventLimiter::take(uint8_t actionId, unsigned long now) {
+  ActionLimit &limit = actionLimit(actionId);
+  limit.bucket.take(now);
+  limit.warned = false;
+  deviceBucket.take(now);
+  globalBucket().take(now);
+}
+
+#endif
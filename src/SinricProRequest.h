@@ -3,14 +3,96 @@
 
 #include <WString.h>
 #include <ArduinoJson.h>
+#include "SinricProStrings.h"
+
+#include <type_traits>
+
+/**
+ * @brief Read only view of a string in the request message
+ *
+ * Has the read only API of a String and compares to `const char*` and `String` like a String, but does not copy the string.
+ * It converts to a String where a String is needed, e.g. to call a callback or to concatenate it.
+ **/
+class SinricProStringRef {
+public:
+  SinricProStringRef(const char *str) : _str(str ? str : "") {}
+  const char *c_str() const { return _str; }
+  size_t length() const { return strlen(_str); }
+  bool isEmpty() const { return _str[0] == 0; }
+  operator String() const { return String(_str); }
+
+  char charAt(unsigned int index) const { return index < length() ? _str[index] : 0; }
+  char operator[](unsigned int index) const { return charAt(index); }
+
+  int compareTo(const char *other) const { return strcmp(_str, other); }
+  int compareTo(const String &other) const { return strcmp(_str, other.c_str()); }
+  bool equals(const char *other) const { return compareTo(other) == 0; }
+  bool equals(const String &other) const { return compareTo(other) == 0; }
+  bool equalsIgnoreCase(const char *other) const { return strcasecmp(_str, other) == 0; }
+  bool equalsIgnoreCase(const String &other) const { return equalsIgnoreCase(other.c_str()); }
+  bool startsWith(const char *prefix) const { return strncmp(_str, prefix, strlen(prefix)) == 0; }
+  bool startsWith(const String &prefix) const { return startsWith(prefix.c_str()); }
+  bool endsWith(const char *suffix) const;
+  bool endsWith(const String &suffix) const { return endsWith(suffix.c_str()); }
+
+  int indexOf(char ch, unsigned int fromIndex = 0) const;
+  int indexOf(const char *str, unsigned int fromIndex = 0) const;
+  int indexOf(const String &str, unsigned int fromIndex = 0) const { return indexOf(str.c_str(), fromIndex); }
+  int lastIndexOf(char ch) const;
+  String substring(unsigned int beginIndex) const { return String(*this).substring(beginIndex); }
+  String substring(unsigned int beginIndex, unsigned int endIndex) const { return String(*this).substring(beginIndex, endIndex); }
+  long toInt() const { return atol(_str); }
+  float toFloat() const { return (float) atof(_str); }
+
+  bool operator==(const char *other) const { return equals(other); }
+  bool operator!=(const char *other) const { return !equals(other); }
+  bool operator==(const String &other) const { return equals(other); }
+  bool operator!=(const String &other) const { return !equals(other); }
+  bool operator<(const String &other) const { return compareTo(other) < 0; }
+  bool operator>(const String &other) const { return compareTo(other) > 0; }
+private:
+  const char *_str;
+};
+
+bool SinricProStringRef::endsWith(const char *suffix) const {
+  size_t len = length(), suffixLen = strlen(suffix);
+  return suffixLen <= len && strcmp(_str + len - suffixLen, suffix) == 0;
+}
+
+int SinricProStringRef::indexOf(char ch, unsigned int fromIndex) const {
+  if (fromIndex >= length()) return -1;
+  const char *found = strchr(_str + fromIndex, ch);
+  return found ? found - _str : -1;
+}
+
+int SinricProStringRef::indexOf(const char *str, unsigned int fromIndex) const {
+  if (fromIndex >= length()) return -1;
+  const char *found = strstr(_str + fromIndex, str);
+  return found ? found - _str : -1;
+}
+
+int SinricProStringRef::lastIndexOf(char ch) const {
+  const char *found = strrchr(_str, ch);
+  return found ? found - _str : -1;
+}
+
+// templates, so a `const char*` does not convert to SinricProStringRef and make `String + const char*` ambiguous
+template <typename T, typename = typename std::enable_if<std::is_same<T, SinricProStringRef>::value>::type>
+String operator+(const String &lhs, const T &rhs) { String result(lhs); result += rhs.c_str(); return result; }
+template <typename T, typename = typename std::enable_if<std::is_same<T, SinricProStringRef>::value>::type>
+String operator+(const char *lhs, const T &rhs) { String result(lhs); result += rhs.c_str(); return result; }
+template <typename T, typename = typename std::enable_if<std::is_same<T, SinricProStringRef>::value>::type>
+String operator+(const T &lhs, const char *rhs) { String result(lhs); result += rhs; return result; }
+template <typename T, typename = typename std::enable_if<std::is_same<T, SinricProStringRef>::value>::type>
+String operator+(const T &lhs, const String &rhs) { String result(lhs); result += rhs; return result; }
 
 struct SinricProRequest {
-  const String &action;
-  const String &instance;
+  const SinricProStringRef action;
+  const SinricProStringRef instance;
   JsonObject &request_value;
   JsonObject &response_value;
 };
 
 using SinricProRequestHandler = std::function<bool(SinricProRequest&)>;
 
-#endif
\ No newline at end of file
+#endif
@@ -11,32 +11,103 @@
 #include "extralib/Crypto/Crypto.h"
 #include "extralib/Crypto/Base64.h"
 
-String calculateSignature(const char* key, JsonDocument &jsonMessage) {
-  if (!jsonMessage.containsKey("payload")) return String("");
-  String jsonPayload; serializeJson(jsonMessage["payload"], jsonPayload);
+#include "SinricProQueue.h"
+
+#define SIGNATURE_LENGTH 44 // length of base64 encoded SHA256HMAC
 
+/**
+ * @brief Calculates the signature of a payload
+ * 
+ * @param keyedHmac SHA256HMAC keyed with the app secret, it is copied so the key must not be hashed again
+ * @param signature buffer for SIGNATURE_LENGTH+1 characters
+ */
+void calculateSignature(const SHA256HMAC& keyedHmac, const char* payload, size_t length, char* signature) {
   byte rawSigBuf[SHA256HMAC_SIZE];
-  String test;
-  
 
-  SHA256HMAC hmac((byte*) key, strlen(key));
-  hmac.doUpdate(jsonPayload.c_str(), jsonPayload.length());
+  SHA256HMAC hmac(keyedHmac);
+  hmac.doUpdate(payload, length);
   hmac.doFinal(rawSigBuf);
-  
 
-  int b64_len = base64_enc_len(SHA256HMAC_SIZE);
-  char sigBuf[b64_len+1];
-  base64_encode(sigBuf, (char*) rawSigBuf, SHA256HMAC_SIZE);
-  sigBuf[b64_len] = 0;
+  base64_encode(signature, (char*) rawSigBuf, SHA256HMAC_SIZE);
+  signature[SIGNATURE_LENGTH] = 0;
+}
+
+void calculateSignature(const char* key, const char* payload, size_t length, char* signature) {
+  calculateSignature(SHA256HMAC((byte*) key, strlen(key)), payload, length, signature);
+}
+
+/**
+ * @brief Print adapter feeding everything printed to it into a SHA256HMAC
+ * 
+ * Lets serializeJson() write straight into the HMAC in small chunks,
+ * so the payload must not be copied into a String before signing.
+ */
+class HMACPrint : public Print {
+  public:
+    HMACPrint(SHA256HMAC &hmac) : _hmac(hmac), _length(0) {}
+    ~HMACPrint() { finish(); }
+
+    size_t write(uint8_t c) override {
+      _buffer[_length++] = c;
+      if (_length == sizeof(_buffer)) finish();
+      return 1;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override {
+      if (_length + size <= sizeof(_buffer)) {
+        memcpy(_buffer + _length, buffer, size);
+        _length += size;
+        if (_length == sizeof(_buffer)) finish();
+        return size;
+      }
+      finish();
+      _hmac.doUpdate(buffer, size);
+      return size;
+    }
+
+    // hands buffered bytes to the HMAC, must be called before SHA256HMAC::doFinal()
+    void finish() {
+      if (_length) _hmac.doUpdate(_buffer, _length);
+      _length = 0;
+    }
+  private:
+    SHA256HMAC &_hmac;
+    byte _buffer[32];
+    size_t _length;
+};
+
+bool calculateSignature(const SHA256HMAC& keyedHmac, JsonDocument &jsonMessage, char* signature) {
+  if (!jsonMessage.containsKey("payload")) return false;
+  byte rawSigBuf[SHA256HMAC_SIZE];
+
+  SHA256HMAC hmac(keyedHmac);
+  HMACPrint hmacPrint(hmac);
+  serializeJson(jsonMessage["payload"], hmacPrint);
+  hmacPrint.finish();
+  hmac.doFinal(rawSigBuf);
+
+  base64_encode(signature, (char*) rawSigBuf, SHA256HMAC_SIZE);
+  signature[SIGNATURE_LENGTH] = 0;
+  return true;
+}
+
+String calculateSignature(const char* key, JsonDocument &jsonMessage) {
+  char sigBuf[SIGNATURE_LENGTH+1];
+  if (!calculateSignature(SHA256HMAC((byte*) key, strlen(key)), jsonMessage, sigBuf)) return String("");
   String result = sigBuf;
 
   return result;
 }
 
+bool verifyMessage(const SHA256HMAC& keyedHmac, JsonDocument &jsonMessage) {
+  const char* jsonHash = jsonMessage["signature"]["HMAC"];
+  char calculatedHash[SIGNATURE_LENGTH+1];
+  if (!jsonHash || !calculateSignature(keyedHmac, jsonMessage, calculatedHash)) return false;
+  return strcmp(jsonHash, calculatedHash) == 0;
+}
+
 bool verifyMessage(String key, JsonDocument &jsonMessage) {
-  String jsonHash = jsonMessage["signature"]["HMAC"];
-  String calculatedHash = calculateSignature(key.c_str(), jsonMessage);
-  return jsonHash == calculatedHash;
+  return verifyMessage(SHA256HMAC((byte*) key.c_str(), key.length()), jsonMessage);
 }
 
 String signMessage(String key, JsonDocument &jsonMessage) {
@@ -47,4 +118,11 @@ String signMessage(String key, JsonDocument &jsonMessage) {
   return signedMessageString;
 }
 
+bool signMessage(const SHA256HMAC& keyedHmac, SinricProMessage &message) {
+  if (!message.isSignable()) return false;
+  char sigBuf[SIGNATURE_LENGTH+1];
+  calculateSignature(keyedHmac, message.getPayload(), message.getPayloadLength(), sigBuf);
+  return message.setSignature(sigBuf);
+}
+
 #endif // _SIGNATURE_H_
\ No newline at end of file
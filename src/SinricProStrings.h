@@ -0,0 +1,26 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_STRINGS_H_
+#define _SINRICPRO_STRINGS_H_
+
+/**
+ * @brief Declares a string constant `FSTR_<x>_<y>` holding `"<y>"`
+ *
+ * Action and cause names are declared once with FSTR and used as `const char*` everywhere,
+ * from the action tables and request handlers to prepareEvent(), so no String has to be built for them.
+ * @code
+ * FSTR(POWERSTATE, setPowerState); // const char FSTR_POWERSTATE_setPowerState[] = "setPowerState"
+ * @endcode
+ **/
+#define FSTR(x, y) static const char FSTR_ ##x ##_ ##y[] = #y
+
+// causes
+FSTR(SINRICPRO, PHYSICAL_INTERACTION);
+FSTR(SINRICPRO, PERIODIC_POLL);
+
+#endif
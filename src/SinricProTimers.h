@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2019 Sinric. All rights reserved.
+ *  Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ *  This file is part of the Sinric Pro (https://github.com/sinricpro/)
+ */
+
+#ifndef _SINRICPRO_TIMERS_H_
+#define _SINRICPRO_TIMERS_H_
+
+#include <limits.h>
+
+#define SINRICPRO_NO_DEADLINE ULONG_MAX
+
+/**
+ * @brief The deadlines SinricPro.handle() has to meet, see SinricProClass::nextWakeupMs()
+ */
+typedef enum {
+  TIMER_NETWORK,    // next poll of the websocket and UDP for received messages
+  TIMER_HEARTBEAT,  // next ping the websocket library sends while connected
+  TIMER_RECONNECT,  // next connection attempt of the websocket library while disconnected
+  TIMER_EVENTS,     // earliest moment the rate limits allow a pending coalesced event
+  TIMER_COUNT
+} sinricpro_timer_t;
+
+/**
+ * @class SinricProTimers
+ * @brief One deadline per sinricpro_timer_t, the next of them tells how long handle() may sleep
+ *
+ * All times are `millis()` values. Only differences of them are used, so the timers keep working when `millis()` rolls over.
+ **/
+class SinricProTimers {
+public:
+  SinricProTimers();
+  void start(sinricpro_timer_t timer, unsigned long now, unsigned long delay);
+  void stop(sinricpro_timer_t timer) { _timers[timer].running = false; }
+  bool isRunning(sinricpro_timer_t timer) const { return _timers[timer].running; }
+  bool isDue(sinricpro_timer_t timer, unsigned long now) const { return isRunning(timer) && timeUntil(timer, now) == 0; }
+  unsigned long timeUntil(sinricpro_timer_t timer, unsigned long now) const;
+  unsigned long timeUntilNext(unsigned long now) const;
+private:
+  struct Timer {
+    bool running;
+    unsigned long started;
+    unsigned long delay;
+  };
+  Timer _timers[TIMER_COUNT];
+};
+
+SinricProTimers::SinricProTimers() {
+  for (auto& timer : _timers) timer = Timer { false, 0, 0 };
+}
+
+void SinricProTimers::start(sinricpro_timer_t timer, unsigned long now, unsigned long delay) {
+  _timers[timer] = Timer { true, now, delay };
+}
+
+/**
+ * @brief Time in milliseconds until the timer is due, 0 if it is due, SINRICPRO_NO_DEADLINE if it is stopped
+ */
+unsigned long SinricProTimers::timeUntil(sinricpro_timer_t timer, unsigned long now) const {
+  const Timer& t = _timers[timer];
+  if (!t.running) return SINRICPRO_NO_DEADLINE;
+  unsigned long elapsed = now - t.started;
+  return elapsed >= t.delay ? 0 : t.delay - elapsed;
+}
+
+/**
+ * @brief Time in milliseconds until the next running timer is due, SINRICPRO_NO_DEADLINE if all are stopped
+ */
+unsigned long SinricProTimers::timeUntilNext(unsigned long now) const {
+  unsigned long next = SINRICPRO_NO_DEADLINE;
+  for (int timer = 0; timer < TIMER_COUNT; timer++) {
+    unsigned long wait = timeUntil((sinricpro_timer_t) timer, now);
+    if (wait < next) next = wait;
+  }
+  return next;
+}
+
+#endif
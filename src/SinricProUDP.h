@@ -17,66 +17,60 @@
 
 #include <WiFiUdp.h>
 #include "SinricProQueue.h"
+#include "SinricProCapture.h"
 
 class udpListener {
 public:
-  void begin(SinricProQueue_t* receiveQueue);
+  void begin(SinricProReceiveQueue_t* receiveQueue);
   void handle();
-  void sendMessage(String &message);
+  void sendMessage(const char* message, size_t length, SinricProRemote remote);
   void stop();
 private:
-  WiFiUDP _udp;
-  SinricProQueue_t* receiveQueue;
+  WiFiUDP _udp;       // member of the multicast group, receives only
+  WiFiUDP _sender;    // sends the replies, so the multicast membership of _udp is never reset
+  SinricProReceiveQueue_t* receiveQueue;
 };
 
-void udpListener::begin(SinricProQueue_t* receiveQueue) {
+void udpListener::begin(SinricProReceiveQueue_t* receiveQueue) {
   this->receiveQueue = receiveQueue;
   #if defined ESP8266
     _udp.beginMulticast(WiFi.localIP(), UDP_MULTICAST_IP, UDP_MULTICAST_PORT);
-  #endif  
-  #if defined ESP32
+  #else
     _udp.beginMulticast(UDP_MULTICAST_IP, UDP_MULTICAST_PORT);
   #endif  
 }
 
+/**
+ * @brief Reads up to UDP_PACKETS_PER_HANDLE pending packets straight into the receive queue
+ */
 void udpListener::handle() {
-  if (!_udp.available()) return;
-  int len = _udp.parsePacket();
-  if (len) {
-    
-    char buffer[1024];
-    int n = _udp.read(buffer, 1024);
-    buffer[n] = 0;
-    SinricProMessage* request = new SinricProMessage(IF_UDP, buffer);
+  for (int packets = 0; packets < UDP_PACKETS_PER_HANDLE; packets++) {
+    int length = _udp.parsePacket();
+    if (length <= 0) return;
+    SinricProRemote remote { (uint32_t) _udp.remoteIP(), _udp.remotePort() };
     DEBUG_SINRIC("[SinricPro:UDP]: receiving request\r\n");
-    receiveQueue->push(request);
+    bool queued = receiveQueue->push(IF_UDP, length, [this](char* buffer, size_t length) {
+      int n = _udp.read(buffer, length);
+      if (n <= 0) return (size_t) 0;
+      SINRICPRO_CAPTURE_FRAME(IF_UDP, buffer, n);
+      return (size_t) n;
+    }, remote);
+    if (!queued) DEBUG_SINRIC("[SinricPro:UDP]: receiveQueue is full, request has been dropped\r\n");
   }
 }
 
-void udpListener::sendMessage(String &message) {
-  _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
-  _udp.print(message);
-  _udp.endPacket();
-  // restart UDP??
-  #if defined ESP8266
-    _udp.beginMulticast(WiFi.localIP(), UDP_MULTICAST_IP, UDP_MULTICAST_PORT);
-  #endif  
-  #if defined ESP32
-    _udp.beginMulticast(UDP_MULTICAST_IP, UDP_MULTICAST_PORT);
-  #endif  
-}
-
-/*
-void udpListener::sendMessage(String &message) {
-  WiFiUDP UDPsender;
-  UDPsender.beginPacket(_udp.remoteIP(), _udp.remotePort());
-  UDPsender.print(message);
-  UDPsender.endPacket();
+/**
+ * @brief Replies to the sender of the request, stored with the request in the receive queue
+ */
+void udpListener::sendMessage(const char* message, size_t length, SinricProRemote remote) {
+  _sender.beginPacket(IPAddress(remote.ip), remote.port);
+  _sender.write((const uint8_t*) message, length);
+  _sender.endPacket();
 }
-*/ 
 
 void udpListener::stop() {
   _udp.stop();
+  _sender.stop();
 }
 
 #endif
@@ -24,6 +24,7 @@
 #include "SinricProConfig.h"
 #include "SinricProQueue.h"
 #include "SinricProInterface.h"
+#include "SinricProCapture.h"
 
 
 #if !defined(WEBSOCKETS_VERSION_INT) || (WEBSOCKETS_VERSION_INT < 2003003)
@@ -53,13 +54,13 @@ class websocketListener
     websocketListener();
     ~websocketListener();
 
-    void begin(String server, String socketAuthToken, String deviceIds, SinricProQueue_t* receiveQueue);
+    void begin(String server, String socketAuthToken, String deviceIds, SinricProReceiveQueue_t* receiveQueue);
     void handle();
     void stop();
     bool isConnected() { return _isConnected; }
     void setRestoreDeviceStates(bool flag) { this->restoreDeviceStates = flag; };
 
-    void sendMessage(String &message);
+    void sendMessage(const char* message, size_t length);
 
     void onConnected(wsConnectedCallback callback) { _wsConnectedCb = callback; }
     void onDisconnected(wsDisconnectedCallback callback) { _wsDisconnectedCb = callback; }
@@ -78,7 +79,7 @@ class websocketListener
 
     void webSocketEvent(WStype_t type, uint8_t * payload, size_t length);
     void setExtraHeaders();
-    SinricProQueue_t* receiveQueue;
+    SinricProReceiveQueue_t* receiveQueue;
     String deviceIds;
     String socketAuthToken;
 };
@@ -106,7 +107,7 @@ websocketListener::~websocketListener() {
   stop();
 }
 
-void websocketListener::begin(String server, String socketAuthToken, String deviceIds, SinricProQueue_t* receiveQueue) {
+void websocketListener::begin(String server, String socketAuthToken, String deviceIds, SinricProReceiveQueue_t* receiveQueue) {
   if (_begin) return;
   _begin = true;
 
@@ -126,6 +127,7 @@ void websocketListener::begin(String server, String socketAuthToken, String devi
   setExtraHeaders();
   webSocket.onEvent([&](WStype_t type, uint8_t * payload, size_t length) { webSocketEvent(type, payload, length); });
   webSocket.enableHeartbeat(WEBSOCKET_PING_INTERVAL, WEBSOCKET_PING_TIMEOUT, WEBSOCKET_RETRY_COUNT);
+  webSocket.setReconnectInterval(WEBSOCKET_RECONNECT_INTERVAL);
 #ifdef WEBSOCKET_SSL
   webSocket.beginSSL(server.c_str(), SINRICPRO_SERVER_SSL_PORT, "/");
 #else
@@ -144,8 +146,8 @@ void websocketListener::stop() {
   _begin = false;
 }
 
-void websocketListener::sendMessage(String &message) {
-  webSocket.sendTXT(message);
+void websocketListener::sendMessage(const char* message, size_t length) {
+  webSocket.sendTXT(message, length);
 }
  
 
@@ -170,9 +172,9 @@ void websocketListener::webSocketEvent(WStype_t type, uint8_t * payload, size_t
       }
       break;
     case WStype_TEXT: {
-      SinricProMessage* request = new SinricProMessage(IF_WEBSOCKET, (char*)payload);
       DEBUG_SINRIC("[SinricPro:Websocket]: receiving data\r\n");
-      receiveQueue->push(request);
+      SINRICPRO_CAPTURE_FRAME(IF_WEBSOCKET, payload, length);
+      if (!receiveQueue->push(IF_WEBSOCKET, (const char*) payload, length)) DEBUG_SINRIC("[SinricPro:Websocket]: receiveQueue is full, message has been dropped\r\n");
       break;
     }
     default: break;
@@ -102,6 +102,60 @@ static const byte sha256_padding[64] =
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+#if defined CRYPTO_SHA256_MBEDTLS
+
+#include "mbedtls/version.h"
+
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+#define mbedtls_sha256_starts_ret mbedtls_sha256_starts
+#define mbedtls_sha256_update_ret mbedtls_sha256_update
+#define mbedtls_sha256_finish_ret mbedtls_sha256_finish
+#endif
+
+/**
+ * Initialize the SHA256 hash, mbedtls uses the ESP32 SHA accelerator when it is free
+ */
+SHA256::SHA256()
+{
+    mbedtls_sha256_init(&_context);
+    mbedtls_sha256_starts_ret(&_context, 0);
+}
+
+SHA256::SHA256(const SHA256 &other)
+{
+    mbedtls_sha256_init(&_context);
+    mbedtls_sha256_clone(&_context, &other._context);
+}
+
+SHA256 &SHA256::operator=(const SHA256 &other)
+{
+    if (this != &other)
+    {
+        // free first, a context owning the hardware releases it here
+        mbedtls_sha256_free(&_context);
+        mbedtls_sha256_init(&_context);
+        mbedtls_sha256_clone(&_context, &other._context);
+    }
+    return *this;
+}
+
+SHA256::~SHA256()
+{
+    mbedtls_sha256_free(&_context);
+}
+
+void SHA256::doUpdate(const byte * msg, unsigned int len)
+{
+    mbedtls_sha256_update_ret(&_context, msg, len);
+}
+
+void SHA256::doFinal(byte *digest)
+{
+    mbedtls_sha256_finish_ret(&_context, digest);
+}
+
+#else
+
 /**
  * Initialize the SHA256 hash
  */
@@ -119,27 +173,32 @@ SHA256::SHA256()
     state[7] = 0x5BE0CD19;
 }
 
+/**
+ * Compress one 64 byte block. The message schedule is kept in a 16 word
+ * window, word aligned input is loaded a word at a time.
+ */
 void SHA256::SHA256_Process(const byte digest[64])
 {
-    uint32_t temp1, temp2, W[64];
+    uint32_t temp1, temp2, W[16];
     uint32_t A, B, C, D, E, F, G, H;
 
-    GET_UINT32(W[0],  digest,  0);
-    GET_UINT32(W[1],  digest,  4);
-    GET_UINT32(W[2],  digest,  8);
-    GET_UINT32(W[3],  digest, 12);
-    GET_UINT32(W[4],  digest, 16);
-    GET_UINT32(W[5],  digest, 20);
-    GET_UINT32(W[6],  digest, 24);
-    GET_UINT32(W[7],  digest, 28);
-    GET_UINT32(W[8],  digest, 32);
-    GET_UINT32(W[9],  digest, 36);
-    GET_UINT32(W[10], digest, 40);
-    GET_UINT32(W[11], digest, 44);
-    GET_UINT32(W[12], digest, 48);
-    GET_UINT32(W[13], digest, 52);
-    GET_UINT32(W[14], digest, 56);
-    GET_UINT32(W[15], digest, 60);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (((uintptr_t) digest & 3) == 0)
+    {
+        const uint32_t *words = (const uint32_t *) digest;
+        for (int i = 0; i < 16; i++)
+            W[i] = crypto_ntohl(words[i]);
+    }
+    else
+    {
+        memcpy(W, digest, 64);
+        for (int i = 0; i < 16; i++)
+            W[i] = crypto_ntohl(W[i]);
+    }
+#else
+    for (int i = 0; i < 16; i++)
+        GET_UINT32(W[i], digest, i * 4);
+#endif
 
 #define  SHR(x,n) ((x & 0xFFFFFFFF) >> n)
 #define ROTR(x,n) (SHR(x,n) | (x << (32 - n)))
@@ -153,10 +212,12 @@ void SHA256::SHA256_Process(const byte digest[64])
 #define F0(x,y,z) ((x & y) | (z & (x | y)))
 #define F1(x,y,z) (z ^ (x & (y ^ z)))
 
+// W[t & 15] still holds W[t - 16] when round t starts
 #define R(t)                                    \
 (                                              \
-    W[t] = S1(W[t -  2]) + W[t -  7] +          \
-           S0(W[t - 15]) + W[t - 16]            \
+    W[(t) & 15] += S1(W[((t) -  2) & 15]) +     \
+                   W[((t) -  7) & 15] +         \
+                   S0(W[((t) - 15) & 15])       \
 )
 
 #define P(a,b,c,d,e,f,g,h,x,K)                  \
@@ -248,9 +309,6 @@ void SHA256::SHA256_Process(const byte digest[64])
     state[5] += F;
     state[6] += G;
     state[7] += H;
-#if defined ESP8266
-    ESP.wdtFeed();
-#endif
 }
 
 /**
@@ -287,6 +345,10 @@ void SHA256::doUpdate(const byte * msg, unsigned int len)
     {
         memcpy((void *) (buffer + left), (void *) msg, len);
     }
+#if defined ESP8266
+    // once per call instead of once per block, one block takes a few microseconds
+    ESP.wdtFeed();
+#endif
 }
 
 /**
@@ -319,11 +381,10 @@ void SHA256::doFinal(byte *digest)
     PUT_UINT32(state[5], digest, 20);
     PUT_UINT32(state[6], digest, 24);
     PUT_UINT32(state[7], digest, 28);
-#if defined ESP8266
-    ESP.wdtFeed();
-#endif
 }
 
+#endif
+
 bool SHA256::matches(const byte *expected)
 {
     byte theDigest[SHA256_SIZE];
@@ -912,9 +973,20 @@ uint32_t RNG::getLong()
  */
 
 SHA256HMAC::SHA256HMAC(const byte *key, unsigned int keyLen)
+{
+    init(key, keyLen);
+}
+
+SHA256HMAC::SHA256HMAC()
+{
+    init(nullptr, 0);
+}
+
+void SHA256HMAC::init(const byte *key, unsigned int keyLen)
 {
     // sort out the key
     byte theKey[SHA256HMAC_BLOCKSIZE];
+    byte padKey[SHA256HMAC_BLOCKSIZE];
     memset(theKey, 0, SHA256HMAC_BLOCKSIZE);
     if (keyLen > SHA256HMAC_BLOCKSIZE)
     {
@@ -923,20 +995,18 @@ SHA256HMAC::SHA256HMAC(const byte *key, unsigned int keyLen)
         keyHahser.doUpdate(key, keyLen);
         keyHahser.doFinal(theKey);
     }
-    else 
+    else if (keyLen)
     {
         // we already set the buffer to 0s, so just copy keyLen
         // bytes from key
         memcpy(theKey, key, keyLen);
     }
-    // explicitly zero pads
-    memset(_innerKey, 0, SHA256HMAC_BLOCKSIZE);
-    memset(_outerKey, 0, SHA256HMAC_BLOCKSIZE);
-    // compute the keys
-    blockXor(theKey, _innerKey, HMAC_IPAD, SHA256HMAC_BLOCKSIZE);
-    blockXor(theKey, _outerKey, HMAC_OPAD, SHA256HMAC_BLOCKSIZE);
     // start the intermediate hash
-    _hash.doUpdate(_innerKey, SHA256HMAC_BLOCKSIZE);
+    blockXor(theKey, padKey, HMAC_IPAD, SHA256HMAC_BLOCKSIZE);
+    _hash.doUpdate(padKey, SHA256HMAC_BLOCKSIZE);
+    // start the final hash, doFinal() only has to add the intermediate hash
+    blockXor(theKey, padKey, HMAC_OPAD, SHA256HMAC_BLOCKSIZE);
+    _outerHash.doUpdate(padKey, SHA256HMAC_BLOCKSIZE);
 }
 
 void SHA256HMAC::doUpdate(const byte *msg, unsigned int len)
@@ -950,8 +1020,7 @@ void SHA256HMAC::doFinal(byte *digest)
     byte interHash[SHA256_SIZE];
     _hash.doFinal(interHash);
     // compute the final hash
-    SHA256 finalHash;
-    finalHash.doUpdate(_outerKey, SHA256HMAC_BLOCKSIZE);
+    SHA256 finalHash(_outerHash);
     finalHash.doUpdate(interHash, SHA256_SIZE);
     finalHash.doFinal(digest);
 }
@@ -18,6 +18,12 @@
 #include <osapi.h>
 #endif
 
+// define SINRICPRO_ESP32_HW_SHA to let SHA256 use mbedtls and with it the ESP32 SHA accelerator
+#if defined ESP32 && defined SINRICPRO_ESP32_HW_SHA
+#include "mbedtls/sha256.h"
+#define CRYPTO_SHA256_MBEDTLS
+#endif
+
 #define SHA256_SIZE             32
 #define SHA256HMAC_SIZE         32
 #define SHA256HMAC_BLOCKSIZE    64
@@ -35,6 +41,11 @@ class SHA256
 {
     public:
         SHA256();
+#if defined CRYPTO_SHA256_MBEDTLS
+        SHA256(const SHA256 &other);
+        SHA256 &operator=(const SHA256 &other);
+        ~SHA256();
+#endif
         /**
          * Update the hash with new data
          */
@@ -51,10 +62,14 @@ class SHA256
          */
         bool matches(const byte *expected);
     private:
+#if defined CRYPTO_SHA256_MBEDTLS
+        mbedtls_sha256_context _context;
+#else
         void SHA256_Process(const byte digest[64]);
         uint32_t total[2];
         uint32_t state[8];
         uint8_t  buffer[64];
+#endif
 };
 
 #define HMAC_OPAD 0x5C
@@ -71,6 +86,13 @@ class SHA256HMAC
          * for authenticity
          */
         SHA256HMAC(const byte *key, unsigned int keyLen);
+        /**
+         * Create a SHA256 HMAC with an empty key, assign a keyed instance later
+         * 
+         * Copying an instance copies the hashed key blocks, so a keyed instance
+         * can be kept and copied for every message instead of hashing the key again
+         */
+        SHA256HMAC();
         /**
          * Update the hash with new data
          */
@@ -87,10 +109,10 @@ class SHA256HMAC
          */
         bool matches(const byte *expected);
     private:
+        void init(const byte *key, unsigned int keyLen);
         void blockXor(const byte *in, byte *out, byte val, byte len);
         SHA256 _hash;
-        byte _innerKey[SHA256HMAC_BLOCKSIZE];
-        byte _outerKey[SHA256HMAC_BLOCKSIZE];
+        SHA256 _outerHash;
 };
 
 /**